@@ -0,0 +1,91 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Monotonic time in seconds, used for throughput reports.
+ */
+double batch_time(void);
+
+/*
+ * Prints throughput report to stderr.
+ */
+void batch_report(const char *what, size_t items, size_t bytes, double secs);
+
+/*
+ * Standard conductor size, awg is set to BATCH_METRIC for metric sizes.
+ */
+#define BATCH_METRIC INT32_MIN
+
+struct batch_size {
+	double area;
+	int awg;
+	double mm2;
+};
+
+/*
+ * Returns an array of standard sizes, which is "metric", "awg" or "all".
+ */
+struct batch_size *batch_sizes(const char *which, size_t *cnt);
+
+/*
+ * Prints size as a two CSV columns i.e. "1.5,mm2" or "4/0,AWG".
+ */
+const char *batch_size_csv(const struct batch_size *size, char *buf, size_t buf_len);
+
+/*
+ * Splits a CSV line in place, double quotes around fields are removed.
+ *
+ * Returns number of fields.
+ */
+unsigned int batch_csv_split(char *line, char **fields, unsigned int max);
+
+/*
+ * Maps a regular file or reads a pipe or stdin (path NULL or "-") into
+ * memory. If text is set the buffer always ends with a newline or a null
+ * byte so that it can be parsed without checking the end.
+ *
+ * Returns NULL with errno set on failure.
+ */
+char *batch_load(const char *path, size_t *len, int *mapped, int text);
+
+void batch_unload(char *buf, size_t len, int mapped);
+
+/*
+ * Returns start of the first line at or after pos.
+ */
+size_t batch_line_start(const char *buf, size_t len, size_t pos);
+
+int batch_table(int argc, char *argv[]);
+int batch_eseries(int argc, char *argv[]);
+int batch_ac(int argc, char *argv[]);
+int batch_fuse(int argc, char *argv[]);
+int batch_selfheat(int argc, char *argv[]);
+int batch_livegen(int argc, char *argv[]);
+int batch_live(int argc, char *argv[]);
+int batch_stats(int argc, char *argv[]);
+int batch_energy(int argc, char *argv[]);
+int batch_colcat(int argc, char *argv[]);
+int batch_wires(int argc, char *argv[]);
+int batch_pareto(int argc, char *argv[]);
+int batch_ident(int argc, char *argv[]);
+int batch_project(int argc, char *argv[]);
+int batch_geometry(int argc, char *argv[]);
+int batch_winding(int argc, char *argv[]);
+int batch_pcb(int argc, char *argv[]);
+int batch_approx(int argc, char *argv[]);
+int batch_heatrun(int argc, char *argv[]);
+int batch_fixed(int argc, char *argv[]);
+int batch_kernels(int argc, char *argv[]);
+
+#endif /* BATCH_H */
@@ -0,0 +1,170 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * AC resistance over a logarithmic frequency sweep.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <math.h>
+
+#include "elec_ac.h"
+#include "batch.h"
+
+static void ac_report(struct elec_material *mat, double d, double prox,
+                      double *freq, size_t cnt)
+{
+	double *fast = malloc(cnt * sizeof(double));
+	double *exact = malloc(cnt * sizeof(double));
+	double start, t_fast, t_exact, max_err = 0, max_f = 0;
+	size_t i;
+
+	if (!fast || !exact) {
+		fprintf(stderr, "Failed to allocate memory\n");
+		goto exit;
+	}
+
+	start = batch_time();
+	elec_ac_factor_batch(mat, d, prox, freq, fast, cnt);
+	t_fast = batch_time() - start;
+
+	start = batch_time();
+	elec_ac_factor_batch_exact(mat, d, prox, freq, exact, cnt);
+	t_exact = batch_time() - start;
+
+	for (i = 0; i < cnt; i++) {
+		double err = fabs(fast[i] - exact[i]) / exact[i];
+
+		if (err > max_err) {
+			max_err = err;
+			max_f = freq[i];
+		}
+	}
+
+	printf("points         %zu\n", cnt);
+	printf("fast           %.3f ns/point\n", 1e9 * t_fast / cnt);
+	printf("exact          %.3f ns/point\n", 1e9 * t_exact / cnt);
+	printf("speedup        %.1fx\n", t_exact / (t_fast > 0 ? t_fast : 1e-9));
+	printf("max rel error  %.3g at %g Hz\n", max_err, max_f);
+exit:
+	free(fast);
+	free(exact);
+}
+
+static void ac_usage(void)
+{
+	printf("usage: acsweep [options]\n\n"
+	       "  -m material  material name (default copper)\n"
+	       "  -d diameter  wire diameter in mm (default 1)\n"
+	       "  -f f:t:n     frequency sweep in Hz from:to:count (default 10:10e6:1000)\n"
+	       "  -p porosity  wire diameter to winding pitch ratio (default 1)\n"
+	       "  -l layers    number of winding layers, 0 for isolated wire (default 0)\n"
+	       "  -e           use exact Kelvin functions instead of the fast approximation\n"
+	       "  -r           print accuracy and speed of fast vs exact computation\n");
+}
+
+int batch_ac(int argc, char *argv[])
+{
+	struct elec_material *mat = elec_material_by_name("copper");
+	double d = 1, f_min = 10, f_max = 10e6, porosity = 1, prox, start;
+	unsigned int layers = 0;
+	int opt, exact = 0, report = 0;
+	size_t cnt = 1000, i;
+	double *freq, *factor;
+	char *end;
+
+	while ((opt = getopt(argc, argv, "d:ef:hl:m:p:r")) != -1) {
+		switch (opt) {
+		case 'd':
+			d = strtod(optarg, &end);
+			if (*end || !(d > 0)) {
+				fprintf(stderr, "Invalid diameter '%s'\n", optarg);
+				return 1;
+			}
+		break;
+		case 'e':
+			exact = 1;
+		break;
+		case 'f':
+			f_min = strtod(optarg, &end);
+			if (*end++ == ':')
+				f_max = strtod(end, &end);
+			if (*end++ == ':')
+				cnt = strtoul(end, &end, 10);
+			if (*end || !(f_min > 0) || !(f_max >= f_min) || !cnt) {
+				fprintf(stderr, "Invalid sweep '%s'\n", optarg);
+				return 1;
+			}
+		break;
+		case 'l':
+			layers = atoi(optarg);
+		break;
+		case 'm':
+			mat = elec_material_by_name(optarg);
+			if (!mat) {
+				fprintf(stderr, "Invalid material '%s'\n", optarg);
+				return 1;
+			}
+		break;
+		case 'p':
+			porosity = atof(optarg);
+		break;
+		case 'r':
+			report = 1;
+		break;
+		case 'h':
+			ac_usage();
+			return 0;
+		default:
+			ac_usage();
+			return 1;
+		}
+	}
+
+	d /= 1000;
+	prox = elec_ac_proximity(porosity, layers);
+
+	freq = malloc(cnt * sizeof(double));
+	factor = malloc(cnt * sizeof(double));
+	if (!freq || !factor) {
+		fprintf(stderr, "Failed to allocate memory\n");
+		free(freq);
+		free(factor);
+		return 1;
+	}
+
+	elec_log_sweep(f_min, f_max, freq, cnt);
+
+	if (report) {
+		ac_report(mat, d, prox, freq, cnt);
+		goto exit;
+	}
+
+	start = batch_time();
+
+	if (exact)
+		elec_ac_factor_batch_exact(mat, d, prox, freq, factor, cnt);
+	else
+		elec_ac_factor_batch(mat, d, prox, freq, factor, cnt);
+
+	batch_report("points", cnt, 0, batch_time() - start);
+
+	printf("freq_hz,skin_depth_m,rac_rdc\n");
+
+	for (i = 0; i < cnt; i++)
+		printf("%g,%g,%.9g\n", freq[i], elec_skin_depth(mat, freq[i]), factor[i]);
+
+exit:
+	free(freq);
+	free(factor);
+
+	return 0;
+}
@@ -0,0 +1,239 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Differential test of the approximate math mode. Each path is evaluated
+ * over a dense input grid with the mode disabled and enabled, the results
+ * are compared for the maximal ULP distance and relative error and both
+ * runs are timed.
+ */
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "libelec.h"
+#include "elec_approx.h"
+#include "batch.h"
+
+struct approx_path {
+	const char *name;
+	/* input grid, logarithmic if set */
+	double min;
+	double max;
+	int log;
+	void (*run)(const double *in, double *out, size_t cnt);
+};
+
+static void run_exp2(const double *in, double *out, size_t cnt)
+{
+	size_t i;
+
+	if (elec_approx()) {
+		for (i = 0; i < cnt; i++)
+			out[i] = elec_approx_exp2(in[i]);
+	} else {
+		for (i = 0; i < cnt; i++)
+			out[i] = exp2(in[i]);
+	}
+}
+
+static void run_log2(const double *in, double *out, size_t cnt)
+{
+	size_t i;
+
+	if (elec_approx()) {
+		for (i = 0; i < cnt; i++)
+			out[i] = elec_approx_log2(in[i]);
+	} else {
+		for (i = 0; i < cnt; i++)
+			out[i] = log2(in[i]);
+	}
+}
+
+static void run_awg_to_area(const double *in, double *out, size_t cnt)
+{
+	size_t i;
+
+	for (i = 0; i < cnt; i++) {
+		struct elec_val v = {
+			.type = ELEC_UNIT_AREA,
+			.val = in[i],
+			.unit = ELEC_UNIT_AWG,
+		};
+
+		elec_unit_convert(&v, ELEC_UNIT_M2);
+		out[i] = v.val;
+	}
+}
+
+static void run_area_to_awg(const double *in, double *out, size_t cnt)
+{
+	size_t i;
+
+	for (i = 0; i < cnt; i++) {
+		struct elec_val v = {
+			.type = ELEC_UNIT_AREA,
+			.val = in[i],
+			.unit = ELEC_UNIT_M2,
+		};
+
+		elec_unit_convert(&v, ELEC_UNIT_AWG);
+		out[i] = v.val;
+	}
+}
+
+static const struct approx_path paths[] = {
+	{"exp2", -1000, 1000, 0, run_exp2},
+	{"log2", 1e-300, 1e300, 1, run_log2},
+	{"awg_to_area", ELEC_AWG_MIN, ELEC_AWG_MAX, 0, run_awg_to_area},
+	{"area_to_awg", 1e-9, 1e-3, 1, run_area_to_awg},
+};
+
+/* Maps doubles to integers so that the difference counts ULPs */
+static int64_t ulp_order(double val)
+{
+	int64_t bits;
+
+	memcpy(&bits, &val, sizeof(bits));
+
+	return bits < 0 ? INT64_MIN - bits : bits;
+}
+
+static uint64_t ulp_dist(double a, double b)
+{
+	int64_t ia = ulp_order(a), ib = ulp_order(b);
+
+	return ia > ib ? (uint64_t)ia - (uint64_t)ib : (uint64_t)ib - (uint64_t)ia;
+}
+
+static double time_path(const struct approx_path *p, const double *in,
+                        double *out, size_t cnt, unsigned int rounds)
+{
+	double start = batch_time();
+	unsigned int r;
+
+	for (r = 0; r < rounds; r++)
+		p->run(in, out, cnt);
+
+	return (batch_time() - start) / ((double)cnt * rounds) * 1e9;
+}
+
+static void approx_usage(void)
+{
+	printf("usage: approx [options]\n\n"
+	       "Compares the approximate math mode against the exact one over\n"
+	       "dense input grids and prints the speedup and the errors.\n\n"
+	       "  -n points    grid points per path (default 1000000)\n"
+	       "  -r rounds    timing rounds (default 5)\n"
+	       "  -e error     fail if the relative error exceeds error\n");
+}
+
+int batch_approx(int argc, char *argv[])
+{
+	size_t cnt = 1000000, i, j;
+	unsigned int rounds = 5;
+	double max_err = 0, *in, *ref, *out;
+	int approx = elec_approx();
+	int opt, ret = 0;
+
+	while ((opt = getopt(argc, argv, "e:hn:r:")) != -1) {
+		switch (opt) {
+		case 'e':
+			max_err = atof(optarg);
+		break;
+		case 'n':
+			cnt = strtoul(optarg, NULL, 0);
+		break;
+		case 'r':
+			rounds = atoi(optarg);
+		break;
+		case 'h':
+			approx_usage();
+			return 0;
+		default:
+			approx_usage();
+			return 1;
+		}
+	}
+
+	if (cnt < 2 || !rounds) {
+		fprintf(stderr, "Points must be at least 2 and rounds positive\n");
+		return 1;
+	}
+
+	in = malloc(cnt * sizeof(double));
+	ref = malloc(cnt * sizeof(double));
+	out = malloc(cnt * sizeof(double));
+
+	if (!in || !ref || !out) {
+		fprintf(stderr, "Failed to allocate memory\n");
+		ret = 1;
+		goto exit;
+	}
+
+	printf("path,points,ref_ns,approx_ns,speedup,max_ulp,max_rel_err\n");
+
+	for (i = 0; i < sizeof(paths)/sizeof(*paths); i++) {
+		const struct approx_path *p = &paths[i];
+		double ref_ns, approx_ns, rel = 0;
+		uint64_t ulp = 0;
+
+		for (j = 0; j < cnt; j++) {
+			double f = (double)j / (cnt - 1);
+
+			if (p->log)
+				in[j] = exp(log(p->min) + f * (log(p->max) - log(p->min)));
+			else
+				in[j] = p->min + f * (p->max - p->min);
+		}
+
+		elec_approx_set(0);
+		p->run(in, ref, cnt);
+		ref_ns = time_path(p, in, ref, cnt, rounds);
+
+		elec_approx_set(1);
+		p->run(in, out, cnt);
+		approx_ns = time_path(p, in, out, cnt, rounds);
+
+		for (j = 0; j < cnt; j++) {
+			uint64_t dist = ulp_dist(ref[j], out[j]);
+			double d;
+
+			if (dist > ulp)
+				ulp = dist;
+
+			if (ref[j] != out[j]) {
+				d = fabs(out[j] - ref[j]) / fabs(ref[j]);
+				if (!(d <= rel))
+					rel = d;
+			}
+		}
+
+		printf("%s,%zu,%.2f,%.2f,%.2f,%" PRIu64 ",%.3g\n", p->name, cnt,
+		       ref_ns, approx_ns, ref_ns / approx_ns, ulp, rel);
+
+		if (max_err > 0 && !(rel <= max_err)) {
+			fprintf(stderr, "%s: relative error %g over %g\n",
+			        p->name, rel, max_err);
+			ret = 1;
+		}
+	}
+
+exit:
+	elec_approx_set(approx);
+
+	free(in);
+	free(ref);
+	free(out);
+
+	return ret;
+}
@@ -0,0 +1,190 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Prints elec_col columnar files as CSV.
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "elec_col.h"
+#include "elec_fmt.h"
+#include "batch.h"
+
+static const char *storage_names[] = {
+	[ELEC_COL_F64] = "f64",
+	[ELEC_COL_F32] = "f32",
+	[ELEC_COL_U16] = "label",
+};
+
+static const char *col_unit(const struct elec_col_info *col)
+{
+	struct elec_val val = {.type = col->type, .unit = col->unit};
+
+	if (col->storage == ELEC_COL_U16)
+		return NULL;
+
+	return elec_unit_name(&val);
+}
+
+/*
+ * Unit suffix for the csv header, spelled in ASCII as the table csv header
+ * does, e.g. resistance_ohm.
+ */
+static const char *csv_unit(const char *unit, char *buf, size_t buf_len)
+{
+	static const struct {
+		const char *utf8;
+		const char *ascii;
+	} subst[] = {
+		{"\u03a9", "ohm"},
+		{"\u00b2", "2"},
+		{"\u00b5", "u"},
+	};
+	size_t len = 0, i;
+
+	while (*unit && len + 4 < buf_len) {
+		for (i = 0; i < sizeof(subst)/sizeof(*subst); i++) {
+			size_t sub_len = strlen(subst[i].utf8);
+
+			if (!strncmp(unit, subst[i].utf8, sub_len)) {
+				len += sprintf(buf + len, "%s", subst[i].ascii);
+				unit += sub_len;
+				break;
+			}
+		}
+
+		if (i == sizeof(subst)/sizeof(*subst))
+			buf[len++] = *unit++;
+	}
+
+	buf[len] = 0;
+
+	return buf;
+}
+
+static void print_info(const struct elec_col_file *f)
+{
+	size_t i;
+
+	printf("rows     %zu\n", f->rows);
+	printf("groups   %zu%s\n", f->groups_cnt, f->complete ? "" : " (truncated)");
+	printf("bytes    %zu\n", f->map_len);
+
+	for (i = 0; i < f->cols_cnt; i++) {
+		const struct elec_col_info *col = &f->cols[i];
+
+		printf("column   %-12s %-6s", col->name, storage_names[col->storage]);
+
+		if (col->storage == ELEC_COL_U16)
+			printf("%zu labels\n", col->labels_cnt);
+		else
+			printf("%s\n", col_unit(col));
+	}
+}
+
+static void print_csv(const struct elec_col_file *f, int digits)
+{
+	char buf[ELEC_FMT_MAX];
+	size_t g, r, c;
+
+	for (c = 0; c < f->cols_cnt; c++) {
+		const char *unit = col_unit(&f->cols[c]);
+
+		printf("%s%s%s%s", c ? "," : "", f->cols[c].name, unit ? "_" : "",
+		       unit ? csv_unit(unit, buf, sizeof(buf)) : "");
+	}
+
+	printf("\n");
+
+	for (g = 0; g < f->groups_cnt; g++) {
+		for (r = 0; r < f->groups[g].rows; r++) {
+			for (c = 0; c < f->cols_cnt; c++) {
+				const char *label = elec_col_label(f, g, c, r);
+
+				if (c)
+					putchar(',');
+
+				if (label) {
+					printf("\"%s\"", label);
+				} else {
+					elec_fmt_digits(elec_col_get(f, g, c, r), digits, buf);
+					fputs(buf, stdout);
+				}
+			}
+
+			putchar('\n');
+		}
+	}
+}
+
+static void colcat_usage(void)
+{
+	printf("usage: colcat [options] file\n\n"
+	       "  -i         print columns and row counts only\n"
+	       "  -d digits  significant digits (default 6)\n");
+}
+
+int batch_colcat(int argc, char *argv[])
+{
+	struct elec_col_file *f;
+	int opt, info = 0, digits = 6;
+	double start;
+
+	while ((opt = getopt(argc, argv, "d:hi")) != -1) {
+		switch (opt) {
+		case 'd':
+			digits = atoi(optarg);
+			if (digits < 1 || digits > 17) {
+				fprintf(stderr, "Digits must be in 1-17\n");
+				return 1;
+			}
+		break;
+		case 'i':
+			info = 1;
+		break;
+		case 'h':
+			colcat_usage();
+			return 0;
+		default:
+			colcat_usage();
+			return 1;
+		}
+	}
+
+	if (optind >= argc) {
+		colcat_usage();
+		return 1;
+	}
+
+	start = batch_time();
+
+	f = elec_col_open(argv[optind]);
+	if (!f) {
+		fprintf(stderr, "Failed to open '%s': %s\n", argv[optind], strerror(errno));
+		return 1;
+	}
+
+	if (info)
+		print_info(f);
+	else
+		print_csv(f, digits);
+
+	batch_report("rows", f->rows, f->map_len, batch_time() - start);
+
+	if (!f->complete)
+		fprintf(stderr, "File '%s' is truncated\n", argv[optind]);
+
+	elec_col_close(f);
+
+	return 0;
+}
@@ -0,0 +1,323 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * I²R energy losses of a cable over a load profile.
+ *
+ * The profile is either CSV with rows time_s,current_a[,temp_c] or raw
+ * native endian doubles with two or three values per record in the same
+ * order. The input is mapped, split into per thread chunks that are
+ * integrated independently and the results are merged in time order.
+ */
+
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "libelec.h"
+#include "elec_energy.h"
+#include "elec_par.h"
+#include "batch.h"
+
+#define BLOCK 1024
+
+#define YEAR_S (365.25 * 24 * 3600)
+
+struct energy_job {
+	const char *buf;
+	size_t len;
+	int binary;
+	/* values per binary record */
+	unsigned int fields;
+	/* use per sample temperatures */
+	int temp;
+	struct elec_energy_params params;
+	size_t chunks_cnt;
+	struct elec_energy *chunks;
+	size_t *errors;
+};
+
+/* Longest CSV row accepted */
+#define ROW_MAX 256
+
+static int parse_field(char **str, double *val)
+{
+	char *p;
+
+	*val = strtod(*str, &p);
+	if (p == *str)
+		return 1;
+
+	while (*p == ' ' || *p == '\t' || *p == '\r')
+		p++;
+
+	*str = p;
+
+	return 0;
+}
+
+/*
+ * Parses a time_s,current_a[,temp_c] row, the temperature column is ignored
+ * unless per sample temperatures are used.
+ *
+ * Returns zero on success, 1 for blank lines and -1 for invalid rows.
+ */
+static int csv_row(const char *line, size_t len, double *time, double *current,
+                   double *temp)
+{
+	char buf[ROW_MAX + 1], *p = buf;
+	double ignored;
+
+	if (len > ROW_MAX)
+		return -1;
+
+	/* strtod() skips newlines, parse a terminated copy of the line */
+	memcpy(buf, line, len);
+	buf[len] = 0;
+
+	if (!buf[strspn(buf, " \t\r")])
+		return 1;
+
+	if (parse_field(&p, time) || *p++ != ',')
+		return -1;
+
+	if (parse_field(&p, current))
+		return -1;
+
+	if (temp && *p++ != ',')
+		return -1;
+
+	if (!temp && *p == ',') {
+		p++;
+		temp = &ignored;
+	}
+
+	if (temp && parse_field(&p, temp))
+		return -1;
+
+	return *p ? -1 : 0;
+}
+
+static void csv_chunk(struct energy_job *job, size_t idx)
+{
+	struct elec_energy *e = &job->chunks[idx];
+	size_t pos = batch_line_start(job->buf, job->len, idx * job->len / job->chunks_cnt);
+	size_t end = batch_line_start(job->buf, job->len, (idx + 1) * job->len / job->chunks_cnt);
+	double time[BLOCK], current[BLOCK], temp[BLOCK];
+	size_t cnt = 0;
+
+	while (pos < end) {
+		const char *line = job->buf + pos;
+		const char *nl = memchr(line, '\n', end - pos);
+		size_t len = nl ? (size_t)(nl - line) : end - pos;
+
+		pos = nl ? (size_t)(nl - job->buf) + 1 : end;
+
+		switch (csv_row(line, len, &time[cnt], &current[cnt],
+		                job->temp ? &temp[cnt] : NULL)) {
+		case 0:
+		break;
+		case 1:
+			continue;
+		default:
+			/* Header */
+			if (line != job->buf)
+				job->errors[idx]++;
+			continue;
+		}
+
+		if (++cnt == BLOCK) {
+			elec_energy_batch(e, &job->params, time, current,
+			                  job->temp ? temp : NULL, cnt);
+			cnt = 0;
+		}
+	}
+
+	elec_energy_batch(e, &job->params, time, current, job->temp ? temp : NULL, cnt);
+}
+
+static void bin_chunk(struct energy_job *job, size_t idx)
+{
+	struct elec_energy *e = &job->chunks[idx];
+	const double *rec = (const double *)job->buf;
+	size_t recs = job->len / (job->fields * sizeof(double));
+	size_t from = idx * recs / job->chunks_cnt;
+	size_t to = (idx + 1) * recs / job->chunks_cnt;
+	double time[BLOCK], current[BLOCK], temp[BLOCK];
+	size_t i, n;
+
+	/* Records are interleaved, split them into arrays for the kernel */
+	for (; from < to; from += n) {
+		n = to - from < BLOCK ? to - from : BLOCK;
+
+		for (i = 0; i < n; i++) {
+			const double *r = rec + (from + i) * job->fields;
+
+			time[i] = r[0];
+			current[i] = r[1];
+			temp[i] = job->temp ? r[2] : 0;
+		}
+
+		elec_energy_batch(e, &job->params, time, current, job->temp ? temp : NULL, n);
+	}
+}
+
+static void energy_range(void *priv, size_t from, size_t to)
+{
+	struct energy_job *job = priv;
+	size_t i;
+
+	for (i = from; i < to; i++) {
+		elec_energy_init(&job->chunks[i]);
+		job->errors[i] = 0;
+
+		if (job->binary)
+			bin_chunk(job, i);
+		else
+			csv_chunk(job, i);
+	}
+}
+
+static void energy_usage(void)
+{
+	printf("usage: energy [options] [profile]\n\n"
+	       "Integrates I\u00b2R losses over a load profile of time_s,current_a[,temp_c]\n"
+	       "rows, reads stdin if profile is not set.\n\n"
+	       "  -m material  conductor material (default copper)\n"
+	       "  -a area      cross section in mm\u00b2 (default 1.5)\n"
+	       "  -l length    cable length in m (default 1)\n"
+	       "  -k count     number of loaded conductors (default 1)\n"
+	       "  -T temp      conductor temperature in \u00b0C, ignored with -c (default 20)\n"
+	       "  -c           profile has per sample conductor temperature column\n"
+	       "  -b           profile is raw native endian doubles\n"
+	       "  -t threads   number of threads (default all CPUs)\n");
+}
+
+int batch_energy(int argc, char *argv[])
+{
+	struct elec_material *mat = elec_material_by_name("copper");
+	struct elec_val length = {.type = ELEC_UNIT_LENGTH, .val = 1, .unit = ELEC_UNIT_M};
+	struct elec_val area = {.type = ELEC_UNIT_AREA, .val = 1.5, .unit = ELEC_UNIT_MM2};
+	struct energy_job job = {.fields = 2, .params.temp = ELEC_TEMP_REF};
+	struct elec_energy total;
+	unsigned int threads = 0, conductors = 1;
+	double start, duration;
+	size_t c, errors = 0;
+	int opt, mapped, ret = 1;
+	char *buf;
+
+	while ((opt = getopt(argc, argv, "a:bchk:l:m:t:T:")) != -1) {
+		switch (opt) {
+		case 'a':
+			area.val = atof(optarg);
+		break;
+		case 'b':
+			job.binary = 1;
+		break;
+		case 'c':
+			job.temp = 1;
+			job.fields = 3;
+		break;
+		case 'k':
+			conductors = atoi(optarg);
+		break;
+		case 'l':
+			length.val = atof(optarg);
+		break;
+		case 'm':
+			mat = elec_material_by_name(optarg);
+			if (!mat) {
+				fprintf(stderr, "Invalid material '%s'\n", optarg);
+				return 1;
+			}
+		break;
+		case 't':
+			threads = atoi(optarg);
+		break;
+		case 'T':
+			job.params.temp = atof(optarg);
+		break;
+		case 'h':
+			energy_usage();
+			return 0;
+		default:
+			energy_usage();
+			return 1;
+		}
+	}
+
+	if (!threads)
+		threads = elec_par_threads();
+
+	job.params.r_ref = conductors * elec_resistance_block(mat, length, area).val;
+	job.params.tc = mat->tc;
+
+	buf = batch_load(optind < argc ? argv[optind] : NULL, &job.len, &mapped, !job.binary);
+	if (!buf) {
+		fprintf(stderr, "Failed to read profile: %s\n", strerror(errno));
+		return 1;
+	}
+
+	if (job.binary && job.len % (job.fields * sizeof(double))) {
+		fprintf(stderr, "Truncated profile, %zu bytes after the last record\n",
+		        job.len % (job.fields * sizeof(double)));
+		goto exit;
+	}
+
+	job.buf = buf;
+	job.chunks_cnt = threads;
+	job.chunks = malloc(threads * sizeof(*job.chunks));
+	job.errors = malloc(threads * sizeof(*job.errors));
+	if (!job.chunks || !job.errors) {
+		fprintf(stderr, "Failed to allocate memory\n");
+		goto exit;
+	}
+
+	start = batch_time();
+
+	elec_par_for(job.chunks_cnt, threads, energy_range, &job);
+
+	elec_energy_init(&total);
+
+	for (c = 0; c < job.chunks_cnt; c++) {
+		elec_energy_merge(&total, &job.chunks[c]);
+		errors += job.errors[c];
+	}
+
+	batch_report("samples", total.cnt, job.len, batch_time() - start);
+
+	if (errors)
+		fprintf(stderr, "%zu invalid rows\n", errors);
+
+	if (!total.cnt) {
+		fprintf(stderr, "No samples\n");
+		goto exit;
+	}
+
+	duration = total.last_time - total.first_time;
+
+	printf("samples         %zu\n", total.cnt);
+	printf("resistance      %g \u03a9 at %i \u00b0C\n", job.params.r_ref, ELEC_TEMP_REF);
+	printf("duration        %g h\n", duration / 3600);
+	printf("energy          %g kWh\n", total.energy / 3.6e6);
+	printf("mean loss       %g W\n", duration > 0 ? total.energy / duration : NAN);
+	printf("peak loss       %g W at %g s\n", total.peak, total.peak_time);
+	printf("annualized      %g kWh/year\n",
+	       duration > 0 ? total.energy / duration * YEAR_S / 3.6e6 : NAN);
+
+	ret = 0;
+exit:
+	free(job.chunks);
+	free(job.errors);
+	batch_unload(buf, job.len, mapped);
+
+	return ret;
+}
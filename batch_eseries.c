@@ -0,0 +1,237 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Snaps a list of resistances e.g. from a BOM to an E-series and finds best
+ * two resistor combinations for each of them.
+ *
+ * The input has one value per line, the values can be written with SI
+ * prefixes either as 4.7k or as 4k7, R can be used as a decimal point
+ * including a leading one as in R47.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <math.h>
+
+#include "elec_eseries.h"
+#include "batch.h"
+
+static double prefix_mul(char c)
+{
+	switch (c) {
+	case 'm':
+		return 1e-3;
+	case 'R':
+	case 'r':
+		return 1;
+	case 'k':
+	case 'K':
+		return 1e3;
+	case 'M':
+		return 1e6;
+	case 'G':
+		return 1e9;
+	default:
+		return 0;
+	}
+}
+
+static int parse_resistance(const char *str, double *val)
+{
+	const size_t ohm_len = strlen("\u03a9");
+	char buf[64], *end, *p;
+	double mul;
+
+	while (*str == ' ' || *str == '\t')
+		str++;
+
+	snprintf(buf, sizeof(buf), "%s", str);
+
+	/* Strip trailing whitespace and ohm sign */
+	end = buf + strlen(buf);
+	while (end > buf && strchr(" \t\r\n", end[-1]))
+		*--end = 0;
+
+	if ((size_t)(end - buf) >= ohm_len && !strcmp(end - ohm_len, "\u03a9"))
+		end[-ohm_len] = 0;
+
+	if (!*buf)
+		return 1;
+
+	/* 4k7 and R47 notation, replace the prefix with a decimal point */
+	for (p = buf; *p; p++) {
+		if ((*p >= '0' && *p <= '9') || *p == '.')
+			continue;
+
+		mul = prefix_mul(*p);
+		if (!mul || !p[1] || strchr(buf, '.'))
+			break;
+
+		*p = '.';
+		*val = strtod(buf, &end) * mul;
+
+		return !!*end;
+	}
+
+	*val = strtod(buf, &end);
+
+	if (end == buf)
+		return 1;
+
+	if (!*end)
+		return 0;
+
+	mul = prefix_mul(*end);
+	if (!mul || end[1])
+		return 1;
+
+	*val *= mul;
+
+	return 0;
+}
+
+static const char *comb_name(enum elec_eseries_comb comb)
+{
+	switch (comb) {
+	case ELEC_ESERIES_SINGLE:
+		return "single";
+	case ELEC_ESERIES_SERIES:
+		return "series";
+	case ELEC_ESERIES_PARALLEL:
+		return "parallel";
+	}
+
+	return "invalid";
+}
+
+static void eseries_usage(void)
+{
+	printf("usage: eseries [options] [file]\n\n"
+	       "  -e series    E6, E12, E24, E48, E96 or E192 (default E24)\n"
+	       "  -r min:max   range of resistors in Ohms (default 1:10M)\n");
+}
+
+int batch_eseries(int argc, char *argv[])
+{
+	enum elec_eseries series = ELEC_E24;
+	double min = 1, max = 10e6, start;
+	struct elec_eseries_list list;
+	struct elec_eseries_pair *res;
+	double *targets = NULL;
+	size_t cnt = 0, size = 0, i, line_no = 0;
+	char *line = NULL, *sep;
+	size_t line_size = 0;
+	FILE *in = stdin;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "e:hr:")) != -1) {
+		switch (opt) {
+		case 'e':
+			series = elec_eseries_by_name(optarg);
+			if (series == ELEC_ESERIES_CNT) {
+				fprintf(stderr, "Invalid series '%s'\n", optarg);
+				return 1;
+			}
+		break;
+		case 'r':
+			sep = strchr(optarg, ':');
+			if (!sep) {
+				fprintf(stderr, "Invalid range '%s'\n", optarg);
+				return 1;
+			}
+			*sep = 0;
+			if (parse_resistance(optarg, &min) || parse_resistance(sep + 1, &max)) {
+				fprintf(stderr, "Invalid range\n");
+				return 1;
+			}
+		break;
+		case 'h':
+			eseries_usage();
+			return 0;
+		default:
+			eseries_usage();
+			return 1;
+		}
+	}
+
+	if (optind < argc) {
+		in = fopen(argv[optind], "r");
+		if (!in) {
+			fprintf(stderr, "Failed to open '%s'\n", argv[optind]);
+			return 1;
+		}
+	}
+
+	while (getline(&line, &line_size, in) > 0) {
+		line_no++;
+
+		if (line[0] == '#' || line[strspn(line, " \t\r\n")] == 0)
+			continue;
+
+		if (cnt >= size) {
+			size = size ? 2 * size : 1024;
+			double *tmp = realloc(targets, size * sizeof(double));
+			if (!tmp) {
+				fprintf(stderr, "Failed to allocate memory\n");
+				goto err;
+			}
+			targets = tmp;
+		}
+
+		if (parse_resistance(line, &targets[cnt])) {
+			fprintf(stderr, "%zu: Invalid value '%s'\n", line_no, line);
+			goto err;
+		}
+
+		cnt++;
+	}
+
+	if (elec_eseries_list_init(&list, series, min, max)) {
+		fprintf(stderr, "Invalid range %g:%g\n", min, max);
+		goto err;
+	}
+
+	res = malloc(cnt * sizeof(*res));
+	if (cnt && !res) {
+		fprintf(stderr, "Failed to allocate memory\n");
+		elec_eseries_list_exit(&list);
+		goto err;
+	}
+
+	start = batch_time();
+	elec_eseries_pair_batch(&list, targets, res, cnt);
+	batch_report("values", cnt, 0, batch_time() - start);
+
+	printf("target,%s,comb,r1,r2,value,err_percent\n", elec_eseries_name(series));
+
+	for (i = 0; i < cnt; i++) {
+		printf("%g,%g,%s,%g,%g,%g,%.3f\n",
+		       targets[i], elec_eseries_nearest(series, targets[i]),
+		       comb_name(res[i].comb), res[i].r1, res[i].r2,
+		       res[i].val, 100 * res[i].err);
+	}
+
+	free(res);
+	free(targets);
+	free(line);
+	elec_eseries_list_exit(&list);
+
+	if (in != stdin)
+		fclose(in);
+
+	return 0;
+err:
+	free(targets);
+	free(line);
+	if (in != stdin)
+		fclose(in);
+	return 1;
+}
@@ -0,0 +1,378 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Benchmark of the fixed point calculations against the floating point
+ * ones, on targets without FPU the latter are the soft-float emulation.
+ *
+ * The inputs are random fixed point values so that both variants compute
+ * with exactly the same numbers. The error is reported as the largest
+ * difference in the last (sixth) decimal place of the result and as the
+ * largest relative error for results of at least one unit.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "libelec.h"
+#include "elec_fixed.h"
+#include "batch.h"
+
+struct bench_in {
+	struct elec_val a;
+	struct elec_val b;
+	struct elec_fixed_val fa;
+	struct elec_fixed_val fb;
+};
+
+struct bench_out {
+	double val;
+	struct elec_fixed_val fval;
+	int err;
+};
+
+struct bench {
+	const char *name;
+	void (*gen)(struct bench_in *in);
+	void (*run)(const struct elec_material *mat, const struct bench_in *in,
+	            struct bench_out *out);
+	void (*run_fixed)(const struct elec_fixed_material *mat, const struct bench_in *in,
+	                  struct bench_out *out);
+};
+
+static uint64_t rnd_state = 88172645463325252ull;
+
+static uint64_t rnd(void)
+{
+	rnd_state ^= rnd_state << 13;
+	rnd_state ^= rnd_state >> 7;
+	rnd_state ^= rnd_state << 17;
+
+	return rnd_state;
+}
+
+/* Log uniform random value in [min, max] rounded to six decimal places */
+static elec_fixed rnd_log(double min, double max)
+{
+	double r = (rnd() >> 11) * 0x1p-53;
+
+	return llround(min * pow(max / min, r) * ELEC_FIXED_ONE);
+}
+
+static void set_val(struct bench_in *in, int second, enum elec_unit type,
+                    elec_unit unit, elec_fixed val)
+{
+	struct elec_val *v = second ? &in->b : &in->a;
+	struct elec_fixed_val *fv = second ? &in->fb : &in->fa;
+
+	*v = (struct elec_val) {.type = type, .unit = unit, .val = (double)val / ELEC_FIXED_ONE};
+	*fv = (struct elec_fixed_val) {.type = type, .unit = unit, .val = val};
+}
+
+static void gen_length(struct bench_in *in)
+{
+	set_val(in, 0, ELEC_UNIT_LENGTH, ELEC_UNIT_M, rnd_log(0.001, 10000));
+}
+
+static void gen_awg(struct bench_in *in)
+{
+	set_val(in, 0, ELEC_UNIT_AREA, ELEC_UNIT_MM2, rnd_log(0.006, 100));
+}
+
+static void gen_diameter(struct bench_in *in)
+{
+	set_val(in, 0, ELEC_UNIT_LENGTH, ELEC_UNIT_MM, rnd_log(0.05, 50));
+}
+
+static void gen_block(struct bench_in *in)
+{
+	set_val(in, 0, ELEC_UNIT_LENGTH, ELEC_UNIT_M, rnd_log(0.001, 10000));
+	set_val(in, 1, ELEC_UNIT_AREA, ELEC_UNIT_MM2,
+	        elec_std_area_mm2[rnd() % ELEC_STD_AREA_CNT] * ELEC_FIXED_ONE);
+}
+
+static void gen_length_block(struct bench_in *in)
+{
+	set_val(in, 0, ELEC_UNIT_RESISTANCE, ELEC_UNIT_OHM, rnd_log(0.001, 1000));
+	set_val(in, 1, ELEC_UNIT_AREA, ELEC_UNIT_MM2,
+	        elec_std_area_mm2[rnd() % ELEC_STD_AREA_CNT] * ELEC_FIXED_ONE);
+}
+
+static void gen_ohm(struct bench_in *in)
+{
+	set_val(in, 0, ELEC_UNIT_VOLTAGE, ELEC_UNIT_V, rnd_log(0.001, 1000));
+	set_val(in, 1, ELEC_UNIT_CURRENT, ELEC_UNIT_A, rnd_log(0.001, 1000));
+}
+
+static void run_convert(const struct elec_material *mat, const struct bench_in *in,
+                        struct bench_out *out)
+{
+	struct elec_val v = in->a;
+
+	(void) mat;
+
+	elec_unit_convert(&v, ELEC_UNIT_INCH);
+	out->val = v.val;
+}
+
+static void run_convert_fixed(const struct elec_fixed_material *mat, const struct bench_in *in,
+                              struct bench_out *out)
+{
+	(void) mat;
+
+	out->fval = in->fa;
+	out->err = elec_fixed_unit_convert(&out->fval, ELEC_UNIT_INCH);
+}
+
+static void run_awg(const struct elec_material *mat, const struct bench_in *in,
+                    struct bench_out *out)
+{
+	struct elec_val v = in->a;
+
+	(void) mat;
+
+	elec_unit_convert(&v, ELEC_UNIT_AWG);
+	out->val = v.val;
+}
+
+static void run_awg_fixed(const struct elec_fixed_material *mat, const struct bench_in *in,
+                          struct bench_out *out)
+{
+	(void) mat;
+
+	out->fval = in->fa;
+	out->err = elec_fixed_unit_convert(&out->fval, ELEC_UNIT_AWG);
+}
+
+static void run_circle(const struct elec_material *mat, const struct bench_in *in,
+                       struct bench_out *out)
+{
+	struct elec_val v = in->a;
+
+	(void) mat;
+
+	elec_circle_area(&v, ELEC_UNIT_MM2);
+	out->val = v.val;
+}
+
+static void run_circle_fixed(const struct elec_fixed_material *mat, const struct bench_in *in,
+                             struct bench_out *out)
+{
+	(void) mat;
+
+	out->fval = in->fa;
+	out->err = elec_fixed_circle_area(&out->fval, ELEC_UNIT_MM2);
+}
+
+static void run_diameter(const struct elec_material *mat, const struct bench_in *in,
+                         struct bench_out *out)
+{
+	struct elec_val v = in->a;
+
+	(void) mat;
+
+	elec_circle_diameter(&v, ELEC_UNIT_MM);
+	out->val = v.val;
+}
+
+static void run_diameter_fixed(const struct elec_fixed_material *mat, const struct bench_in *in,
+                               struct bench_out *out)
+{
+	(void) mat;
+
+	out->fval = in->fa;
+	out->err = elec_fixed_circle_diameter(&out->fval, ELEC_UNIT_MM);
+}
+
+static void run_resistance(const struct elec_material *mat, const struct bench_in *in,
+                           struct bench_out *out)
+{
+	struct elec_val r = elec_resistance_block((struct elec_material *)mat, in->a, in->b);
+
+	elec_unit_convert(&r, ELEC_UNIT_OHM);
+	out->val = r.val;
+}
+
+static void run_resistance_fixed(const struct elec_fixed_material *mat, const struct bench_in *in,
+                                 struct bench_out *out)
+{
+	out->err = elec_fixed_resistance_block(mat, in->fa, in->fb, ELEC_UNIT_OHM, &out->fval);
+}
+
+static void run_mass(const struct elec_material *mat, const struct bench_in *in,
+                     struct bench_out *out)
+{
+	struct elec_val m = elec_mass_block((struct elec_material *)mat, in->a, in->b);
+
+	elec_unit_convert(&m, ELEC_UNIT_G);
+	out->val = m.val;
+}
+
+static void run_mass_fixed(const struct elec_fixed_material *mat, const struct bench_in *in,
+                           struct bench_out *out)
+{
+	out->err = elec_fixed_mass_block(mat, in->fa, in->fb, ELEC_UNIT_G, &out->fval);
+}
+
+static void run_length(const struct elec_material *mat, const struct bench_in *in,
+                       struct bench_out *out)
+{
+	struct elec_val l = elec_length_block((struct elec_material *)mat, in->a, in->b);
+
+	out->val = l.val;
+}
+
+static void run_length_fixed(const struct elec_fixed_material *mat, const struct bench_in *in,
+                             struct bench_out *out)
+{
+	out->err = elec_fixed_length_block(mat, in->fa, in->fb, ELEC_UNIT_M, &out->fval);
+}
+
+static void run_ohm(const struct elec_material *mat, const struct bench_in *in,
+                    struct bench_out *out)
+{
+	struct elec_ohm_law law = {.u = in->a, .i = in->b};
+
+	(void) mat;
+
+	elec_ohm_law(&law);
+	out->val = law.r.val;
+}
+
+static void run_ohm_fixed(const struct elec_fixed_material *mat, const struct bench_in *in,
+                          struct bench_out *out)
+{
+	struct elec_fixed_ohm_law law = {.u = in->fa, .i = in->fb};
+
+	(void) mat;
+
+	out->err = elec_fixed_ohm_law(&law);
+	out->fval = law.r;
+}
+
+static const struct bench benches[] = {
+	{"convert", gen_length, run_convert, run_convert_fixed},
+	{"awg", gen_awg, run_awg, run_awg_fixed},
+	{"circle_area", gen_diameter, run_circle, run_circle_fixed},
+	{"circle_diameter", gen_awg, run_diameter, run_diameter_fixed},
+	{"resistance", gen_block, run_resistance, run_resistance_fixed},
+	{"mass", gen_block, run_mass, run_mass_fixed},
+	{"length", gen_length_block, run_length, run_length_fixed},
+	{"ohm_law", gen_ohm, run_ohm, run_ohm_fixed},
+	{}
+};
+
+static int run_bench(const struct bench *b, const struct elec_material *mat,
+                     const struct elec_fixed_material *fmat, size_t cnt)
+{
+	struct bench_in *in = malloc(cnt * sizeof(*in));
+	struct bench_out *out = calloc(cnt, sizeof(*out));
+	double start, t_float, t_fixed, max_err = 0, max_rel = 0;
+	size_t i, errors = 0;
+
+	if (!in || !out) {
+		free(in);
+		free(out);
+		fprintf(stderr, "Failed to allocate memory\n");
+		return 1;
+	}
+
+	for (i = 0; i < cnt; i++)
+		b->gen(&in[i]);
+
+	start = batch_time();
+	for (i = 0; i < cnt; i++)
+		b->run(mat, &in[i], &out[i]);
+	t_float = batch_time() - start;
+
+	start = batch_time();
+	for (i = 0; i < cnt; i++)
+		b->run_fixed(fmat, &in[i], &out[i]);
+	t_fixed = batch_time() - start;
+
+	for (i = 0; i < cnt; i++) {
+		double fval = (double)out[i].fval.val / ELEC_FIXED_ONE;
+		double err = fabs(fval - out[i].val);
+
+		if (out[i].err) {
+			errors++;
+			continue;
+		}
+
+		if (err * ELEC_FIXED_ONE > max_err)
+			max_err = err * ELEC_FIXED_ONE;
+
+		if (fabs(out[i].val) >= 1 && err / fabs(out[i].val) > max_rel)
+			max_rel = err / fabs(out[i].val);
+	}
+
+	printf("%s,%.1f,%.1f,%.2f,%.3g,%.3g,%zu\n", b->name,
+	       1e9 * t_float / cnt, 1e9 * t_fixed / cnt, t_float / t_fixed,
+	       max_err, max_rel, errors);
+
+	free(in);
+	free(out);
+
+	return 0;
+}
+
+static void fixed_usage(void)
+{
+	printf("usage: fixedbench [options]\n\n"
+	       "Compares speed and precision of fixed and floating point calculations.\n\n"
+	       "  -n count     number of random inputs per operation (default 1000000)\n"
+	       "  -m material  material name (default copper)\n");
+}
+
+int batch_fixed(int argc, char *argv[])
+{
+	struct elec_material *mat = elec_material_by_name("copper");
+	struct elec_fixed_material fmat;
+	size_t cnt = 1000000;
+	unsigned int i;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "hm:n:")) != -1) {
+		switch (opt) {
+		case 'm':
+			mat = elec_material_by_name(optarg);
+			if (!mat) {
+				fprintf(stderr, "Invalid material '%s'\n", optarg);
+				return 1;
+			}
+		break;
+		case 'n':
+			cnt = strtoul(optarg, NULL, 0);
+		break;
+		case 'h':
+			fixed_usage();
+			return 0;
+		default:
+			fixed_usage();
+			return 1;
+		}
+	}
+
+	if (!cnt) {
+		fprintf(stderr, "Count must be positive\n");
+		return 1;
+	}
+
+	elec_fixed_material_init(&fmat, mat);
+
+	printf("op,float_ns,fixed_ns,speedup,max_err_last_place,max_rel_err,errors\n");
+
+	for (i = 0; benches[i].name; i++) {
+		if (run_bench(&benches[i], mat, &fmat, cnt))
+			return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,164 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Fusing current and I²t withstand table for materials x sizes x fault times.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <math.h>
+
+#include "libelec.h"
+#include "elec_fuse.h"
+#include "batch.h"
+
+#define MAX_TIMES 64
+
+static size_t parse_times(char *str, double *times)
+{
+	char *tok, *end;
+	size_t cnt = 0;
+
+	for (tok = strtok(str, ","); tok; tok = strtok(NULL, ",")) {
+		if (cnt >= MAX_TIMES)
+			return 0;
+
+		times[cnt] = strtod(tok, &end);
+		if (*end || !(times[cnt] > 0))
+			return 0;
+
+		cnt++;
+	}
+
+	return cnt;
+}
+
+static void fuse_usage(void)
+{
+	printf("usage: fusing [options]\n\n"
+	       "  -m material  material name, may be repeated (default all)\n"
+	       "  -s sizes     metric, awg or all (default all)\n"
+	       "  -t times     comma separated fault durations in s (default 0.01,0.1,1,10)\n"
+	       "  -a temp      ambient temperature in °C (default 25)\n"
+	       "  -x temp      final temperature for I²t in °C (default melting point)\n");
+}
+
+int batch_fuse(int argc, char *argv[])
+{
+	size_t materials[ELEC_RESISTIVITY_CNT], materials_cnt = 0;
+	double times[MAX_TIMES] = {0.01, 0.1, 1, 10};
+	double ambient = 25, t_final = NAN, start;
+	size_t times_cnt = 4, sizes_cnt, m, s, t;
+	const char *which = "all";
+	struct batch_size *sizes;
+	double *area, *i2t, *current, *time;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "a:hm:s:t:x:")) != -1) {
+		switch (opt) {
+		case 'a':
+			ambient = atof(optarg);
+		break;
+		case 'm': {
+			struct elec_material *mat = elec_material_by_name(optarg);
+
+			if (!mat) {
+				fprintf(stderr, "Invalid material '%s'\n", optarg);
+				return 1;
+			}
+
+			if (materials_cnt < ELEC_RESISTIVITY_CNT)
+				materials[materials_cnt++] = mat - elec_material;
+		} break;
+		case 's':
+			which = optarg;
+		break;
+		case 't':
+			times_cnt = parse_times(optarg, times);
+			if (!times_cnt) {
+				fprintf(stderr, "Invalid times\n");
+				return 1;
+			}
+		break;
+		case 'x':
+			t_final = atof(optarg);
+		break;
+		case 'h':
+			fuse_usage();
+			return 0;
+		default:
+			fuse_usage();
+			return 1;
+		}
+	}
+
+	if (!materials_cnt) {
+		for (materials_cnt = 0; materials_cnt < elec_material_cnt; materials_cnt++)
+			materials[materials_cnt] = materials_cnt;
+	}
+
+	sizes = batch_sizes(which, &sizes_cnt);
+	if (!sizes) {
+		fprintf(stderr, "Invalid sizes '%s'\n", which);
+		return 1;
+	}
+
+	/* Rows for one material are sizes x times */
+	area = malloc(4 * sizes_cnt * times_cnt * sizeof(double));
+	if (!area) {
+		fprintf(stderr, "Failed to allocate memory\n");
+		free(sizes);
+		return 1;
+	}
+
+	time = area + sizes_cnt * times_cnt;
+	i2t = time + sizes_cnt * times_cnt;
+	current = i2t + sizes_cnt * times_cnt;
+
+	for (s = 0; s < sizes_cnt; s++) {
+		for (t = 0; t < times_cnt; t++) {
+			area[s * times_cnt + t] = sizes[s].area;
+			time[s * times_cnt + t] = times[t];
+		}
+	}
+
+	start = batch_time();
+
+	printf("material,size,size_unit,time_s,i2t_a2s,fusing_a,preece_a\n");
+
+	for (m = 0; m < materials_cnt; m++) {
+		struct elec_material *mat = &elec_material[materials[m]];
+		double tf = isnan(t_final) ? mat->melting_point : t_final;
+
+		elec_i2t_batch(mat, area, ambient, tf, i2t, sizes_cnt * times_cnt);
+		elec_fusing_current_batch(mat, area, time, ambient, current, sizes_cnt * times_cnt);
+
+		for (s = 0; s < sizes_cnt; s++) {
+			double d = 2 * sqrt(sizes[s].area / M_PI);
+			double preece = elec_fusing_current_preece(mat, d);
+			char size[32];
+
+			batch_size_csv(&sizes[s], size, sizeof(size));
+
+			for (t = 0; t < times_cnt; t++) {
+				printf("\"%s\",%s,%g,%g,%g,%g\n", mat->name, size, times[t],
+				       i2t[s * times_cnt + t], current[s * times_cnt + t], preece);
+			}
+		}
+	}
+
+	batch_report("rows", materials_cnt * sizes_cnt * times_cnt, 0, batch_time() - start);
+
+	free(area);
+	free(sizes);
+
+	return 0;
+}
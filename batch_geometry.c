@@ -0,0 +1,318 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Resistance and mass of conductors of various geometries from rows:
+ *
+ * material,length_m,shape,dimensions...
+ *
+ * with dimensions in mm:
+ *
+ * round,diameter
+ * rect,width,height[,edge_radius]
+ * tube,diameter,wall
+ * stranded,strands,strand_diameter[,lay_factor]
+ */
+
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "libelec.h"
+#include "elec_fmt.h"
+#include "elec_geometry.h"
+#include "batch.h"
+
+#define FIELDS_MAX 6
+
+struct conductors {
+	size_t cnt;
+	size_t size;
+	uint16_t *material;
+	struct elec_geometry *geometry;
+	double *length;
+	double *area;
+	double *resistance;
+	double *mass;
+};
+
+static double field_val(const char *field)
+{
+	char *end;
+	double ret = strtod(field, &end);
+
+	while (*end == ' ' || *end == '\t')
+		end++;
+
+	if (end == field || *end)
+		return NAN;
+
+	return ret;
+}
+
+static int conductors_grow(struct conductors *c)
+{
+	size_t size = c->size ? 2 * c->size : 1024;
+	double **arrs[] = {&c->length, &c->area, &c->resistance, &c->mass};
+	struct elec_geometry *geometry;
+	uint16_t *material;
+	unsigned int i;
+
+	for (i = 0; i < sizeof(arrs) / sizeof(*arrs); i++) {
+		double *tmp = realloc(*arrs[i], size * sizeof(double));
+
+		if (!tmp)
+			return 1;
+
+		*arrs[i] = tmp;
+	}
+
+	material = realloc(c->material, size * sizeof(*material));
+	if (!material)
+		return 1;
+
+	c->material = material;
+
+	geometry = realloc(c->geometry, size * sizeof(*geometry));
+	if (!geometry)
+		return 1;
+
+	c->geometry = geometry;
+	c->size = size;
+
+	return 0;
+}
+
+static void conductors_free(struct conductors *c)
+{
+	free(c->material);
+	free(c->geometry);
+	free(c->length);
+	free(c->area);
+	free(c->resistance);
+	free(c->mass);
+}
+
+/*
+ * Parses shape and dimensions in mm, returns non-zero on invalid input.
+ */
+static int parse_geometry(struct elec_geometry *g, char *fields[], unsigned int cnt)
+{
+	double dims[3] = {0, 0, 0};
+	unsigned int i, min, max;
+	int type;
+
+	type = elec_geometry_by_name(fields[0] + strspn(fields[0], " \t"));
+	if (type < 0)
+		return 1;
+
+	switch (type) {
+	case ELEC_GEOMETRY_ROUND:
+		min = max = 1;
+	break;
+	case ELEC_GEOMETRY_TUBE:
+		min = max = 2;
+	break;
+	default:
+		min = 2;
+		max = 3;
+	break;
+	}
+
+	if (cnt - 1 < min || cnt - 1 > max)
+		return 1;
+
+	for (i = 1; i < cnt; i++) {
+		dims[i - 1] = field_val(fields[i]);
+		if (isnan(dims[i - 1]))
+			return 1;
+	}
+
+	g->type = type;
+
+	switch (type) {
+	case ELEC_GEOMETRY_ROUND:
+		g->round.diameter = dims[0] * 1e-3;
+	break;
+	case ELEC_GEOMETRY_RECT:
+		g->rect.width = dims[0] * 1e-3;
+		g->rect.height = dims[1] * 1e-3;
+		g->rect.radius = dims[2] * 1e-3;
+	break;
+	case ELEC_GEOMETRY_TUBE:
+		g->tube.diameter = dims[0] * 1e-3;
+		g->tube.wall = dims[1] * 1e-3;
+	break;
+	case ELEC_GEOMETRY_STRANDED:
+		if (!(dims[0] >= 1) || dims[0] != floor(dims[0]))
+			return 1;
+
+		g->stranded.strands = dims[0];
+		g->stranded.diameter = dims[1] * 1e-3;
+		g->stranded.lay_factor = cnt > 3 ? dims[2] : 1;
+	break;
+	}
+
+	if (isnan(elec_geometry_area(g)) || isnan(elec_geometry_lay_factor(g)))
+		return 1;
+
+	return 0;
+}
+
+static int geometry_load(struct conductors *c, FILE *in, const char *path)
+{
+	char *line = NULL, *fields[FIELDS_MAX];
+	size_t line_size = 0, line_no = 0;
+	int ret = 0;
+
+	while (getline(&line, &line_size, in) > 0) {
+		struct elec_material *mat;
+		struct elec_geometry g;
+		unsigned int cnt;
+		double length;
+
+		line_no++;
+
+		if (line[0] == '#' || line[strspn(line, " \t\r\n")] == 0)
+			continue;
+
+		cnt = batch_csv_split(line, fields, FIELDS_MAX);
+
+		mat = cnt >= 4 ? elec_material_by_name(fields[0]) : NULL;
+		length = cnt >= 4 ? field_val(fields[1]) : NAN;
+
+		if (!mat || !(length >= 0) || parse_geometry(&g, fields + 2, cnt - 2)) {
+			/* Skip header */
+			if (line_no == 1)
+				continue;
+
+			fprintf(stderr, "%s:%zu: Invalid conductor\n", path, line_no);
+			ret = 1;
+			break;
+		}
+
+		if (c->cnt >= c->size && conductors_grow(c)) {
+			fprintf(stderr, "Failed to allocate memory\n");
+			ret = 1;
+			break;
+		}
+
+		c->material[c->cnt] = mat - elec_material;
+		c->geometry[c->cnt] = g;
+		c->length[c->cnt] = length;
+		c->cnt++;
+	}
+
+	free(line);
+
+	return ret;
+}
+
+/*
+ * Consecutive conductors of the same material are a single batch call.
+ */
+static void geometry_compute(struct conductors *c)
+{
+	size_t i, j;
+
+	for (i = 0; i < c->cnt; i = j) {
+		for (j = i + 1; j < c->cnt && c->material[j] == c->material[i]; j++);
+
+		elec_geometry_batch(&elec_material[c->material[i]], c->geometry + i,
+		                    c->length + i, c->area + i, c->resistance + i,
+		                    c->mass + i, j - i);
+	}
+}
+
+static void geometry_print(const struct conductors *c, int digits)
+{
+	char length[ELEC_FMT_MAX], area[ELEC_FMT_MAX];
+	char resistance[ELEC_FMT_MAX], mass[ELEC_FMT_MAX];
+	size_t i;
+
+	printf("material,length_m,shape,area_mm2,resistance_ohm,mass_kg\n");
+
+	for (i = 0; i < c->cnt; i++) {
+		elec_fmt_digits(c->length[i], digits, length);
+		elec_fmt_digits(c->area[i] * 1e6, digits, area);
+		elec_fmt_digits(c->resistance[i], digits, resistance);
+		elec_fmt_digits(c->mass[i], digits, mass);
+
+		printf("\"%s\",%s,%s,%s,%s,%s\n", elec_material[c->material[i]].name,
+		       length, elec_geometry_names[c->geometry[i].type],
+		       area, resistance, mass);
+	}
+}
+
+static void geometry_usage(void)
+{
+	printf("usage: geometry [options] [file]\n\n"
+	       "Reads rows material,length_m,shape,dimensions... with dimensions in mm:\n\n"
+	       "  round,diameter\n"
+	       "  rect,width,height[,edge_radius]\n"
+	       "  tube,diameter,wall\n"
+	       "  stranded,strands,strand_diameter[,lay_factor]\n\n"
+	       "and prints cross section, resistance and mass.\n\n"
+	       "  -d digits    significant digits (default 6)\n");
+}
+
+int batch_geometry(int argc, char *argv[])
+{
+	struct conductors c = {};
+	const char *path = "stdin";
+	FILE *in = stdin;
+	int opt, digits = 6, ret;
+	double start;
+
+	while ((opt = getopt(argc, argv, "d:h")) != -1) {
+		switch (opt) {
+		case 'd':
+			digits = atoi(optarg);
+			if (digits < 1 || digits > 17) {
+				fprintf(stderr, "Digits must be in 1-17\n");
+				return 1;
+			}
+		break;
+		case 'h':
+			geometry_usage();
+			return 0;
+		default:
+			geometry_usage();
+			return 1;
+		}
+	}
+
+	if (optind < argc && strcmp(argv[optind], "-")) {
+		path = argv[optind];
+		in = fopen(path, "r");
+		if (!in) {
+			fprintf(stderr, "Failed to open '%s': %s\n", path, strerror(errno));
+			return 1;
+		}
+	}
+
+	start = batch_time();
+
+	ret = geometry_load(&c, in, path);
+
+	if (in != stdin)
+		fclose(in);
+
+	if (!ret) {
+		geometry_compute(&c);
+		geometry_print(&c, digits);
+		batch_report("conductors", c.cnt, 0, batch_time() - start);
+	}
+
+	conductors_free(&c);
+
+	return ret;
+}
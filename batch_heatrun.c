@@ -0,0 +1,256 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Heat-run test evaluation for logs of hot resistance readings with rows:
+ *
+ * time_s,resistance_ohm
+ *
+ * Each reading is converted to the winding temperature and rise as it is
+ * read so that a log can be piped in while the test is running. Once the
+ * input ends the readings taken after the shutdown are fitted and the
+ * temperature is extrapolated to the shutdown time.
+ */
+
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "libelec.h"
+#include "elec_fmt.h"
+#include "elec_heatrun.h"
+#include "batch.h"
+
+#define FIELDS_MAX 2
+
+static double field_val(const char *field)
+{
+	char *end;
+	double ret = strtod(field, &end);
+
+	while (*end == ' ' || *end == '\t' || *end == '\r' || *end == '\n')
+		end++;
+
+	if (end == field || *end)
+		return NAN;
+
+	return ret;
+}
+
+static void print_num(double val, int digits)
+{
+	char buf[ELEC_FMT_MAX];
+
+	elec_fmt_digits(val, digits, buf);
+	printf(",%s", buf);
+}
+
+static int heatrun_run(struct elec_heatrun *hr, FILE *in, const char *path, int digits)
+{
+	char *line = NULL, *fields[FIELDS_MAX];
+	size_t line_size = 0, line_no = 0, samples = 0;
+	double start = batch_time();
+	int ret = 0;
+
+	printf("time_s,resistance_ohm,temp_c,rise_k\n");
+
+	while (getline(&line, &line_size, in) > 0) {
+		double time, r_hot, temp;
+		char buf[ELEC_FMT_MAX];
+		unsigned int cnt;
+
+		line_no++;
+
+		if (line[0] == '#' || line[strspn(line, " \t\r\n")] == 0)
+			continue;
+
+		cnt = batch_csv_split(line, fields, FIELDS_MAX);
+
+		time = cnt == 2 ? field_val(fields[0]) : NAN;
+		r_hot = cnt == 2 ? field_val(fields[1]) : NAN;
+
+		if (!isfinite(time) || !(r_hot > 0)) {
+			/* Skip header */
+			if (line_no == 1)
+				continue;
+
+			fprintf(stderr, "%s:%zu: Invalid sample\n", path, line_no);
+			ret = 1;
+			break;
+		}
+
+		temp = elec_heatrun_sample(hr, time, r_hot);
+
+		elec_fmt_digits(time, digits, buf);
+		printf("%s", buf);
+		print_num(r_hot, digits);
+		print_num(temp, digits);
+		print_num(temp - hr->t_coolant, digits);
+		printf("\n");
+
+		/* Samples are shown as they come when the log is piped in */
+		fflush(stdout);
+
+		samples++;
+	}
+
+	free(line);
+
+	batch_report("samples", samples, 0, batch_time() - start);
+
+	return ret;
+}
+
+static void print_fit(const struct elec_heatrun *hr, enum elec_heatrun_fit fit)
+{
+	struct elec_heatrun_result res;
+
+	if (elec_heatrun_fit(hr, fit, &res)) {
+		printf("# %s fit failed, not enough samples (%zu)\n",
+		       elec_heatrun_fit_names[fit], res.samples);
+		return;
+	}
+
+	printf("# %s fit of %zu samples, shutdown temp %.4g °C, rise %.4g K",
+	       elec_heatrun_fit_names[fit], res.samples, res.temp, res.rise);
+
+	if (!isnan(res.tau))
+		printf(", tau %.4g s", res.tau);
+
+	if (fit == ELEC_HEATRUN_EXP)
+		printf(", rms %.3g %%\n", 100 * res.rms);
+	else
+		printf(", rms %.3g K\n", res.rms);
+}
+
+static void heatrun_usage(void)
+{
+	printf("usage: heatrun [options] -r ohm [log.csv]\n\n"
+	       "Reads hot resistance samples time_s,resistance_ohm and prints the\n"
+	       "winding temperature and rise of each, then extrapolates the\n"
+	       "temperature to the shutdown from the cooling curve.\n\n"
+	       "  -r ohm       cold resistance\n"
+	       "  -c temp      cold winding temperature in °C (default 20)\n"
+	       "  -a temp      coolant temperature in °C (default cold temperature)\n"
+	       "  -s time      shutdown time in s (default 0)\n"
+	       "  -w time      fit samples up to time s after shutdown (default all)\n"
+	       "  -f fit       linear, quadratic, exp or all (default exp)\n"
+	       "  -m material  winding material (default copper)\n"
+	       "  -d digits    significant digits (default 6)\n");
+}
+
+int batch_heatrun(int argc, char *argv[])
+{
+	struct elec_heatrun hr = {
+		.material = elec_material_by_name("copper"),
+		.t_cold = 20,
+		.t_coolant = NAN,
+		.window = INFINITY,
+	};
+	const char *path = "stdin";
+	FILE *in = stdin;
+	int opt, ret, fit = ELEC_HEATRUN_EXP, digits = 6;
+
+	while ((opt = getopt(argc, argv, "a:c:d:f:hm:r:s:w:")) != -1) {
+		switch (opt) {
+		case 'a':
+			hr.t_coolant = atof(optarg);
+		break;
+		case 'c':
+			hr.t_cold = atof(optarg);
+		break;
+		case 'd':
+			digits = atoi(optarg);
+			if (digits < 1 || digits > 17) {
+				fprintf(stderr, "Digits must be in 1-17\n");
+				return 1;
+			}
+		break;
+		case 'f':
+			if (!strcmp(optarg, "all")) {
+				fit = ELEC_HEATRUN_FIT_CNT;
+				break;
+			}
+
+			fit = elec_heatrun_fit_by_name(optarg);
+			if (fit < 0) {
+				fprintf(stderr, "Invalid fit '%s'\n", optarg);
+				return 1;
+			}
+		break;
+		case 'm':
+			hr.material = elec_material_by_name(optarg);
+			if (!hr.material) {
+				fprintf(stderr, "Invalid material '%s'\n", optarg);
+				return 1;
+			}
+		break;
+		case 'r':
+			hr.r_cold = atof(optarg);
+		break;
+		case 's':
+			hr.t_shutdown = atof(optarg);
+		break;
+		case 'w':
+			hr.window = atof(optarg);
+		break;
+		case 'h':
+			heatrun_usage();
+			return 0;
+		default:
+			heatrun_usage();
+			return 1;
+		}
+	}
+
+	if (!(hr.r_cold > 0)) {
+		fprintf(stderr, "Cold resistance must be positive\n");
+		return 1;
+	}
+
+	if (!(hr.material->tc > 0)) {
+		fprintf(stderr, "Material '%s' resistance does not depend on temperature\n",
+		        hr.material->name);
+		return 1;
+	}
+
+	if (isnan(hr.t_coolant))
+		hr.t_coolant = hr.t_cold;
+
+	if (optind < argc && strcmp(argv[optind], "-")) {
+		path = argv[optind];
+		in = fopen(path, "r");
+		if (!in) {
+			fprintf(stderr, "Failed to open '%s': %s\n", path, strerror(errno));
+			return 1;
+		}
+	}
+
+	elec_heatrun_reset(&hr);
+
+	ret = heatrun_run(&hr, in, path, digits);
+
+	if (ret)
+		goto exit;
+
+	if (fit == ELEC_HEATRUN_FIT_CNT) {
+		for (fit = 0; fit < ELEC_HEATRUN_FIT_CNT; fit++)
+			print_fit(&hr, fit);
+	} else {
+		print_fit(&hr, fit);
+	}
+
+exit:
+	if (in != stdin)
+		fclose(in);
+
+	return ret;
+}
@@ -0,0 +1,301 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Material identification of wire samples from an inspection log with rows:
+ *
+ * sample,resistance_ohm,length_m,diameter_mm,mass_g
+ *
+ * The mass column is optional, if empty only the resistivity is matched.
+ */
+
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "libelec.h"
+#include "elec_fmt.h"
+#include "elec_ident.h"
+#include "elec_par.h"
+#include "batch.h"
+
+#define SAMPLE_NAME_MAX 64
+#define MATCHES_MAX 8
+
+struct sample {
+	char name[SAMPLE_NAME_MAX];
+	double ro;
+	double density;
+	size_t cnt;
+	struct elec_ident_match matches[MATCHES_MAX];
+};
+
+struct ident {
+	struct elec_ident_index idx;
+	struct elec_ident_query query;
+	size_t matches;
+
+	size_t cnt;
+	size_t size;
+	struct sample *samples;
+};
+
+static double field_val(const char *field)
+{
+	char *end;
+	double ret = strtod(field, &end);
+
+	while (*end == ' ' || *end == '\t')
+		end++;
+
+	if (end == field || *end)
+		return NAN;
+
+	return ret;
+}
+
+static int ident_load(struct ident *id, FILE *in, const char *path)
+{
+	char *line = NULL, *fields[5];
+	size_t line_size = 0, line_no = 0;
+	int ret = 0;
+
+	while (getline(&line, &line_size, in) > 0) {
+		double resistance, length, diameter, mass = NAN;
+		struct elec_val area;
+		struct sample *s;
+		unsigned int cnt;
+		int mass_valid = 1;
+
+		line_no++;
+
+		if (line[0] == '#' || line[strspn(line, " \t\r\n")] == 0)
+			continue;
+
+		cnt = batch_csv_split(line, fields, 5);
+		if (cnt < 4) {
+			fprintf(stderr, "%s:%zu: Expected at least 4 fields\n", path, line_no);
+			ret = 1;
+			break;
+		}
+
+		resistance = field_val(fields[1]);
+		length = field_val(fields[2]);
+		diameter = field_val(fields[3]);
+
+		/* Empty mass means that the sample was not weighted */
+		if (cnt == 5 && fields[4][strspn(fields[4], " \t")]) {
+			mass = field_val(fields[4]);
+			mass_valid = mass > 0;
+		}
+
+		if (!(resistance > 0) || !(length > 0) || !(diameter > 0) || !mass_valid) {
+			/* Skip header */
+			if (line_no == 1)
+				continue;
+
+			fprintf(stderr, "%s:%zu: Invalid sample\n", path, line_no);
+			ret = 1;
+			break;
+		}
+
+		if (id->cnt >= id->size) {
+			size_t size = id->size ? 2 * id->size : 1024;
+			struct sample *tmp = realloc(id->samples, size * sizeof(*tmp));
+
+			if (!tmp) {
+				fprintf(stderr, "Failed to allocate memory\n");
+				ret = 1;
+				break;
+			}
+
+			id->samples = tmp;
+			id->size = size;
+		}
+
+		s = &id->samples[id->cnt++];
+
+		snprintf(s->name, sizeof(s->name), "%s", fields[0]);
+
+		area = (struct elec_val) {
+			.val = diameter,
+			.type = ELEC_UNIT_LENGTH,
+			.unit = ELEC_UNIT_MM,
+		};
+		elec_circle_area(&area, ELEC_UNIT_M2);
+
+		s->ro = elec_ident_resistivity(
+			(struct elec_val) {.val = resistance, .type = ELEC_UNIT_RESISTANCE, .unit = ELEC_UNIT_OHM},
+			(struct elec_val) {.val = length, .type = ELEC_UNIT_LENGTH, .unit = ELEC_UNIT_M},
+			area);
+
+		s->density = NAN;
+
+		if (!isnan(mass)) {
+			s->density = elec_ident_density(
+				(struct elec_val) {.val = mass, .type = ELEC_UNIT_MASS, .unit = ELEC_UNIT_G},
+				(struct elec_val) {.val = length, .type = ELEC_UNIT_LENGTH, .unit = ELEC_UNIT_M},
+				area);
+		}
+	}
+
+	free(line);
+
+	return ret;
+}
+
+static void ident_samples(void *priv, size_t from, size_t to)
+{
+	struct ident *id = priv;
+	size_t i;
+
+	for (i = from; i < to; i++) {
+		struct sample *s = &id->samples[i];
+		struct elec_ident_query query = id->query;
+
+		query.ro = s->ro;
+		query.density = s->density;
+
+		s->cnt = elec_ident_lookup(&id->idx, &query, s->matches, id->matches);
+	}
+}
+
+static void print_sample(const struct sample *s)
+{
+	char ro[ELEC_FMT_MAX], density[ELEC_FMT_MAX], dist[ELEC_FMT_MAX], conf[ELEC_FMT_MAX];
+	size_t i;
+
+	elec_fmt_digits(s->ro, 4, ro);
+
+	if (isnan(s->density))
+		density[0] = 0;
+	else
+		elec_fmt_digits(s->density, 4, density);
+
+	if (!s->cnt) {
+		printf("\"%s\",%s,%s,0,,,\n", s->name, ro, density);
+		return;
+	}
+
+	for (i = 0; i < s->cnt; i++) {
+		elec_fmt_digits(s->matches[i].dist, 3, dist);
+		elec_fmt_digits(s->matches[i].confidence, 3, conf);
+
+		printf("\"%s\",%s,%s,%zu,\"%s\",%s,%s\n", s->name, ro, density, i + 1,
+		       s->matches[i].material->name, dist, conf);
+	}
+}
+
+static void ident_usage(void)
+{
+	printf("usage: ident [options] [log.csv]\n\n"
+	       "Identifies material of wire samples from rows\n"
+	       "sample,resistance_ohm,length_m,diameter_mm[,mass_g].\n\n"
+	       "  -k matches   number of matches per sample (default 3, max %i)\n"
+	       "  -r tol       relative resistivity uncertainty (default 0.02)\n"
+	       "  -d tol       relative density uncertainty (default 0.02)\n"
+	       "  -T temp      sample temperature in C (default %i)\n"
+	       "  -t threads   number of threads\n", MATCHES_MAX, ELEC_TEMP_REF);
+}
+
+int batch_ident(int argc, char *argv[])
+{
+	struct ident id = {
+		.matches = 3,
+		.query = {
+			.temp = ELEC_TEMP_REF,
+			.ro_tol = 0.02,
+			.density_tol = 0.02,
+		},
+	};
+	unsigned int threads = 0;
+	const char *path = "-";
+	double start;
+	FILE *in = stdin;
+	size_t i;
+	int opt, ret = 1;
+
+	while ((opt = getopt(argc, argv, "d:hk:r:T:t:")) != -1) {
+		switch (opt) {
+		case 'd':
+			id.query.density_tol = atof(optarg);
+		break;
+		case 'k':
+			id.matches = atoi(optarg);
+			if (id.matches < 1 || id.matches > MATCHES_MAX) {
+				fprintf(stderr, "Matches must be in 1-%i\n", MATCHES_MAX);
+				return 1;
+			}
+		break;
+		case 'r':
+			id.query.ro_tol = atof(optarg);
+		break;
+		case 'T':
+			id.query.temp = atof(optarg);
+		break;
+		case 't':
+			threads = atoi(optarg);
+		break;
+		case 'h':
+			ident_usage();
+			return 0;
+		default:
+			ident_usage();
+			return 1;
+		}
+	}
+
+	if (!(id.query.ro_tol > 0) || !(id.query.density_tol > 0)) {
+		fprintf(stderr, "Uncertainties must be positive\n");
+		return 1;
+	}
+
+	if (optind < argc && strcmp(argv[optind], "-")) {
+		path = argv[optind];
+		in = fopen(path, "r");
+		if (!in) {
+			fprintf(stderr, "Failed to open '%s': %s\n", path, strerror(errno));
+			return 1;
+		}
+	}
+
+	if (elec_ident_index_init(&id.idx, elec_material, elec_material_cnt)) {
+		fprintf(stderr, "Failed to allocate memory\n");
+		goto exit;
+	}
+
+	if (ident_load(&id, in, path))
+		goto exit;
+
+	if (!threads)
+		threads = elec_par_threads();
+
+	start = batch_time();
+
+	elec_par_for(id.cnt, threads, ident_samples, &id);
+
+	batch_report("samples", id.cnt, 0, batch_time() - start);
+
+	printf("sample,resistivity_ohm_m,density_kg_m3,rank,material,distance,confidence\n");
+
+	for (i = 0; i < id.cnt; i++)
+		print_sample(&id.samples[i]);
+
+	ret = 0;
+exit:
+	elec_ident_index_exit(&id.idx);
+	free(id.samples);
+
+	if (in != stdin)
+		fclose(in);
+
+	return ret;
+}
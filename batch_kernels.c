@@ -0,0 +1,196 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Benchmark of the batch kernels in all instruction set variants supported
+ * by the CPU. Results of each variant are compared bit by bit against the
+ * generic C loops.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "libelec.h"
+#include "elec_batch.h"
+#include "batch.h"
+
+enum kernel {
+	K_RESISTANCE,
+	K_MASS,
+	K_TEMP,
+	K_CONVERT,
+	K_OHM_LAW,
+	K_CNT,
+};
+
+static const char *const kernel_names[K_CNT] = {
+	[K_RESISTANCE] = "resistance",
+	[K_MASS] = "mass",
+	[K_TEMP] = "resistance_temp",
+	[K_CONVERT] = "unit_convert",
+	[K_OHM_LAW] = "ohm_law",
+};
+
+struct kern_bench {
+	size_t cnt;
+	unsigned int rounds;
+	const struct elec_material *mat;
+	double *a;
+	double *b;
+	double *out;
+	double *out2;
+	/* results of the generic variant */
+	double *ref;
+	double *ref2;
+};
+
+static void run_kernel(struct kern_bench *k, enum kernel kern)
+{
+	switch (kern) {
+	case K_RESISTANCE:
+		elec_resistance_batch(k->mat, k->a, k->b, k->out, k->cnt);
+	break;
+	case K_MASS:
+		elec_mass_batch(k->mat, k->a, k->b, k->out, k->cnt);
+	break;
+	case K_TEMP:
+		elec_resistance_temp_batch(k->mat, 1.5, k->a, k->out, k->cnt);
+	break;
+	case K_CONVERT:
+		elec_unit_convert_batch(ELEC_UNIT_LENGTH, ELEC_UNIT_FOOT, ELEC_UNIT_MM,
+		                        k->a, k->out, k->cnt);
+	break;
+	case K_OHM_LAW:
+		elec_ohm_law_batch(k->a, k->b, k->out, k->out2, k->cnt);
+	break;
+	case K_CNT:
+	break;
+	}
+}
+
+static void bench_isa(struct kern_bench *k, const char *isa, int ref)
+{
+	unsigned int kern, r;
+
+	for (kern = 0; kern < K_CNT; kern++) {
+		size_t bytes = k->cnt * sizeof(double);
+		double start, secs;
+		int same = 1;
+
+		memset(k->out, 0, bytes);
+		memset(k->out2, 0, bytes);
+		run_kernel(k, kern);
+
+		if (ref) {
+			memcpy(k->ref + kern * k->cnt, k->out, bytes);
+			memcpy(k->ref2 + kern * k->cnt, k->out2, bytes);
+		} else {
+			same = !memcmp(k->ref + kern * k->cnt, k->out, bytes) &&
+			       !memcmp(k->ref2 + kern * k->cnt, k->out2, bytes);
+		}
+
+		start = batch_time();
+
+		for (r = 0; r < k->rounds; r++)
+			run_kernel(k, kern);
+
+		secs = batch_time() - start;
+		if (secs <= 0)
+			secs = 1e-9;
+
+		printf("%s,%s,%.1f,%s\n", isa, kernel_names[kern],
+		       (double)k->cnt * k->rounds / secs / 1e6, same ? "yes" : "no");
+	}
+}
+
+static void kernels_usage(void)
+{
+	printf("usage: kernels [options]\n\n"
+	       "Benchmarks batch kernels in all instruction set variants.\n\n"
+	       "  -n count     array size (default 4096)\n"
+	       "  -r rounds    number of rounds (default 10000)\n\n"
+	       "The variant picked at startup can be overriden with %s=name.\n",
+	       ELEC_BATCH_ISA_ENV);
+}
+
+int batch_kernels(int argc, char *argv[])
+{
+	struct kern_bench k = {.cnt = 4096, .rounds = 10000};
+	const char *selected = elec_batch_isa();
+	const char *name;
+	unsigned int i;
+	size_t j;
+	int opt, ret = 1;
+
+	while ((opt = getopt(argc, argv, "hn:r:")) != -1) {
+		switch (opt) {
+		case 'n':
+			k.cnt = strtoul(optarg, NULL, 0);
+		break;
+		case 'r':
+			k.rounds = atoi(optarg);
+		break;
+		case 'h':
+			kernels_usage();
+			return 0;
+		default:
+			kernels_usage();
+			return 1;
+		}
+	}
+
+	if (!k.cnt || !k.rounds) {
+		fprintf(stderr, "Count and rounds must be positive\n");
+		return 1;
+	}
+
+	k.mat = elec_material_by_name("copper");
+	k.a = malloc(k.cnt * sizeof(double));
+	k.b = malloc(k.cnt * sizeof(double));
+	k.out = calloc(k.cnt, sizeof(double));
+	k.out2 = calloc(k.cnt, sizeof(double));
+	k.ref = malloc(K_CNT * k.cnt * sizeof(double));
+	k.ref2 = malloc(K_CNT * k.cnt * sizeof(double));
+
+	if (!k.a || !k.b || !k.out || !k.out2 || !k.ref || !k.ref2) {
+		fprintf(stderr, "Failed to allocate memory\n");
+		goto exit;
+	}
+
+	for (j = 0; j < k.cnt; j++) {
+		k.a[j] = 0.001 + 1000.0 * rand() / RAND_MAX;
+		k.b[j] = 1e-7 + 1e-4 * rand() / RAND_MAX;
+	}
+
+	fprintf(stderr, "Selected batch kernels: %s\n", selected);
+
+	printf("isa,kernel,melem_s,identical\n");
+
+	for (i = 0; (name = elec_batch_isa_name(i)); i++) {
+		if (elec_batch_isa_set(name)) {
+			fprintf(stderr, "Variant %s not supported by the CPU\n", name);
+			continue;
+		}
+
+		bench_isa(&k, name, !i);
+	}
+
+	elec_batch_isa_set(selected);
+	ret = 0;
+exit:
+	free(k.a);
+	free(k.b);
+	free(k.out);
+	free(k.out2);
+	free(k.ref);
+	free(k.ref2);
+
+	return ret;
+}
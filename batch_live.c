@@ -0,0 +1,237 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Live U/I sample streams, a generator standing in for a meter and a
+ * consumer printing per frame statistics.
+ */
+
+#include <errno.h>
+#include <math.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "elec_live.h"
+#include "batch.h"
+
+/* Samples written between rate limiting sleeps */
+#define GEN_BATCH 1000
+
+static int gen_listen(const char *path)
+{
+	struct sockaddr_un addr = {.sun_family = AF_UNIX};
+	int fd, client;
+
+	if (strlen(path) >= sizeof(addr.sun_path)) {
+		fprintf(stderr, "Socket path too long\n");
+		return -1;
+	}
+
+	strcpy(addr.sun_path, path);
+	unlink(path);
+
+	fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0 || bind(fd, (struct sockaddr *)&addr, sizeof(addr)) || listen(fd, 1)) {
+		fprintf(stderr, "Failed to listen on '%s': %s\n", path, strerror(errno));
+		return -1;
+	}
+
+	client = accept(fd, NULL, NULL);
+
+	close(fd);
+	unlink(path);
+
+	return client;
+}
+
+static void livegen_usage(void)
+{
+	printf("usage: livegen [options]\n\n"
+	       "Writes 'U I' sample lines of a resistive load fed by a noisy AC source.\n\n"
+	       "  -r rate      samples per second, 0 for as fast as possible (default 100000)\n"
+	       "  -n count     number of samples, 0 for infinite (default 0)\n"
+	       "  -u voltage   voltage amplitude in V (default 325)\n"
+	       "  -R load      load resistance in Ohm (default 50)\n"
+	       "  -f freq      source frequency in Hz (default 50)\n"
+	       "  -s path      listen on UNIX socket and write to the first client\n");
+}
+
+int batch_livegen(int argc, char *argv[])
+{
+	double rate = 100000, amp = 325, load = 50, freq = 50, start;
+	size_t count = 0, n = 0, i;
+	const char *sock = NULL;
+	struct timespec next;
+	FILE *out = stdout;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "f:hn:r:R:s:u:")) != -1) {
+		switch (opt) {
+		case 'f':
+			freq = atof(optarg);
+		break;
+		case 'n':
+			count = strtoul(optarg, NULL, 10);
+		break;
+		case 'r':
+			rate = atof(optarg);
+		break;
+		case 'R':
+			load = atof(optarg);
+		break;
+		case 's':
+			sock = optarg;
+		break;
+		case 'u':
+			amp = atof(optarg);
+		break;
+		case 'h':
+			livegen_usage();
+			return 0;
+		default:
+			livegen_usage();
+			return 1;
+		}
+	}
+
+	if (sock) {
+		int fd = gen_listen(sock);
+
+		if (fd < 0)
+			return 1;
+
+		out = fdopen(fd, "w");
+		if (!out) {
+			close(fd);
+			return 1;
+		}
+	}
+
+	signal(SIGPIPE, SIG_IGN);
+
+	clock_gettime(CLOCK_MONOTONIC, &next);
+	start = batch_time();
+
+	while (!count || n < count) {
+		for (i = 0; i < GEN_BATCH && (!count || n < count); i++, n++) {
+			double t = rate > 0 ? n / rate : n * 1e-5;
+			double noise = (double)rand() / RAND_MAX - 0.5;
+			double u = amp * sin(2 * M_PI * freq * t) + noise;
+
+			fprintf(out, "%.6g %.6g\n", u, u / load);
+		}
+
+		if (ferror(out))
+			break;
+
+		if (rate > 0) {
+			long ns = next.tv_nsec + (long)(1e9 * GEN_BATCH / rate);
+
+			next.tv_sec += ns / 1000000000;
+			next.tv_nsec = ns % 1000000000;
+
+			fflush(out);
+			clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+		}
+	}
+
+	fflush(out);
+	batch_report("samples", n, 0, batch_time() - start);
+
+	if (out != stdout)
+		fclose(out);
+
+	return 0;
+}
+
+static void live_usage(void)
+{
+	printf("usage: live [options] source\n\n"
+	       "Reads 'U I' sample lines from a pipe, FIFO, pty, UNIX socket or - for stdin\n"
+	       "and prints statistics for each frame.\n\n"
+	       "  -i interval  frame interval in ms (default 100)\n"
+	       "  -q           print only the final throughput report\n");
+}
+
+int batch_live(int argc, char *argv[])
+{
+	struct elec_live_frame frame;
+	struct elec_live *live;
+	double interval = 100, start, now;
+	size_t total = 0;
+	int opt, quiet = 0;
+
+	while ((opt = getopt(argc, argv, "hi:q")) != -1) {
+		switch (opt) {
+		case 'i':
+			interval = atof(optarg);
+		break;
+		case 'q':
+			quiet = 1;
+		break;
+		case 'h':
+			live_usage();
+			return 0;
+		default:
+			live_usage();
+			return 1;
+		}
+	}
+
+	if (optind >= argc || !(interval > 0)) {
+		live_usage();
+		return 1;
+	}
+
+	live = elec_live_open(argv[optind], 0);
+	if (!live) {
+		fprintf(stderr, "Failed to open '%s': %s\n", argv[optind], strerror(errno));
+		return 1;
+	}
+
+	start = batch_time();
+
+	if (!quiet)
+		printf("time_s,samples,u_mean,i_mean,r_mean,p_min,p_mean,p_max,dropped,errors\n");
+
+	do {
+		struct timespec ts = {
+			.tv_sec = interval / 1000,
+			.tv_nsec = fmod(interval, 1000) * 1000000,
+		};
+
+		nanosleep(&ts, NULL);
+
+		elec_live_frame(live, &frame);
+		total += frame.cnt;
+		now = batch_time() - start;
+
+		if (quiet)
+			continue;
+
+		printf("%.3f,%zu,%g,%g,%g,%g,%g,%g,%zu,%zu\n", now, frame.cnt,
+		       frame.u.mean, frame.i.mean, frame.r.mean,
+		       frame.p.min, frame.p.mean, frame.p.max,
+		       frame.dropped, frame.errors);
+	} while (!frame.eof || frame.cnt);
+
+	batch_report("samples", total, 0, now);
+
+	if (frame.dropped || frame.errors)
+		fprintf(stderr, "%zu dropped, %zu invalid\n", frame.dropped, frame.errors);
+
+	elec_live_close(live);
+
+	return 0;
+}
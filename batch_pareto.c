@@ -0,0 +1,525 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Pareto optimal material and size selection for cable runs.
+ *
+ * Every material x standard size is a candidate, a run with a length and a
+ * current filters out candidates that exceed the voltage drop or current
+ * density limits and the rest is reduced to the Pareto front of resistance,
+ * mass and cost. The cost is computed from a price file with rows:
+ *
+ * material,price_per_kg
+ *
+ * Materials without a price are skipped when a price file is used. Runs are
+ * read from a CSV file with rows name,length_m,current_a and evaluated in
+ * parallel in batches, the output of a batch is written before the next one
+ * starts.
+ */
+
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "libelec.h"
+#include "elec_batch.h"
+#include "elec_fmt.h"
+#include "elec_par.h"
+#include "elec_pareto.h"
+#include "batch.h"
+
+#define RUN_NAME_MAX 64
+/* Worst case output row length */
+#define ROW_MAX (2 * RUN_NAME_MAX + 6 * ELEC_FMT_MAX)
+/* Runs evaluated at once, bounds the buffered output */
+#define RUNS_BATCH 1024
+
+struct cands {
+	size_t cnt;
+	uint16_t *material;
+	uint16_t *size;
+	/* per meter of the run */
+	double *r_m;
+	double *mass_m;
+	double *cost_m;
+};
+
+struct run {
+	char name[RUN_NAME_MAX];
+	double length;
+	double current;
+};
+
+struct run_out {
+	char *buf;
+	size_t len;
+	/* errno if the run failed */
+	int err;
+};
+
+struct pareto {
+	struct cands cands;
+	struct batch_size *sizes;
+
+	struct run *runs;
+	size_t runs_cnt;
+
+	double drop_max;
+	double density_max;
+
+	/* first run of the current batch and its results */
+	size_t first;
+	struct run_out *out;
+};
+
+static int load_prices(const char *path, double *prices)
+{
+	char *line = NULL, *fields[2];
+	size_t line_size = 0, line_no = 0;
+	FILE *f;
+	int ret = 0;
+
+	f = fopen(path, "r");
+	if (!f) {
+		fprintf(stderr, "Failed to open '%s': %s\n", path, strerror(errno));
+		return 1;
+	}
+
+	while (getline(&line, &line_size, f) > 0) {
+		struct elec_material *mat;
+		char *end;
+		double price;
+
+		line_no++;
+
+		if (line[0] == '#' || line[strspn(line, " \t\r\n")] == 0)
+			continue;
+
+		if (batch_csv_split(line, fields, 2) != 2) {
+			fprintf(stderr, "%s:%zu: Expected 2 fields\n", path, line_no);
+			ret = 1;
+			break;
+		}
+
+		price = strtod(fields[1], &end);
+		mat = elec_material_by_name(fields[0]);
+
+		if (!mat || end == fields[1] || !(price >= 0)) {
+			/* Skip header */
+			if (line_no == 1)
+				continue;
+
+			fprintf(stderr, "%s:%zu: Invalid row\n", path, line_no);
+			ret = 1;
+			break;
+		}
+
+		prices[mat - elec_material] = price;
+	}
+
+	free(line);
+	fclose(f);
+
+	return ret;
+}
+
+static int load_runs(struct pareto *p, const char *path)
+{
+	char *line = NULL, *fields[3];
+	size_t line_size = 0, line_no = 0, size = 0;
+	FILE *f = stdin;
+	int ret = 0;
+
+	if (strcmp(path, "-")) {
+		f = fopen(path, "r");
+		if (!f) {
+			fprintf(stderr, "Failed to open '%s': %s\n", path, strerror(errno));
+			return 1;
+		}
+	}
+
+	while (getline(&line, &line_size, f) > 0) {
+		struct run *run;
+		char *end1, *end2;
+
+		line_no++;
+
+		if (line[0] == '#' || line[strspn(line, " \t\r\n")] == 0)
+			continue;
+
+		if (batch_csv_split(line, fields, 3) != 3) {
+			fprintf(stderr, "%s:%zu: Expected 3 fields\n", path, line_no);
+			ret = 1;
+			break;
+		}
+
+		if (p->runs_cnt >= size) {
+			size_t new_size = size ? 2 * size : 64;
+			struct run *tmp = realloc(p->runs, new_size * sizeof(*tmp));
+
+			if (!tmp) {
+				fprintf(stderr, "Failed to allocate memory\n");
+				ret = 1;
+				break;
+			}
+
+			p->runs = tmp;
+			size = new_size;
+		}
+
+		run = &p->runs[p->runs_cnt];
+		run->length = strtod(fields[1], &end1);
+		run->current = strtod(fields[2], &end2);
+
+		if (end1 == fields[1] || end2 == fields[2] ||
+		    !(run->length > 0) || !(run->current >= 0)) {
+			/* Skip header */
+			if (line_no == 1)
+				continue;
+
+			fprintf(stderr, "%s:%zu: Invalid run\n", path, line_no);
+			ret = 1;
+			break;
+		}
+
+		snprintf(run->name, sizeof(run->name), "%s", fields[0]);
+		p->runs_cnt++;
+	}
+
+	free(line);
+
+	if (f != stdin)
+		fclose(f);
+
+	return ret;
+}
+
+/*
+ * Resistance, mass and cost of all candidates per meter, these scale
+ * linearly with the run length. Both the materials and the sizes are never
+ * empty.
+ */
+static int cands_init(struct cands *c, const size_t *materials, size_t materials_cnt,
+                      const struct batch_size *sizes, size_t sizes_cnt,
+                      const double *prices)
+{
+	size_t m, s, cnt = materials_cnt * sizes_cnt;
+	double *length, *area;
+
+	c->material = malloc(cnt * sizeof(uint16_t));
+	c->size = malloc(cnt * sizeof(uint16_t));
+	c->r_m = malloc(cnt * sizeof(double));
+	c->mass_m = malloc(cnt * sizeof(double));
+	c->cost_m = malloc(cnt * sizeof(double));
+	length = malloc(sizes_cnt * sizeof(double));
+	area = malloc(sizes_cnt * sizeof(double));
+
+	if (!c->material || !c->size || !c->r_m || !c->mass_m || !c->cost_m ||
+	    !length || !area) {
+		free(length);
+		free(area);
+		return 1;
+	}
+
+	for (s = 0; s < sizes_cnt; s++) {
+		length[s] = 1;
+		area[s] = sizes[s].area;
+	}
+
+	for (m = 0; m < materials_cnt; m++) {
+		struct elec_material *mat = &elec_material[materials[m]];
+		size_t off = m * sizes_cnt;
+
+		elec_resistance_batch(mat, length, area, c->r_m + off, sizes_cnt);
+		elec_mass_batch(mat, length, area, c->mass_m + off, sizes_cnt);
+
+		for (s = 0; s < sizes_cnt; s++) {
+			c->material[off + s] = materials[m];
+			c->size[off + s] = s;
+			c->cost_m[off + s] = c->mass_m[off + s] * prices[materials[m]];
+		}
+	}
+
+	c->cnt = cnt;
+
+	free(length);
+	free(area);
+
+	return 0;
+}
+
+static void cands_free(struct cands *c)
+{
+	free(c->material);
+	free(c->size);
+	free(c->r_m);
+	free(c->mass_m);
+	free(c->cost_m);
+}
+
+static size_t put_num(char *buf, double val)
+{
+	buf[0] = ',';
+
+	return 1 + elec_fmt_digits(val, 6, buf + 1);
+}
+
+static void select_run(struct pareto *p, size_t idx)
+{
+	const struct cands *c = &p->cands;
+	const struct run *run = &p->runs[p->first + idx];
+	struct run_out *o = &p->out[idx];
+	size_t *sel, *front, i, n = 0, front_cnt, len = 0;
+	double *r, *mass, *cost;
+	char *out;
+
+	o->buf = NULL;
+	o->len = 0;
+	o->err = 0;
+
+	sel = malloc(c->cnt * sizeof(size_t));
+	front = malloc(c->cnt * sizeof(size_t));
+	r = malloc(c->cnt * sizeof(double));
+	mass = malloc(c->cnt * sizeof(double));
+	cost = malloc(c->cnt * sizeof(double));
+
+	if (!sel || !front || !r || !mass || !cost) {
+		o->err = ENOMEM;
+		goto exit;
+	}
+
+	for (i = 0; i < c->cnt; i++) {
+		double res = c->r_m[i] * run->length;
+		double mm2 = p->sizes[c->size[i]].mm2;
+
+		if (run->current * res > p->drop_max)
+			continue;
+
+		if (run->current / mm2 > p->density_max)
+			continue;
+
+		sel[n] = i;
+		r[n] = res;
+		mass[n] = c->mass_m[i] * run->length;
+		cost[n] = c->cost_m[i] * run->length;
+		n++;
+	}
+
+	if (!n)
+		goto exit;
+
+	front_cnt = elec_pareto_front(r, mass, cost, n, front);
+	if (!front_cnt) {
+		if (errno == ENOMEM)
+			o->err = ENOMEM;
+		goto exit;
+	}
+
+	out = malloc(front_cnt * ROW_MAX);
+	if (!out) {
+		o->err = ENOMEM;
+		goto exit;
+	}
+
+	for (i = 0; i < front_cnt; i++) {
+		size_t j = front[i], k = sel[j];
+		char size[32];
+
+		len += snprintf(out + len, 2 * RUN_NAME_MAX, "\"%s\",\"%s\",%s",
+		                run->name, elec_material[c->material[k]].name,
+		                batch_size_csv(&p->sizes[c->size[k]], size, sizeof(size)));
+		len += put_num(out + len, r[j]);
+		len += put_num(out + len, run->current * r[j]);
+		len += put_num(out + len, run->current * run->current * r[j]);
+		len += put_num(out + len, mass[j]);
+		len += put_num(out + len, cost[j]);
+		out[len++] = '\n';
+	}
+
+	o->buf = out;
+	o->len = len;
+exit:
+	free(sel);
+	free(front);
+	free(r);
+	free(mass);
+	free(cost);
+}
+
+static void select_runs(void *priv, size_t from, size_t to)
+{
+	size_t i;
+
+	for (i = from; i < to; i++)
+		select_run(priv, i);
+}
+
+static void pareto_usage(void)
+{
+	printf("usage: pareto [options] [runs.csv]\n\n"
+	       "Prints Pareto optimal material and size choices for each run, the runs\n"
+	       "file has rows name,length_m,current_a.\n\n"
+	       "  -l length    single run length in m\n"
+	       "  -i current   single run current in A\n"
+	       "  -m material  material name, may be repeated (default all)\n"
+	       "  -s sizes     metric, awg or all (default metric)\n"
+	       "  -p file      price file with rows material,price_per_kg\n"
+	       "  -v drop      maximal voltage drop in V\n"
+	       "  -j density   maximal current density in A/mm2\n"
+	       "  -t threads   number of threads\n");
+}
+
+int batch_pareto(int argc, char *argv[])
+{
+	struct pareto p = {.drop_max = INFINITY, .density_max = INFINITY};
+	size_t materials[ELEC_RESISTIVITY_CNT], materials_cnt = 0, sizes_cnt, i, batch, rows = 0;
+	double prices[ELEC_RESISTIVITY_CNT], length = NAN, current = NAN, start;
+	const char *sizes = "metric", *price_path = NULL;
+	struct run single = {.name = "run"};
+	unsigned int threads = 0;
+	int opt, ret = 1;
+
+	while ((opt = getopt(argc, argv, "hi:j:l:m:p:s:t:v:")) != -1) {
+		switch (opt) {
+		case 'i':
+			current = atof(optarg);
+		break;
+		case 'j':
+			p.density_max = atof(optarg);
+		break;
+		case 'l':
+			length = atof(optarg);
+		break;
+		case 'm': {
+			struct elec_material *mat = elec_material_by_name(optarg);
+
+			if (!mat) {
+				fprintf(stderr, "Invalid material '%s'\n", optarg);
+				return 1;
+			}
+
+			if (materials_cnt < ELEC_RESISTIVITY_CNT)
+				materials[materials_cnt++] = mat - elec_material;
+		} break;
+		case 'p':
+			price_path = optarg;
+		break;
+		case 's':
+			sizes = optarg;
+		break;
+		case 't':
+			threads = atoi(optarg);
+		break;
+		case 'v':
+			p.drop_max = atof(optarg);
+		break;
+		case 'h':
+			pareto_usage();
+			return 0;
+		default:
+			pareto_usage();
+			return 1;
+		}
+	}
+
+	if (!materials_cnt) {
+		for (materials_cnt = 0; materials_cnt < elec_material_cnt; materials_cnt++)
+			materials[materials_cnt] = materials_cnt;
+	}
+
+	/* Without price file the cost is zero and does not affect the front */
+	for (i = 0; i < ELEC_RESISTIVITY_CNT; i++)
+		prices[i] = price_path ? NAN : 0;
+
+	if (price_path && load_prices(price_path, prices))
+		return 1;
+
+	if (optind < argc) {
+		if (load_runs(&p, argv[optind]))
+			goto exit;
+
+		if (!p.runs_cnt) {
+			fprintf(stderr, "No runs in '%s'\n", argv[optind]);
+			goto exit;
+		}
+	} else if (length > 0 && current >= 0) {
+		single.length = length;
+		single.current = current;
+		p.runs = &single;
+		p.runs_cnt = 1;
+	} else {
+		fprintf(stderr, "Either runs file or -l and -i have to be set\n");
+		return 1;
+	}
+
+	p.sizes = batch_sizes(sizes, &sizes_cnt);
+	if (!p.sizes) {
+		fprintf(stderr, "Invalid sizes '%s'\n", sizes);
+		goto exit;
+	}
+
+	p.out = calloc(RUNS_BATCH, sizeof(*p.out));
+
+	if (!p.out ||
+	    cands_init(&p.cands, materials, materials_cnt, p.sizes, sizes_cnt, prices)) {
+		fprintf(stderr, "Failed to allocate memory\n");
+		goto exit;
+	}
+
+	if (!threads)
+		threads = elec_par_threads();
+
+	start = batch_time();
+
+	printf("run,material,size,size_unit,resistance_ohm,drop_v,loss_w,mass_kg,cost\n");
+
+	ret = 0;
+
+	for (p.first = 0; !ret && p.first < p.runs_cnt; p.first += batch) {
+		batch = p.runs_cnt - p.first;
+		if (batch > RUNS_BATCH)
+			batch = RUNS_BATCH;
+
+		elec_par_for(batch, threads, select_runs, &p);
+
+		for (i = 0; i < batch; i++) {
+			struct run_out *o = &p.out[i];
+
+			if (o->err && !ret) {
+				fprintf(stderr, "Run '%s': %s\n",
+				        p.runs[p.first + i].name, strerror(o->err));
+				ret = 1;
+			}
+
+			if (!ret && o->len) {
+				fwrite(o->buf, o->len, 1, stdout);
+				rows++;
+			}
+
+			free(o->buf);
+		}
+	}
+
+	batch_report("runs", p.runs_cnt, 0, batch_time() - start);
+
+	if (!ret && rows < p.runs_cnt)
+		fprintf(stderr, "%zu runs have no candidate within the limits\n", p.runs_cnt - rows);
+
+exit:
+	free(p.out);
+	free(p.sizes);
+	cands_free(&p.cands);
+
+	if (p.runs != &single)
+		free(p.runs);
+
+	return ret;
+}
@@ -0,0 +1,262 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * PCB trace check for trace lists exported from EDA tools with rows:
+ *
+ * net,width_mm,length_mm,layer,current_a[,copper_oz]
+ *
+ * The layer is external for top, bottom, outer, external, F.Cu and B.Cu,
+ * any other layer name is internal. Each trace gets the resistance at the
+ * ambient temperature plus the allowed rise, the voltage drop and loss at
+ * the current, the current capacity and the minimal width for the current.
+ */
+
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+
+#include "libelec.h"
+#include "elec_fmt.h"
+#include "elec_pcb.h"
+#include "batch.h"
+
+#define FIELDS_MAX 6
+
+struct pcb {
+	const struct elec_material *material;
+	enum elec_pcb_std std;
+	double oz;
+	double ambient;
+	double temp_rise;
+	int digits;
+	size_t over;
+};
+
+static double field_val(const char *field)
+{
+	char *end;
+	double ret = strtod(field, &end);
+
+	while (*end == ' ' || *end == '\t')
+		end++;
+
+	if (end == field || *end)
+		return NAN;
+
+	return ret;
+}
+
+static int layer_internal(const char *layer)
+{
+	static const char *const external[] = {
+		"top", "bottom", "outer", "external", "F.Cu", "B.Cu", NULL
+	};
+	unsigned int i;
+
+	layer += strspn(layer, " \t");
+
+	for (i = 0; external[i]; i++) {
+		if (!strcasecmp(layer, external[i]))
+			return 0;
+	}
+
+	return 1;
+}
+
+static void print_num(const struct pcb *p, double val)
+{
+	char buf[ELEC_FMT_MAX];
+
+	elec_fmt_digits(val, p->digits, buf);
+	printf(",%s", buf);
+}
+
+static int pcb_trace(struct pcb *p, char *fields[], unsigned int cnt)
+{
+	struct elec_pcb_trace trace;
+	double current, oz = p->oz, r;
+	double i_max, w_min;
+
+	trace.width = field_val(fields[1]) * 1e-3;
+	trace.length = field_val(fields[2]) * 1e-3;
+	trace.internal = layer_internal(fields[3]);
+	current = field_val(fields[4]);
+
+	if (cnt > 5 && fields[5][strspn(fields[5], " \t")])
+		oz = field_val(fields[5]);
+
+	trace.thickness = oz * ELEC_PCB_OZ;
+
+	if (!(trace.width > 0) || !(trace.length >= 0) || !(current >= 0) || !(oz > 0))
+		return 1;
+
+	r = elec_pcb_resistance(p->material, &trace, p->ambient + p->temp_rise);
+	i_max = elec_pcb_current(p->std, &trace, p->temp_rise);
+	w_min = elec_pcb_width(p->std, &trace, current, p->temp_rise);
+
+	if (current > i_max)
+		p->over++;
+
+	printf("\"%s\"", fields[0]);
+	print_num(p, trace.width * 1e3);
+	print_num(p, trace.length * 1e3);
+	printf(",%s", trace.internal ? "internal" : "external");
+	print_num(p, current);
+	print_num(p, oz);
+	print_num(p, r);
+	print_num(p, current * r);
+	print_num(p, current * current * r);
+	print_num(p, i_max);
+	print_num(p, w_min * 1e3);
+	printf(",%s\n", current > i_max ? "no" : "yes");
+
+	return 0;
+}
+
+static int pcb_run(struct pcb *p, FILE *in, const char *path)
+{
+	char *line = NULL, *fields[FIELDS_MAX];
+	size_t line_size = 0, line_no = 0, traces = 0;
+	double start = batch_time();
+	int ret = 0;
+
+	/* Input columns first so that the output can be fed back */
+	printf("net,width_mm,length_mm,layer,current_a,copper_oz,resistance_ohm,"
+	       "drop_v,loss_w,max_current_a,min_width_mm,ok\n");
+
+	while (getline(&line, &line_size, in) > 0) {
+		unsigned int cnt;
+
+		line_no++;
+
+		if (line[0] == '#' || line[strspn(line, " \t\r\n")] == 0)
+			continue;
+
+		cnt = batch_csv_split(line, fields, FIELDS_MAX);
+
+		if (cnt < 5 || pcb_trace(p, fields, cnt)) {
+			/* Skip header */
+			if (line_no == 1)
+				continue;
+
+			fprintf(stderr, "%s:%zu: Invalid trace\n", path, line_no);
+			ret = 1;
+			break;
+		}
+
+		traces++;
+	}
+
+	free(line);
+
+	batch_report("traces", traces, 0, batch_time() - start);
+
+	if (p->over)
+		fprintf(stderr, "%zu traces over the current capacity\n", p->over);
+
+	return ret;
+}
+
+static void pcb_usage(void)
+{
+	printf("usage: pcb [options] [traces.csv]\n\n"
+	       "Reads PCB traces net,width_mm,length_mm,layer,current_a[,copper_oz]\n"
+	       "and prints resistance, voltage drop, loss, current capacity and\n"
+	       "minimal width.\n\n"
+	       "  -s std       current capacity standard 2221 or 2152 (default 2152)\n"
+	       "  -T rise      allowed temperature rise in °C (default 10)\n"
+	       "  -a temp      ambient temperature in °C (default 25)\n"
+	       "  -o oz        copper weight in oz/ft² (default 1)\n"
+	       "  -m material  trace material (default copper)\n"
+	       "  -d digits    significant digits (default 6)\n");
+}
+
+int batch_pcb(int argc, char *argv[])
+{
+	struct pcb p = {
+		.material = elec_material_by_name("copper"),
+		.std = ELEC_PCB_IPC2152,
+		.oz = 1,
+		.ambient = 25,
+		.temp_rise = 10,
+		.digits = 6,
+	};
+	const char *path = "stdin";
+	FILE *in = stdin;
+	int opt, ret;
+
+	while ((opt = getopt(argc, argv, "a:d:hm:o:s:T:")) != -1) {
+		switch (opt) {
+		case 'a':
+			p.ambient = atof(optarg);
+		break;
+		case 'd':
+			p.digits = atoi(optarg);
+			if (p.digits < 1 || p.digits > 17) {
+				fprintf(stderr, "Digits must be in 1-17\n");
+				return 1;
+			}
+		break;
+		case 'm':
+			p.material = elec_material_by_name(optarg);
+			if (!p.material) {
+				fprintf(stderr, "Invalid material '%s'\n", optarg);
+				return 1;
+			}
+		break;
+		case 'o':
+			p.oz = atof(optarg);
+		break;
+		case 's':
+			if (!strcmp(optarg, "2221")) {
+				p.std = ELEC_PCB_IPC2221;
+			} else if (!strcmp(optarg, "2152")) {
+				p.std = ELEC_PCB_IPC2152;
+			} else {
+				fprintf(stderr, "Invalid standard '%s'\n", optarg);
+				return 1;
+			}
+		break;
+		case 'T':
+			p.temp_rise = atof(optarg);
+		break;
+		case 'h':
+			pcb_usage();
+			return 0;
+		default:
+			pcb_usage();
+			return 1;
+		}
+	}
+
+	if (!(p.oz > 0) || !(p.temp_rise > 0)) {
+		fprintf(stderr, "Copper weight and temperature rise must be positive\n");
+		return 1;
+	}
+
+	if (optind < argc && strcmp(argv[optind], "-")) {
+		path = argv[optind];
+		in = fopen(path, "r");
+		if (!in) {
+			fprintf(stderr, "Failed to open '%s': %s\n", path, strerror(errno));
+			return 1;
+		}
+	}
+
+	ret = pcb_run(&p, in, path);
+
+	if (in != stdin)
+		fclose(in);
+
+	return ret;
+}
@@ -0,0 +1,261 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Cable project computation, prints all runs and project totals. In the
+ * watch mode the directory of the project file is watched with inotify, so
+ * that editors that replace the file by a rename work too, and on each
+ * change only the changed lines are printed together with the new totals.
+ */
+
+#include <errno.h>
+#include <libgen.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+
+#include "libelec.h"
+#include "elec_fmt.h"
+#include "elec_project.h"
+#include "batch.h"
+
+struct project_out {
+	int digits;
+	int quiet;
+};
+
+static void print_num(const struct project_out *out, double val)
+{
+	char buf[ELEC_FMT_MAX + 1];
+
+	elec_fmt_digits(val, out->digits, buf);
+	printf(",%s", buf);
+}
+
+static void print_lines(const struct project_out *out, const struct elec_project *prj,
+                        size_t from, size_t to)
+{
+	size_t i;
+
+	for (i = from; i < to; i++) {
+		const struct elec_project_line *l = &prj->lines[i];
+
+		if (l->state == ELEC_PROJECT_INVALID && i)
+			fprintf(stderr, "Invalid line %zu\n", i + 1);
+
+		if (l->state != ELEC_PROJECT_RUN || out->quiet)
+			continue;
+
+		printf("%zu,\"%s\",\"%s\"", i + 1, l->name, elec_material[l->material].name);
+		print_num(out, l->length);
+		print_num(out, l->area * 1e6);
+		print_num(out, l->current);
+		print_num(out, l->resistance);
+		print_num(out, l->drop);
+		print_num(out, l->loss);
+		print_num(out, l->mass);
+		printf("\n");
+	}
+}
+
+static void print_totals(const struct elec_project *prj)
+{
+	const struct elec_project_totals *t = &prj->totals;
+	size_t m;
+
+	printf("# runs %zu, invalid lines %zu, length %.6g m, mass %.6g kg, loss %.6g W\n",
+	       t->runs, t->invalid, t->length, t->mass, t->loss);
+
+	if (t->runs) {
+		printf("# max drop %.6g V at line %zu \"%s\"\n", t->drop_max,
+		       t->drop_max_line + 1, prj->lines[t->drop_max_line].name);
+	}
+
+	for (m = 0; m < elec_material_cnt; m++) {
+		if (!t->mat_length[m])
+			continue;
+
+		printf("# %s length %.6g m, mass %.6g kg\n",
+		       elec_material[m].name, t->mat_length[m], t->mat_mass[m]);
+	}
+}
+
+static int project_load(struct elec_project *prj, const char *path,
+                        struct elec_project_change *change)
+{
+	size_t len;
+	int mapped, ret;
+	char *buf;
+
+	buf = batch_load(path, &len, &mapped, 1);
+	if (!buf) {
+		fprintf(stderr, "Failed to read '%s': %s\n", path, strerror(errno));
+		return 1;
+	}
+
+	ret = elec_project_update(prj, buf, len, change);
+
+	batch_unload(buf, len, mapped);
+
+	if (ret)
+		fprintf(stderr, "Failed to allocate memory\n");
+
+	return ret;
+}
+
+static int project_watch(struct elec_project *prj, const struct project_out *out,
+                         const char *path)
+{
+	char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+	char *dir_path = strdup(path), *file_path = strdup(path);
+	const char *dir, *file;
+	int fd = -1, ret = 1;
+
+	if (!dir_path || !file_path) {
+		fprintf(stderr, "Failed to allocate memory\n");
+		goto exit;
+	}
+
+	dir = dirname(dir_path);
+	file = basename(file_path);
+
+	fd = inotify_init1(IN_CLOEXEC);
+	if (fd < 0 || inotify_add_watch(fd, dir, IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+		fprintf(stderr, "Failed to watch '%s': %s\n", dir, strerror(errno));
+		goto exit;
+	}
+
+	for (;;) {
+		struct elec_project_change change;
+		ssize_t len = read(fd, buf, sizeof(buf));
+		ssize_t pos;
+		int changed = 0;
+		double start;
+
+		if (len < 0 && errno == EINTR)
+			continue;
+
+		if (len <= 0) {
+			fprintf(stderr, "Failed to read inotify events: %s\n", strerror(errno));
+			break;
+		}
+
+		/* Several events for the file in one read are a single reload */
+		for (pos = 0; pos < len;) {
+			struct inotify_event *ev = (void *)(buf + pos);
+
+			if (ev->len && !strcmp(ev->name, file))
+				changed = 1;
+
+			pos += sizeof(*ev) + ev->len;
+		}
+
+		if (!changed)
+			continue;
+
+		start = batch_time();
+
+		if (project_load(prj, path, &change))
+			continue;
+
+		printf("# lines %zu-%zu replaced %zu lines\n",
+		       change.first + 1, change.first + change.added, change.removed);
+		print_lines(out, prj, change.first, change.first + change.added);
+		print_totals(prj);
+		fflush(stdout);
+
+		fprintf(stderr, "Updated %zu lines, %zu blocks in %.3f ms\n",
+		        change.added, change.blocks, 1e3 * (batch_time() - start));
+	}
+
+exit:
+	if (fd >= 0)
+		close(fd);
+
+	free(dir_path);
+	free(file_path);
+
+	return ret;
+}
+
+static void project_usage(void)
+{
+	printf("usage: project [options] file\n\n"
+	       "Reads cable runs name,material,length_m,area_mm2,current_a and prints\n"
+	       "resistance, voltage drop, loss and mass of each run and project totals.\n\n"
+	       "  -d digits    significant digits (default 6)\n"
+	       "  -q           print only totals\n"
+	       "  -w           watch the file and print changed runs and totals\n");
+}
+
+int batch_project(int argc, char *argv[])
+{
+	struct project_out out = {.digits = 6};
+	struct elec_project prj;
+	const char *path;
+	double start;
+	int opt, watch = 0, ret = 1;
+
+	while ((opt = getopt(argc, argv, "d:hqw")) != -1) {
+		switch (opt) {
+		case 'd':
+			out.digits = atoi(optarg);
+			if (out.digits < 1 || out.digits > 17) {
+				fprintf(stderr, "Digits must be in 1-17\n");
+				return 1;
+			}
+		break;
+		case 'q':
+			out.quiet = 1;
+		break;
+		case 'w':
+			watch = 1;
+		break;
+		case 'h':
+			project_usage();
+			return 0;
+		default:
+			project_usage();
+			return 1;
+		}
+	}
+
+	if (optind >= argc) {
+		fprintf(stderr, "Project file has to be set\n");
+		return 1;
+	}
+
+	path = argv[optind];
+
+	if (elec_project_init(&prj)) {
+		fprintf(stderr, "Failed to allocate memory\n");
+		return 1;
+	}
+
+	start = batch_time();
+
+	if (project_load(&prj, path, NULL))
+		goto exit;
+
+	if (!out.quiet)
+		printf("line,run,material,length_m,area_mm2,current_a,resistance_ohm,drop_v,loss_w,mass_kg\n");
+
+	print_lines(&out, &prj, 0, prj.lines_cnt);
+	print_totals(&prj);
+	fflush(stdout);
+
+	batch_report("lines", prj.lines_cnt, prj.text_len, batch_time() - start);
+
+	ret = watch ? project_watch(&prj, &out, path) : 0;
+exit:
+	elec_project_exit(&prj);
+
+	return ret;
+}
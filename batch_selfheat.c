@@ -0,0 +1,221 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Steady state temperature of conductors heated by their own losses.
+ *
+ * The input is CSV with a row per conductor:
+ *
+ * material,length_m,area_mm2,current_a,rth_k_w,ambient_c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "libelec.h"
+#include "elec_thermal.h"
+#include "batch.h"
+
+struct cables {
+	size_t cnt;
+	size_t size;
+	unsigned short *material;
+	double *r_ref;
+	double *tc;
+	double *current;
+	double *rth;
+	double *t_ambient;
+};
+
+#define CABLE_ARRAYS 5
+
+static int cables_grow(struct cables *c)
+{
+	size_t size = c->size ? 2 * c->size : 4096;
+	double **arrs[CABLE_ARRAYS] = {
+		&c->r_ref, &c->tc, &c->current, &c->rth, &c->t_ambient
+	};
+	unsigned short *material;
+	unsigned int i;
+
+	for (i = 0; i < CABLE_ARRAYS; i++) {
+		double *tmp = realloc(*arrs[i], size * sizeof(double));
+
+		if (!tmp)
+			return 1;
+
+		*arrs[i] = tmp;
+	}
+
+	material = realloc(c->material, size * sizeof(*material));
+	if (!material)
+		return 1;
+
+	c->material = material;
+	c->size = size;
+
+	return 0;
+}
+
+static void cables_free(struct cables *c)
+{
+	free(c->material);
+	free(c->r_ref);
+	free(c->tc);
+	free(c->current);
+	free(c->rth);
+	free(c->t_ambient);
+}
+
+static int cables_load(struct cables *c, FILE *in)
+{
+	char *line = NULL, *fields[6];
+	size_t line_size = 0, line_no = 0;
+	struct elec_val length = {.type = ELEC_UNIT_LENGTH, .unit = ELEC_UNIT_M};
+	struct elec_val area = {.type = ELEC_UNIT_AREA, .unit = ELEC_UNIT_MM2};
+	int ret = 0;
+
+	while (getline(&line, &line_size, in) > 0) {
+		struct elec_material *mat;
+
+		line_no++;
+
+		if (line[0] == '#' || line[strspn(line, " \t\r\n")] == 0)
+			continue;
+
+		if (batch_csv_split(line, fields, 6) != 6) {
+			fprintf(stderr, "%zu: Expected 6 fields\n", line_no);
+			ret = 1;
+			break;
+		}
+
+		mat = elec_material_by_name(fields[0]);
+		if (!mat) {
+			/* Skip header */
+			if (line_no == 1)
+				continue;
+
+			fprintf(stderr, "%zu: Invalid material '%s'\n", line_no, fields[0]);
+			ret = 1;
+			break;
+		}
+
+		if (c->cnt >= c->size && cables_grow(c)) {
+			fprintf(stderr, "Failed to allocate memory\n");
+			ret = 1;
+			break;
+		}
+
+		length.val = atof(fields[1]);
+		area.val = atof(fields[2]);
+
+		c->material[c->cnt] = mat - elec_material;
+		c->tc[c->cnt] = mat->tc;
+		c->r_ref[c->cnt] = elec_resistance_block(mat, length, area).val;
+		c->current[c->cnt] = atof(fields[3]);
+		c->rth[c->cnt] = atof(fields[4]);
+		c->t_ambient[c->cnt] = atof(fields[5]);
+		c->cnt++;
+	}
+
+	free(line);
+
+	return ret;
+}
+
+static void selfheat_usage(void)
+{
+	printf("usage: selfheat [file]\n\n"
+	       "Reads CSV rows material,length_m,area_mm2,current_a,rth_k_w,ambient_c\n"
+	       "and prints steady state temperature, resistance and losses.\n");
+}
+
+int batch_selfheat(int argc, char *argv[])
+{
+	struct cables c = {};
+	struct elec_self_heating_arr arr;
+	unsigned char *converged = NULL;
+	unsigned int *iters = NULL;
+	double *temp = NULL, start;
+	size_t i, failed;
+	FILE *in = stdin;
+	int opt, ret = 1;
+
+	while ((opt = getopt(argc, argv, "h")) != -1) {
+		switch (opt) {
+		case 'h':
+			selfheat_usage();
+			return 0;
+		default:
+			selfheat_usage();
+			return 1;
+		}
+	}
+
+	if (optind < argc) {
+		in = fopen(argv[optind], "r");
+		if (!in) {
+			fprintf(stderr, "Failed to open '%s'\n", argv[optind]);
+			return 1;
+		}
+	}
+
+	if (cables_load(&c, in))
+		goto exit;
+
+	temp = malloc(c.cnt * sizeof(double));
+	iters = malloc(c.cnt * sizeof(unsigned int));
+	converged = malloc(c.cnt);
+
+	if (c.cnt && (!temp || !iters || !converged)) {
+		fprintf(stderr, "Failed to allocate memory\n");
+		goto exit;
+	}
+
+	start = batch_time();
+
+	arr = (struct elec_self_heating_arr) {
+		.r_ref = c.r_ref,
+		.tc = c.tc,
+		.current = c.current,
+		.rth = c.rth,
+		.t_ambient = c.t_ambient,
+		.cnt = c.cnt,
+	};
+
+	failed = elec_self_heating_batch(&arr, temp, iters, converged);
+
+	batch_report("cables", c.cnt, 0, batch_time() - start);
+
+	if (failed)
+		fprintf(stderr, "%zu cables have no steady state\n", failed);
+
+	printf("material,temp_c,resistance_ohm,power_w,iterations,converged\n");
+
+	for (i = 0; i < c.cnt; i++) {
+		double r = elec_resistance_temp(&elec_material[c.material[i]], c.r_ref[i], temp[i]);
+
+		printf("\"%s\",%g,%g,%g,%u,%u\n", elec_material[c.material[i]].name,
+		       temp[i], r, c.current[i] * c.current[i] * r,
+		       iters[i], converged[i]);
+	}
+
+	ret = 0;
+exit:
+	free(temp);
+	free(iters);
+	free(converged);
+	cables_free(&c);
+
+	if (in != stdin)
+		fclose(in);
+
+	return ret;
+}
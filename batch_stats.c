@@ -0,0 +1,200 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Streaming statistics of U, I and derived R and P over U/I sample logs.
+ *
+ * The input is split into chunks at line boundaries, each chunk is parsed
+ * and reduced into its own statistics in a separate thread and the results
+ * are merged at the end.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include "elec_batch.h"
+#include "elec_live.h"
+#include "elec_par.h"
+#include "elec_stats.h"
+#include "batch.h"
+
+#define BLOCK 1024
+
+enum quantity {
+	Q_U,
+	Q_I,
+	Q_R,
+	Q_P,
+	Q_CNT,
+};
+
+static const char *const quantity_names[Q_CNT] = {"U", "I", "R", "P"};
+
+struct chunk {
+	struct elec_stats stats[Q_CNT];
+	size_t errors;
+};
+
+struct stats_job {
+	const char *buf;
+	size_t len;
+	size_t chunks_cnt;
+	struct chunk *chunks;
+};
+
+static void flush(struct chunk *c, double *u, double *i, size_t cnt)
+{
+	double r[BLOCK], p[BLOCK];
+
+	elec_ohm_law_batch(u, i, r, p, cnt);
+
+	elec_stats_add_batch(&c->stats[Q_U], u, cnt);
+	elec_stats_add_batch(&c->stats[Q_I], i, cnt);
+	elec_stats_add_batch(&c->stats[Q_R], r, cnt);
+	elec_stats_add_batch(&c->stats[Q_P], p, cnt);
+}
+
+static void stats_chunk(struct stats_job *job, size_t idx)
+{
+	struct chunk *c = &job->chunks[idx];
+	size_t pos = batch_line_start(job->buf, job->len, idx * job->len / job->chunks_cnt);
+	size_t end = batch_line_start(job->buf, job->len, (idx + 1) * job->len / job->chunks_cnt);
+	double u[BLOCK], i[BLOCK];
+	struct elec_sample sample;
+	size_t cnt = 0, q;
+
+	for (q = 0; q < Q_CNT; q++)
+		elec_stats_init(&c->stats[q]);
+
+	c->errors = 0;
+
+	while (pos < end) {
+		const char *line = job->buf + pos;
+		const char *nl = memchr(line, '\n', end - pos);
+		size_t len = nl ? (size_t)(nl - line) : end - pos;
+
+		switch (elec_live_parse(line, len, &sample)) {
+		case 0:
+			u[cnt] = sample.u;
+			i[cnt] = sample.i;
+			if (++cnt == BLOCK) {
+				flush(c, u, i, cnt);
+				cnt = 0;
+			}
+		break;
+		case -1:
+			c->errors++;
+		break;
+		}
+
+		pos = nl ? (size_t)(nl - job->buf) + 1 : end;
+	}
+
+	flush(c, u, i, cnt);
+}
+
+static void stats_range(void *priv, size_t from, size_t to)
+{
+	size_t i;
+
+	for (i = from; i < to; i++)
+		stats_chunk(priv, i);
+}
+
+static void print_stats(const char *name, const struct elec_stats *s)
+{
+	printf("%s,%llu,%g,%g,%g,%g,%g,%g,%g\n", name, (unsigned long long)s->n,
+	       s->n ? s->mean : NAN, sqrt(elec_stats_variance(s)),
+	       s->n ? s->min : NAN,
+	       elec_stats_quantile(s, 0.5), elec_stats_quantile(s, 0.95),
+	       elec_stats_quantile(s, 0.99), s->n ? s->max : NAN);
+}
+
+static void stats_usage(void)
+{
+	printf("usage: stats [options] [file]\n\n"
+	       "Reads 'U I' sample lines and prints mean, standard deviation, min, max\n"
+	       "and quantiles of U, I, R = U/I and P = U*I. Quantiles are within %g%%.\n\n"
+	       "  -t threads   number of threads (default all CPUs)\n",
+	       100 * ELEC_SKETCH_ACCURACY);
+}
+
+int batch_stats(int argc, char *argv[])
+{
+	struct stats_job job = {};
+	unsigned int threads = 0;
+	size_t c, q, errors = 0;
+	double start;
+	int opt, mapped, ret = 1;
+	char *buf;
+
+	while ((opt = getopt(argc, argv, "ht:")) != -1) {
+		switch (opt) {
+		case 't':
+			threads = atoi(optarg);
+		break;
+		case 'h':
+			stats_usage();
+			return 0;
+		default:
+			stats_usage();
+			return 1;
+		}
+	}
+
+	if (!threads)
+		threads = elec_par_threads();
+
+	buf = batch_load(optind < argc ? argv[optind] : NULL, &job.len, &mapped, 1);
+	if (!buf) {
+		fprintf(stderr, "Failed to read input: %s\n", strerror(errno));
+		return 1;
+	}
+
+	job.buf = buf;
+	job.chunks_cnt = threads;
+	job.chunks = malloc(threads * sizeof(*job.chunks));
+	if (!job.chunks) {
+		fprintf(stderr, "Failed to allocate memory\n");
+		goto exit;
+	}
+
+	start = batch_time();
+
+	elec_par_for(job.chunks_cnt, threads, stats_range, &job);
+
+	for (c = 1; c < job.chunks_cnt; c++) {
+		for (q = 0; q < Q_CNT; q++)
+			elec_stats_merge(&job.chunks[0].stats[q], &job.chunks[c].stats[q]);
+	}
+
+	for (c = 0; c < job.chunks_cnt; c++)
+		errors += job.chunks[c].errors;
+
+	batch_report("samples", job.chunks[0].stats[Q_U].n, job.len, batch_time() - start);
+
+	if (errors)
+		fprintf(stderr, "%zu invalid lines\n", errors);
+
+	printf("quantity,n,mean,stddev,min,p50,p95,p99,max\n");
+
+	for (q = 0; q < Q_CNT; q++)
+		print_stats(quantity_names[q], &job.chunks[0].stats[q]);
+
+	ret = 0;
+exit:
+	free(job.chunks);
+
+	batch_unload(buf, job.len, mapped);
+
+	return ret;
+}
@@ -0,0 +1,523 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Generates resistance and mass tables for a cartesian product of materials,
+ * standard cross sections and lengths.
+ *
+ * The rows are computed in chunks by a pool of threads and written in order
+ * after each round, so the memory usage does not depend on the table size.
+ *
+ * The binary output is written in the elec_col columnar format with material
+ * and size label columns and length, resistance and mass columns in m, Ohms
+ * and kg, either as doubles or floats.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <math.h>
+
+#include "libelec.h"
+#include "elec_batch.h"
+#include "elec_par.h"
+#include "elec_col.h"
+#include "elec_fmt.h"
+#include "batch.h"
+
+#define CHUNK_ROWS 16384
+#define SIZE_NAME_MAX 32
+/* Worst case CSV row length without the material name */
+#define ROW_FIXED (SIZE_NAME_MAX + 3 * ELEC_FMT_MAX + 8)
+
+enum table_fmt {
+	TABLE_CSV,
+	TABLE_BIN,
+	TABLE_BIN32,
+};
+
+struct table_chunk {
+	size_t first;
+	size_t rows;
+	uint16_t *material;
+	uint16_t *size;
+	double *length;
+	double *area;
+	double *resistance;
+	double *mass;
+	char *text;
+	size_t text_len;
+};
+
+struct table {
+	enum table_fmt fmt;
+	int digits;
+
+	size_t *materials;
+	size_t materials_cnt;
+
+	struct batch_size *sizes;
+	size_t sizes_cnt;
+
+	double *lengths;
+	size_t lengths_cnt;
+
+	size_t rows;
+	/* worst case CSV row length for the selected materials */
+	size_t row_max;
+
+	struct table_chunk *chunks;
+
+	struct elec_col_writer *col;
+};
+
+static size_t csv_row(struct table *tbl, struct table_chunk *chunk,
+                      size_t i, char *buf)
+{
+	struct batch_size *size = &tbl->sizes[chunk->size[i]];
+	const char *name = elec_material[tbl->materials[chunk->material[i]]].name;
+	char size_name[SIZE_NAME_MAX];
+	size_t len;
+
+	len = snprintf(buf, tbl->row_max, "\"%s\",%s,", name,
+	               batch_size_csv(size, size_name, sizeof(size_name)));
+
+	len += elec_fmt_digits(chunk->length[i], tbl->digits, buf + len);
+	buf[len++] = ',';
+	len += elec_fmt_digits(chunk->resistance[i], tbl->digits, buf + len);
+	buf[len++] = ',';
+	len += elec_fmt_digits(chunk->mass[i], tbl->digits, buf + len);
+	buf[len++] = '\n';
+
+	return len;
+}
+
+static void compute_chunk(struct table *tbl, struct table_chunk *chunk)
+{
+	size_t per_material = tbl->sizes_cnt * tbl->lengths_cnt;
+	size_t row = chunk->first;
+	size_t m = row / per_material;
+	size_t s = (row / tbl->lengths_cnt) % tbl->sizes_cnt;
+	size_t l = row % tbl->lengths_cnt;
+	size_t i, seg_start = 0;
+
+	for (i = 0; i < chunk->rows; i++) {
+		chunk->material[i] = m;
+		chunk->size[i] = s;
+		chunk->length[i] = tbl->lengths[l];
+		chunk->area[i] = tbl->sizes[s].area;
+
+		if (++l < tbl->lengths_cnt)
+			continue;
+
+		l = 0;
+
+		if (++s < tbl->sizes_cnt)
+			continue;
+
+		s = 0;
+		m++;
+	}
+
+	/* Run the kernels on segments with the same material */
+	for (i = 1; i <= chunk->rows; i++) {
+		if (i < chunk->rows && chunk->material[i] == chunk->material[seg_start])
+			continue;
+
+		struct elec_material *mat = &elec_material[tbl->materials[chunk->material[seg_start]]];
+
+		elec_resistance_batch(mat, chunk->length + seg_start, chunk->area + seg_start,
+		                      chunk->resistance + seg_start, i - seg_start);
+		elec_mass_batch(mat, chunk->length + seg_start, chunk->area + seg_start,
+		                chunk->mass + seg_start, i - seg_start);
+
+		seg_start = i;
+	}
+
+	if (tbl->fmt != TABLE_CSV)
+		return;
+
+	chunk->text_len = 0;
+
+	for (i = 0; i < chunk->rows; i++)
+		chunk->text_len += csv_row(tbl, chunk, i, chunk->text + chunk->text_len);
+}
+
+static void compute_chunks(void *priv, size_t from, size_t to)
+{
+	struct table *tbl = priv;
+	size_t i;
+
+	for (i = from; i < to; i++)
+		compute_chunk(tbl, &tbl->chunks[i]);
+}
+
+static int write_chunk(struct table *tbl, struct table_chunk *chunk, FILE *out, size_t *bytes)
+{
+	const void *data[] = {
+		chunk->material, chunk->size, chunk->size, chunk->length, chunk->resistance,
+		chunk->mass
+	};
+
+	if (tbl->fmt == TABLE_CSV) {
+		*bytes += chunk->text_len;
+		return fwrite(chunk->text, chunk->text_len, 1, out) != 1;
+	}
+
+	return elec_col_write(tbl->col, data, chunk->rows);
+}
+
+static int write_header(struct table *tbl, FILE *out, size_t *bytes)
+{
+	enum elec_col_storage storage = tbl->fmt == TABLE_BIN32 ? ELEC_COL_F32 : ELEC_COL_F64;
+	const char *materials[ELEC_RESISTIVITY_CNT];
+	char (*labels)[32];
+	const char **sizes, **size_units;
+	struct elec_col_desc cols[] = {
+		{.name = "material", .storage = ELEC_COL_U16,
+		 .labels = materials, .labels_cnt = tbl->materials_cnt},
+		{.name = "size", .storage = ELEC_COL_U16, .labels_cnt = tbl->sizes_cnt},
+		{.name = "size_unit", .storage = ELEC_COL_U16, .labels_cnt = tbl->sizes_cnt},
+		{.name = "length", .type = ELEC_UNIT_LENGTH, .unit = ELEC_UNIT_M, .storage = storage},
+		{.name = "resistance", .type = ELEC_UNIT_RESISTANCE, .unit = ELEC_UNIT_OHM, .storage = storage},
+		{.name = "mass", .type = ELEC_UNIT_MASS, .unit = ELEC_UNIT_kG, .storage = storage},
+	};
+	size_t i;
+
+	if (tbl->fmt == TABLE_CSV) {
+		const char *csv_hdr = "material,size,size_unit,length_m,resistance_ohm,mass_kg\n";
+
+		*bytes += strlen(csv_hdr);
+		return fputs(csv_hdr, out) == EOF;
+	}
+
+	sizes = malloc(tbl->sizes_cnt * sizeof(char *));
+	size_units = malloc(tbl->sizes_cnt * sizeof(char *));
+	labels = malloc(tbl->sizes_cnt * sizeof(*labels));
+	if (!sizes || !size_units || !labels) {
+		free(sizes);
+		free(size_units);
+		free(labels);
+		return 1;
+	}
+
+	for (i = 0; i < tbl->materials_cnt; i++)
+		materials[i] = elec_material[tbl->materials[i]].name;
+
+	/* Split "1.5,mm2" into the size and size_unit labels as in the csv */
+	for (i = 0; i < tbl->sizes_cnt; i++) {
+		char *sep;
+
+		sizes[i] = batch_size_csv(&tbl->sizes[i], labels[i], sizeof(labels[i]));
+		sep = strchr(labels[i], ',');
+		*sep = 0;
+		size_units[i] = sep + 1;
+	}
+
+	cols[1].labels = sizes;
+	cols[2].labels = size_units;
+
+	tbl->col = elec_col_writer_open(out, cols, sizeof(cols)/sizeof(*cols));
+
+	free(sizes);
+	free(size_units);
+	free(labels);
+
+	return !tbl->col || tbl->col->err;
+}
+
+static int alloc_chunks(struct table *tbl, size_t cnt)
+{
+	size_t i, name_max = 0;
+
+	for (i = 0; i < tbl->materials_cnt; i++) {
+		size_t len = strlen(elec_material[tbl->materials[i]].name);
+
+		if (len > name_max)
+			name_max = len;
+	}
+
+	tbl->row_max = name_max + ROW_FIXED;
+
+	tbl->chunks = calloc(cnt, sizeof(struct table_chunk));
+	if (!tbl->chunks)
+		return 1;
+
+	for (i = 0; i < cnt; i++) {
+		struct table_chunk *c = &tbl->chunks[i];
+
+		c->material = malloc(CHUNK_ROWS * sizeof(uint16_t));
+		c->size = malloc(CHUNK_ROWS * sizeof(uint16_t));
+		c->length = malloc(CHUNK_ROWS * sizeof(double));
+		c->area = malloc(CHUNK_ROWS * sizeof(double));
+		c->resistance = malloc(CHUNK_ROWS * sizeof(double));
+		c->mass = malloc(CHUNK_ROWS * sizeof(double));
+
+		if (tbl->fmt == TABLE_CSV)
+			c->text = malloc(CHUNK_ROWS * tbl->row_max);
+
+		if (!c->material || !c->size || !c->length || !c->area ||
+		    !c->resistance || !c->mass || (tbl->fmt == TABLE_CSV && !c->text))
+			return 1;
+	}
+
+	return 0;
+}
+
+static void free_chunks(struct table *tbl, size_t cnt)
+{
+	size_t i;
+
+	if (!tbl->chunks)
+		return;
+
+	for (i = 0; i < cnt; i++) {
+		struct table_chunk *c = &tbl->chunks[i];
+
+		free(c->material);
+		free(c->size);
+		free(c->length);
+		free(c->area);
+		free(c->resistance);
+		free(c->mass);
+		free(c->text);
+	}
+
+	free(tbl->chunks);
+}
+
+static int table_run(struct table *tbl, FILE *out, unsigned int threads)
+{
+	size_t round_chunks = threads * 2;
+	size_t row = 0, bytes = 0;
+	double start = batch_time();
+	int err;
+
+	if (alloc_chunks(tbl, round_chunks)) {
+		fprintf(stderr, "Failed to allocate memory\n");
+		free_chunks(tbl, round_chunks);
+		return 1;
+	}
+
+	err = write_header(tbl, out, &bytes);
+
+	while (!err && row < tbl->rows) {
+		size_t i, cnt = 0;
+
+		for (i = 0; i < round_chunks && row < tbl->rows; i++) {
+			struct table_chunk *c = &tbl->chunks[i];
+
+			c->first = row;
+			c->rows = tbl->rows - row < CHUNK_ROWS ? tbl->rows - row : CHUNK_ROWS;
+			row += c->rows;
+			cnt++;
+		}
+
+		elec_par_for(cnt, threads, compute_chunks, tbl);
+
+		for (i = 0; i < cnt && !err; i++)
+			err = write_chunk(tbl, &tbl->chunks[i], out, &bytes);
+	}
+
+	free_chunks(tbl, round_chunks);
+
+	if (tbl->col) {
+		bytes = tbl->col->bytes;
+		err |= elec_col_writer_close(tbl->col);
+	}
+
+	if (err || fflush(out)) {
+		fprintf(stderr, "Failed to write output\n");
+		return 1;
+	}
+
+	batch_report("rows", tbl->rows, bytes, batch_time() - start);
+	fprintf(stderr, "Batch kernels: %s\n", elec_batch_isa());
+
+	return 0;
+}
+
+static int parse_grid(const char *str, double *from, double *to, size_t *cnt)
+{
+	char *end;
+
+	*from = strtod(str, &end);
+	if (*end++ != ':')
+		return 1;
+
+	*to = strtod(end, &end);
+	if (*end++ != ':')
+		return 1;
+
+	*cnt = strtoul(end, &end, 10);
+	if (*end || !*cnt)
+		return 1;
+
+	return 0;
+}
+
+static double *make_grid(double from, double to, size_t cnt, int log_scale)
+{
+	double *grid = malloc(cnt * sizeof(double));
+	size_t i;
+
+	if (!grid)
+		return NULL;
+
+	for (i = 0; i < cnt; i++) {
+		double t = cnt > 1 ? (double)i / (cnt - 1) : 0;
+
+		if (log_scale)
+			grid[i] = from * pow(to / from, t);
+		else
+			grid[i] = from + (to - from) * t;
+	}
+
+	return grid;
+}
+
+static void table_usage(void)
+{
+	printf("usage: table [options]\n\n"
+	       "  -m material  material name, may be repeated (default all)\n"
+	       "  -s sizes     metric, awg or all (default all)\n"
+	       "  -l f:t:n     length grid in m from:to:count (default 1:100:100)\n"
+	       "  -g           logarithmic length grid\n"
+	       "  -f fmt       output format csv, bin or bin32 (default csv)\n"
+	       "  -d digits    significant digits in csv (default 6)\n"
+	       "  -o file      output file (default stdout)\n"
+	       "  -t threads   number of threads\n");
+}
+
+int batch_table(int argc, char *argv[])
+{
+	struct table tbl = {.fmt = TABLE_CSV, .digits = 6};
+	size_t materials[ELEC_RESISTIVITY_CNT];
+	const char *sizes = "all", *out_path = NULL;
+	double from = 1, to = 100;
+	size_t cnt = 100;
+	unsigned int threads = 0;
+	int opt, log_scale = 0, ret;
+	FILE *out = stdout;
+
+	tbl.materials = materials;
+
+	while ((opt = getopt(argc, argv, "d:f:ghl:m:o:s:t:")) != -1) {
+		switch (opt) {
+		case 'd':
+			tbl.digits = atoi(optarg);
+			if (tbl.digits < 1 || tbl.digits > 17) {
+				fprintf(stderr, "Digits must be in 1-17\n");
+				return 1;
+			}
+		break;
+		case 'f':
+			if (!strcmp(optarg, "csv")) {
+				tbl.fmt = TABLE_CSV;
+			} else if (!strcmp(optarg, "bin")) {
+				tbl.fmt = TABLE_BIN;
+			} else if (!strcmp(optarg, "bin32")) {
+				tbl.fmt = TABLE_BIN32;
+			} else {
+				fprintf(stderr, "Invalid format '%s'\n", optarg);
+				return 1;
+			}
+		break;
+		case 'g':
+			log_scale = 1;
+		break;
+		case 'l':
+			if (parse_grid(optarg, &from, &to, &cnt)) {
+				fprintf(stderr, "Invalid length grid '%s'\n", optarg);
+				return 1;
+			}
+		break;
+		case 'm': {
+			struct elec_material *mat = elec_material_by_name(optarg);
+
+			if (!mat) {
+				fprintf(stderr, "Invalid material '%s'\n", optarg);
+				return 1;
+			}
+
+			if (tbl.materials_cnt < ELEC_RESISTIVITY_CNT)
+				materials[tbl.materials_cnt++] = mat - elec_material;
+		} break;
+		case 'o':
+			out_path = optarg;
+		break;
+		case 's':
+			sizes = optarg;
+		break;
+		case 't':
+			threads = atoi(optarg);
+			if (threads < 1 || threads > ELEC_PAR_MAX_THREADS) {
+				fprintf(stderr, "Threads must be in 1-%i\n", ELEC_PAR_MAX_THREADS);
+				return 1;
+			}
+		break;
+		case 'h':
+			table_usage();
+			return 0;
+		default:
+			table_usage();
+			return 1;
+		}
+	}
+
+	if (log_scale && (from <= 0 || to <= 0)) {
+		fprintf(stderr, "Logarithmic grid must be positive\n");
+		return 1;
+	}
+
+	if (!tbl.materials_cnt) {
+		for (tbl.materials_cnt = 0; tbl.materials_cnt < elec_material_cnt; tbl.materials_cnt++)
+			materials[tbl.materials_cnt] = tbl.materials_cnt;
+	}
+
+	tbl.sizes = batch_sizes(sizes, &tbl.sizes_cnt);
+	if (!tbl.sizes) {
+		fprintf(stderr, "Invalid sizes '%s'\n", sizes);
+		return 1;
+	}
+
+	tbl.lengths = make_grid(from, to, cnt, log_scale);
+	tbl.lengths_cnt = cnt;
+	tbl.rows = tbl.materials_cnt * tbl.sizes_cnt * tbl.lengths_cnt;
+
+	if (!tbl.lengths) {
+		fprintf(stderr, "Failed to allocate memory\n");
+		free(tbl.sizes);
+		return 1;
+	}
+
+	if (out_path) {
+		out = fopen(out_path, "wb");
+		if (!out) {
+			fprintf(stderr, "Failed to open '%s'\n", out_path);
+			free(tbl.sizes);
+			free(tbl.lengths);
+			return 1;
+		}
+	}
+
+	if (!threads)
+		threads = elec_par_threads();
+
+	ret = table_run(&tbl, out, threads);
+
+	if (out_path && fclose(out))
+		ret = 1;
+
+	free(tbl.sizes);
+	free(tbl.lengths);
+
+	return ret;
+}
@@ -0,0 +1,293 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Winding search, for each standard wire size finds the number of turns
+ * that is closest to a target resistance, the largest number of turns
+ * within a fill factor, or evaluates a fixed number of turns. Both the
+ * resistance and the fill grow with the number of turns, hence the search
+ * is a bisection over the turns that fit the bobbin window.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "libelec.h"
+#include "elec_fmt.h"
+#include "elec_winding.h"
+#include "batch.h"
+
+enum target {
+	TARGET_TURNS,
+	TARGET_RESISTANCE,
+	TARGET_FILL,
+};
+
+struct search {
+	struct elec_bobbin bobbin;
+	struct elec_material *material;
+	enum target target;
+	unsigned int turns;
+	double resistance;
+	double fill;
+};
+
+static int eval(const struct search *s, struct elec_winding *w, unsigned int turns)
+{
+	w->turns = turns;
+
+	return elec_winding_calc(&s->bobbin, s->material, w);
+}
+
+/*
+ * Returns the smallest number of turns in [1, max] for which the value is at
+ * least target, or max + 1 if there is none.
+ */
+static unsigned int bisect(const struct search *s, struct elec_winding *w,
+                           unsigned int max, double target)
+{
+	unsigned int lo = 1, hi = max + 1;
+
+	while (lo < hi) {
+		unsigned int mid = lo + (hi - lo) / 2;
+
+		eval(s, w, mid);
+
+		if ((s->target == TARGET_FILL ? w->fill : w->resistance) >= target)
+			hi = mid;
+		else
+			lo = mid + 1;
+	}
+
+	return lo;
+}
+
+static int search_size(const struct search *s, struct elec_winding *w)
+{
+	unsigned int max = elec_winding_turns_max(&s->bobbin, w);
+	unsigned int turns = 0;
+	double r_lo, r_hi;
+
+	if (!max)
+		return 1;
+
+	switch (s->target) {
+	case TARGET_TURNS:
+		if (s->turns > max)
+			return 1;
+
+		turns = s->turns;
+	break;
+	case TARGET_FILL:
+		turns = bisect(s, w, max, s->fill);
+
+		/* Fill is exceeded for turns, unless it was exactly hit */
+		if (turns > max || (!eval(s, w, turns) && w->fill > s->fill))
+			turns--;
+
+		if (!turns)
+			return 1;
+	break;
+	case TARGET_RESISTANCE:
+		turns = bisect(s, w, max, s->resistance);
+
+		/* Target not reachable within the window */
+		if (turns > max)
+			return 1;
+
+		/* Pick the closer of turns and turns - 1 */
+		if (turns > 1) {
+			eval(s, w, turns);
+			r_hi = w->resistance;
+			eval(s, w, turns - 1);
+			r_lo = w->resistance;
+
+			if (s->resistance - r_lo < r_hi - s->resistance)
+				turns--;
+		}
+	break;
+	}
+
+	return eval(s, w, turns) || !w->fits;
+}
+
+static void print_num(double val)
+{
+	char buf[ELEC_FMT_MAX];
+
+	elec_fmt_digits(val, 6, buf);
+	printf(",%s", buf);
+}
+
+static void print_winding(const struct batch_size *size, const struct elec_winding *w)
+{
+	char buf[32];
+
+	printf("%s", batch_size_csv(size, buf, sizeof(buf)));
+	print_num(w->diameter * 1e3);
+	printf(",%u,%u,%u", w->turns, w->turns_per_layer, w->layers);
+	print_num(w->build * 1e3);
+	print_num(w->length);
+	print_num(w->resistance);
+	print_num(w->mass);
+	print_num(w->fill);
+	printf("\n");
+}
+
+static int parse_core(struct elec_bobbin *bobbin, const char *str)
+{
+	char *end;
+
+	bobbin->core_width = strtod(str, &end) * 1e-3;
+	bobbin->core_depth = 0;
+
+	if (*end == 'x')
+		bobbin->core_depth = strtod(end + 1, &end) * 1e-3;
+
+	return *end || !(bobbin->core_width > 0) || !(bobbin->core_depth >= 0);
+}
+
+static void winding_usage(void)
+{
+	printf("usage: winding [options]\n\n"
+	       "Finds turns for each wire size that fit a bobbin and meet a target.\n\n"
+	       "  -w width     winding window width in mm\n"
+	       "  -H height    winding window height in mm\n"
+	       "  -c core      round core diameter or rectangular core WxD in mm\n"
+	       "  -i mm        interlayer insulation in mm (default 0)\n"
+	       "  -e mm        wire insulation added to diameter in mm (default 0.05)\n"
+	       "  -m material  wire material (default copper)\n"
+	       "  -s sizes     metric, awg or all (default all)\n"
+	       "  -n turns     evaluate a fixed number of turns\n"
+	       "  -r ohm       find turns closest to a resistance\n"
+	       "  -f fill      find most turns within a copper fill factor\n");
+}
+
+int batch_winding(int argc, char *argv[])
+{
+	struct search s = {.material = elec_material_by_name("copper")};
+	const char *which = "all";
+	struct batch_size *sizes;
+	size_t i, cnt, found = 0;
+	double insulation = 0.05, start;
+	int opt, targets = 0;
+
+	while ((opt = getopt(argc, argv, "c:e:f:hH:i:m:n:r:s:w:")) != -1) {
+		switch (opt) {
+		case 'c':
+			if (parse_core(&s.bobbin, optarg)) {
+				fprintf(stderr, "Invalid core '%s'\n", optarg);
+				return 1;
+			}
+		break;
+		case 'e':
+			insulation = atof(optarg);
+		break;
+		case 'f':
+			s.target = TARGET_FILL;
+			s.fill = atof(optarg);
+			targets++;
+		break;
+		case 'H':
+			s.bobbin.height = atof(optarg) * 1e-3;
+		break;
+		case 'i':
+			s.bobbin.layer_insulation = atof(optarg) * 1e-3;
+		break;
+		case 'm':
+			s.material = elec_material_by_name(optarg);
+			if (!s.material) {
+				fprintf(stderr, "Invalid material '%s'\n", optarg);
+				return 1;
+			}
+		break;
+		case 'n':
+			s.target = TARGET_TURNS;
+			s.turns = atoi(optarg);
+			targets++;
+		break;
+		case 'r':
+			s.target = TARGET_RESISTANCE;
+			s.resistance = atof(optarg);
+			targets++;
+		break;
+		case 's':
+			which = optarg;
+		break;
+		case 'w':
+			s.bobbin.width = atof(optarg) * 1e-3;
+		break;
+		case 'h':
+			winding_usage();
+			return 0;
+		default:
+			winding_usage();
+			return 1;
+		}
+	}
+
+	if (!(s.bobbin.width > 0) || !(s.bobbin.height > 0) || !(s.bobbin.core_width > 0)) {
+		fprintf(stderr, "Bobbin width, height and core have to be set\n");
+		return 1;
+	}
+
+	if (targets != 1 || (s.target == TARGET_TURNS && !s.turns) ||
+	    (s.target == TARGET_FILL && !(s.fill > 0)) ||
+	    (s.target == TARGET_RESISTANCE && !(s.resistance > 0))) {
+		fprintf(stderr, "Exactly one of positive -n, -r and -f has to be set\n");
+		return 1;
+	}
+
+	if (!(insulation >= 0)) {
+		fprintf(stderr, "Insulation must not be negative\n");
+		return 1;
+	}
+
+	sizes = batch_sizes(which, &cnt);
+	if (!sizes) {
+		fprintf(stderr, "Invalid sizes '%s'\n", which);
+		return 1;
+	}
+
+	start = batch_time();
+
+	printf("size,size_unit,diameter_mm,turns,turns_per_layer,layers,build_mm,"
+	       "length_m,resistance_ohm,mass_kg,fill\n");
+
+	for (i = 0; i < cnt; i++) {
+		struct elec_val diameter = {
+			.type = ELEC_UNIT_AREA,
+			.unit = ELEC_UNIT_M2,
+			.val = sizes[i].area,
+		};
+		struct elec_winding w = {};
+
+		elec_circle_diameter(&diameter, ELEC_UNIT_M);
+
+		w.diameter = diameter.val;
+		w.outer_diameter = diameter.val + insulation * 1e-3;
+
+		if (search_size(&s, &w))
+			continue;
+
+		print_winding(&sizes[i], &w);
+		found++;
+	}
+
+	batch_report("sizes", cnt, 0, batch_time() - start);
+
+	if (!found)
+		fprintf(stderr, "No wire size fits the bobbin and the target\n");
+
+	free(sizes);
+
+	return 0;
+}
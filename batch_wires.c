@@ -0,0 +1,472 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Resistance and mass of wires from a CSV wire list:
+ *
+ * material,length_m,area_mm2
+ *
+ * The input is mapped into memory and split into chunks at line boundaries.
+ * Each round a pool of threads parses the chunks in place, sorts the rows by
+ * material, runs the batch kernels and formats the output, which is then
+ * written in the input order.
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "libelec.h"
+#include "elec_batch.h"
+#include "elec_fmt.h"
+#include "elec_par.h"
+#include "elec_parse.h"
+#include "batch.h"
+
+#define CHUNK_BYTES (4 << 20)
+/* Worst case output row length */
+#define ROW_MAX (64 + 5 * ELEC_FMT_MAX)
+
+struct wires_chunk {
+	size_t start;
+	size_t end;
+
+	size_t rows;
+	size_t size;
+	uint16_t *material;
+	double *length;
+	double *area;
+	double *resistance;
+	double *mass;
+	/* rows sorted by material and the sorted arrays */
+	size_t *order;
+	double *s_length;
+	double *s_area;
+	double *s_resistance;
+	double *s_mass;
+
+	size_t errors;
+
+	char *text;
+	size_t text_size;
+	size_t text_len;
+};
+
+struct wires {
+	const char *buf;
+	size_t len;
+	int digits;
+	int quiet;
+	struct wires_chunk *chunks;
+};
+
+#define CHUNK_ARRAYS 8
+
+static int chunk_grow(struct wires_chunk *c)
+{
+	size_t size = c->size ? 2 * c->size : 65536;
+	double **arrs[CHUNK_ARRAYS] = {
+		&c->length, &c->area, &c->resistance, &c->mass,
+		&c->s_length, &c->s_area, &c->s_resistance, &c->s_mass,
+	};
+	uint16_t *material;
+	size_t *order;
+	unsigned int i;
+
+	for (i = 0; i < CHUNK_ARRAYS; i++) {
+		double *tmp = realloc(*arrs[i], size * sizeof(double));
+
+		if (!tmp)
+			return 1;
+
+		*arrs[i] = tmp;
+	}
+
+	material = realloc(c->material, size * sizeof(*material));
+	if (!material)
+		return 1;
+
+	c->material = material;
+
+	order = realloc(c->order, size * sizeof(*order));
+	if (!order)
+		return 1;
+
+	c->order = order;
+	c->size = size;
+
+	return 0;
+}
+
+static void chunk_free(struct wires_chunk *c)
+{
+	free(c->material);
+	free(c->length);
+	free(c->area);
+	free(c->resistance);
+	free(c->mass);
+	free(c->order);
+	free(c->s_length);
+	free(c->s_area);
+	free(c->s_resistance);
+	free(c->s_mass);
+	free(c->text);
+}
+
+static int material_lookup(const char *name, size_t len, int *last)
+{
+	size_t i;
+
+	if (*last >= 0 && !strncmp(elec_material[*last].name, name, len) &&
+	    !elec_material[*last].name[len])
+		return *last;
+
+	for (i = 0; i < elec_material_cnt; i++) {
+		if (!strncmp(elec_material[i].name, name, len) && !elec_material[i].name[len]) {
+			*last = i;
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+static const char *skip_space(const char *p)
+{
+	while (*p == ' ' || *p == '\t' || *p == '\r')
+		p++;
+
+	return p;
+}
+
+/*
+ * Parses a line, returns 0 on success, 1 for empty lines and comments and -1
+ * for invalid lines.
+ */
+static int parse_line(const char *line, const char *end, int *last,
+                      int *mat, double *length, double *area)
+{
+	const char *name = line, *p, *num;
+	size_t name_len;
+
+	if (*line == '#' || *line == '\n' || *line == '\r')
+		return 1;
+
+	if (*name == '"') {
+		name++;
+		p = memchr(name, '"', end - name);
+		if (!p)
+			return -1;
+
+		name_len = p++ - name;
+	} else {
+		p = elec_parse_scan(name, end, ',');
+		name_len = p - name;
+	}
+
+	if (p >= end || *p++ != ',')
+		return -1;
+
+	*mat = material_lookup(name, name_len, last);
+	if (*mat < 0)
+		return -1;
+
+	num = p;
+	*length = elec_parse_double(num, &p);
+	p = skip_space(p);
+	if (p == num || *p++ != ',')
+		return -1;
+
+	num = p;
+	*area = elec_parse_double(num, &p);
+	if (p == num)
+		return -1;
+
+	p = skip_space(p);
+
+	if (p < end && *p != '\n')
+		return -1;
+
+	if (!(*length >= 0) || !(*area > 0))
+		return -1;
+
+	return 0;
+}
+
+static void parse_chunk(struct wires *w, struct wires_chunk *c)
+{
+	size_t pos = c->start;
+	int last = -1;
+
+	c->rows = 0;
+	c->errors = 0;
+
+	while (pos < c->end) {
+		const char *line = w->buf + pos;
+		const char *nl = memchr(line, '\n', c->end - pos);
+		const char *line_end = nl ? nl : w->buf + c->end;
+		double length, area;
+		int mat;
+
+		switch (parse_line(line, line_end, &last, &mat, &length, &area)) {
+		case 0:
+			if (c->rows >= c->size && chunk_grow(c)) {
+				c->errors++;
+				break;
+			}
+
+			c->material[c->rows] = mat;
+			c->length[c->rows] = length;
+			c->area[c->rows] = area * 1e-6;
+			c->rows++;
+		break;
+		case -1:
+			/* Header line */
+			if (pos)
+				c->errors++;
+		break;
+		}
+
+		pos = line_end - w->buf + 1;
+	}
+}
+
+/*
+ * Counting sort of rows by material so that each material is a single
+ * kernel call.
+ */
+static void compute_chunk(struct wires_chunk *c)
+{
+	size_t first[ELEC_RESISTIVITY_CNT + 1] = {};
+	size_t i, m, pos;
+
+	if (!c->rows)
+		return;
+
+	for (i = 0; i < c->rows; i++)
+		first[c->material[i] + 1]++;
+
+	/* Single material, no need to sort */
+	if (first[c->material[0] + 1] == c->rows) {
+		struct elec_material *mat = &elec_material[c->material[0]];
+
+		elec_resistance_batch(mat, c->length, c->area, c->resistance, c->rows);
+		elec_mass_batch(mat, c->length, c->area, c->mass, c->rows);
+		return;
+	}
+
+	for (m = 1; m <= elec_material_cnt; m++)
+		first[m] += first[m - 1];
+
+	for (i = 0; i < c->rows; i++)
+		c->order[first[c->material[i]]++] = i;
+
+	for (i = 0; i < c->rows; i++) {
+		c->s_length[i] = c->length[c->order[i]];
+		c->s_area[i] = c->area[c->order[i]];
+	}
+
+	/* first[m] is now the end of material m */
+	for (pos = 0, m = 0; m < elec_material_cnt; pos = first[m++]) {
+		size_t cnt = first[m] - pos;
+
+		if (!cnt)
+			continue;
+
+		elec_resistance_batch(&elec_material[m], c->s_length + pos, c->s_area + pos,
+		                      c->s_resistance + pos, cnt);
+		elec_mass_batch(&elec_material[m], c->s_length + pos, c->s_area + pos,
+		                c->s_mass + pos, cnt);
+	}
+
+	for (i = 0; i < c->rows; i++) {
+		c->resistance[c->order[i]] = c->s_resistance[i];
+		c->mass[c->order[i]] = c->s_mass[i];
+	}
+}
+
+static void format_chunk(struct wires *w, struct wires_chunk *c)
+{
+	size_t i, len = 0;
+
+	c->text_len = 0;
+
+	if (c->text_size < c->rows * ROW_MAX) {
+		char *text = realloc(c->text, c->rows * ROW_MAX);
+
+		if (!text) {
+			c->errors += c->rows;
+			return;
+		}
+
+		c->text = text;
+		c->text_size = c->rows * ROW_MAX;
+	}
+
+	for (i = 0; i < c->rows; i++) {
+		char *buf = c->text + len;
+		const char *name = elec_material[c->material[i]].name;
+		size_t name_len = strlen(name);
+		size_t l = 0;
+
+		buf[l++] = '"';
+		memcpy(buf + l, name, name_len);
+		l += name_len;
+		buf[l++] = '"';
+		buf[l++] = ',';
+		l += elec_fmt_digits(c->length[i], w->digits, buf + l);
+		buf[l++] = ',';
+		l += elec_fmt_digits(c->area[i] * 1e6, w->digits, buf + l);
+		buf[l++] = ',';
+		l += elec_fmt_digits(c->resistance[i], w->digits, buf + l);
+		buf[l++] = ',';
+		l += elec_fmt_digits(c->mass[i], w->digits, buf + l);
+		buf[l++] = '\n';
+
+		len += l;
+	}
+
+	c->text_len = len;
+}
+
+static void process_chunks(void *priv, size_t from, size_t to)
+{
+	struct wires *w = priv;
+	size_t i;
+
+	for (i = from; i < to; i++) {
+		struct wires_chunk *c = &w->chunks[i];
+
+		parse_chunk(w, c);
+		compute_chunk(c);
+
+		if (!w->quiet)
+			format_chunk(w, c);
+	}
+}
+
+static int wires_run(struct wires *w, FILE *out, unsigned int threads)
+{
+	size_t round_chunks = 2 * threads;
+	size_t pos = 0, rows = 0, errors = 0, i;
+	double start = batch_time();
+	int err = 0;
+
+	w->chunks = calloc(round_chunks, sizeof(*w->chunks));
+	if (!w->chunks) {
+		fprintf(stderr, "Failed to allocate memory\n");
+		return 1;
+	}
+
+	if (!w->quiet)
+		err = fputs("material,length_m,area_mm2,resistance_ohm,mass_kg\n", out) == EOF;
+
+	while (!err && pos < w->len) {
+		size_t cnt = 0;
+
+		for (i = 0; i < round_chunks && pos < w->len; i++) {
+			struct wires_chunk *c = &w->chunks[i];
+
+			c->start = pos;
+			c->end = w->len - pos > CHUNK_BYTES ?
+			         batch_line_start(w->buf, w->len, pos + CHUNK_BYTES) : w->len;
+			pos = c->end;
+			cnt++;
+		}
+
+		elec_par_for(cnt, threads, process_chunks, w);
+
+		for (i = 0; i < cnt; i++) {
+			struct wires_chunk *c = &w->chunks[i];
+
+			rows += c->rows;
+			errors += c->errors;
+
+			if (!w->quiet && !err && c->text_len)
+				err = fwrite(c->text, c->text_len, 1, out) != 1;
+		}
+	}
+
+	for (i = 0; i < round_chunks; i++)
+		chunk_free(&w->chunks[i]);
+
+	free(w->chunks);
+
+	if (err || fflush(out)) {
+		fprintf(stderr, "Failed to write output\n");
+		return 1;
+	}
+
+	batch_report("wires", rows, w->len, batch_time() - start);
+	fprintf(stderr, "Batch kernels: %s\n", elec_batch_isa());
+
+	if (errors)
+		fprintf(stderr, "%zu invalid lines\n", errors);
+
+	return 0;
+}
+
+static void wires_usage(void)
+{
+	printf("usage: wires [options] [file]\n\n"
+	       "Reads CSV rows material,length_m,area_mm2 and prints resistance and mass.\n\n"
+	       "  -d digits    significant digits (default 6)\n"
+	       "  -q           no output, just parse, compute and report throughput\n"
+	       "  -t threads   number of threads (default all CPUs)\n");
+}
+
+int batch_wires(int argc, char *argv[])
+{
+	struct wires w = {.digits = 6};
+	unsigned int threads = 0;
+	int opt, mapped, ret;
+	char *buf;
+
+	while ((opt = getopt(argc, argv, "d:hqt:")) != -1) {
+		switch (opt) {
+		case 'd':
+			w.digits = atoi(optarg);
+			if (w.digits < 1 || w.digits > 17) {
+				fprintf(stderr, "Digits must be in 1-17\n");
+				return 1;
+			}
+		break;
+		case 'q':
+			w.quiet = 1;
+		break;
+		case 't':
+			threads = atoi(optarg);
+		break;
+		case 'h':
+			wires_usage();
+			return 0;
+		default:
+			wires_usage();
+			return 1;
+		}
+	}
+
+	if (!threads)
+		threads = elec_par_threads();
+
+	buf = batch_load(optind < argc ? argv[optind] : NULL, &w.len, &mapped, 1);
+	if (!buf) {
+		fprintf(stderr, "Failed to read input: %s\n", strerror(errno));
+		return 1;
+	}
+
+	w.buf = buf;
+
+	ret = wires_run(&w, stdout, threads);
+
+	batch_unload(buf, w.len, mapped);
+
+	return ret;
+}
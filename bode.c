@@ -0,0 +1,372 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#include <math.h>
+#include <string.h>
+#include <widgets/gp_widgets.h>
+#include "bode.h"
+#include "libelec.h"
+#include "elec_ac.h"
+#include "elec_filter.h"
+#include "elec_decimate.h"
+#include "elec_fmt.h"
+
+/* Lowest magnitude shown in the plot */
+#define MAG_FLOOR -160
+
+static struct bode_ui {
+	gp_widget *filter;
+	gp_widget *r;
+	gp_widget *r_unit;
+	gp_widget *l;
+	gp_widget *l_unit;
+	gp_widget *c;
+	gp_widget *c_unit;
+	gp_widget *f_min;
+	gp_widget *f_max;
+	gp_widget *points;
+
+	gp_widget *plot;
+	gp_widget *res_f0;
+	gp_widget *res_q;
+
+	/* full resolution sweep */
+	size_t cnt;
+	double f_lo;
+	double f_hi;
+	double *freq;
+	double *mag;
+	double *phase;
+
+	/* sweep decimated to the plot width, recomputed on resize */
+	size_t cols;
+	struct elec_decimated *mag_dec;
+	struct elec_decimated *phase_dec;
+} bode_ui;
+
+const gp_widget_choice_desc bode_filter_desc = {
+	.ops = &gp_widget_choice_arr_ops,
+	.arr = &(gp_widget_choice_arr) {
+		.ptr = elec_filter_names,
+		.memb_cnt = ELEC_FILTER_CNT,
+		.memb_size = sizeof(const char *),
+		.memb_off = 0,
+	}
+};
+
+static double get_val(gp_widget *tbox, gp_widget *unit, enum elec_unit type, elec_unit unit_to)
+{
+	struct elec_val val = {
+		.val = atof(gp_widget_tbox_text(tbox)),
+		.unit = gp_widget_choice_sel_get(unit),
+		.type = type,
+	};
+
+	elec_unit_convert(&val, unit_to);
+
+	return val.val;
+}
+
+static int sweep_alloc(struct bode_ui *ui, size_t cnt)
+{
+	double *tmp;
+
+	if (ui->cnt == cnt)
+		return 0;
+
+	tmp = realloc(ui->freq, 3 * cnt * sizeof(double));
+	if (!tmp)
+		return 1;
+
+	ui->freq = tmp;
+	ui->mag = tmp + cnt;
+	ui->phase = tmp + 2 * cnt;
+	ui->cnt = cnt;
+
+	return 0;
+}
+
+static void decimate(struct bode_ui *ui, size_t cols)
+{
+	struct elec_decimated *tmp;
+
+	if (cols > ui->cnt)
+		cols = ui->cnt;
+
+	if (ui->cols == cols)
+		return;
+
+	tmp = realloc(ui->mag_dec, 2 * cols * sizeof(*tmp));
+	if (!tmp) {
+		ui->cols = 0;
+		return;
+	}
+
+	ui->mag_dec = tmp;
+	ui->phase_dec = tmp + cols;
+	ui->cols = cols;
+
+	elec_decimate(ui->mag, ui->cnt, ui->mag_dec, cols);
+	elec_decimate(ui->phase, ui->cnt, ui->phase_dec, cols);
+}
+
+static void recalc_bode(struct bode_ui *ui)
+{
+	struct elec_filter filter = {
+		.type = gp_widget_choice_sel_get(ui->filter),
+		.r = get_val(ui->r, ui->r_unit, ELEC_UNIT_RESISTANCE, ELEC_UNIT_OHM),
+		.l = get_val(ui->l, ui->l_unit, ELEC_UNIT_INDUCTANCE, ELEC_UNIT_H),
+		.c = get_val(ui->c, ui->c_unit, ELEC_UNIT_CAPACITANCE, ELEC_UNIT_F),
+	};
+	double f_lo = atof(gp_widget_tbox_text(ui->f_min));
+	double f_hi = atof(gp_widget_tbox_text(ui->f_max));
+	size_t cnt = pow(10, 3 + gp_widget_choice_sel_get(ui->points));
+	double f0 = elec_filter_f0(&filter);
+	double q = elec_filter_q(&filter);
+	char buf[64];
+
+	if (isfinite(f0) && f0 > 0) {
+		elec_fmt_si(f0, 6, "Hz", buf, sizeof(buf));
+		gp_widget_label_set(ui->res_f0, buf);
+	} else
+		gp_widget_label_set(ui->res_f0, "---");
+
+	if (isfinite(q)) {
+		elec_fmt_digits(q, 6, buf);
+		gp_widget_label_set(ui->res_q, buf);
+	} else {
+		gp_widget_label_set(ui->res_q, "---");
+	}
+
+	if (!(f_lo > 0) || !(f_hi > f_lo) || !isfinite(f0) || !(f0 > 0) ||
+	    sweep_alloc(ui, cnt)) {
+		ui->cols = 0;
+		ui->f_hi = 0;
+		gp_widget_redraw(ui->plot);
+		return;
+	}
+
+	ui->f_lo = f_lo;
+	ui->f_hi = f_hi;
+
+	elec_log_sweep(f_lo, f_hi, ui->freq, cnt);
+	elec_filter_response(&filter, ui->freq, ui->mag, ui->phase, cnt);
+
+	/* Force decimation on next redraw */
+	ui->cols = 0;
+
+	gp_widget_redraw(ui->plot);
+}
+
+static gp_coord val_to_y(double val, double min, double max, gp_coord y0, gp_size h)
+{
+	if (val < min)
+		val = min;
+
+	if (val > max)
+		val = max;
+
+	return y0 + (h - 1) - (gp_coord)((val - min) / (max - min) * (h - 1) + 0.5);
+}
+
+static gp_coord bucket_to_x(struct bode_ui *ui, size_t b, gp_size w)
+{
+	size_t from = elec_decimate_start(ui->cnt, ui->cols, b);
+	size_t to = elec_decimate_start(ui->cnt, ui->cols, b + 1);
+	double mid = (from + to - 1) / 2.0;
+
+	if (ui->cnt < 2)
+		return 0;
+
+	return mid / (ui->cnt - 1) * (w - 1) + 0.5;
+}
+
+static void draw_pane(struct bode_ui *ui, gp_pixmap *pixmap, const struct elec_decimated *dec,
+                      double min, double max, gp_coord y0, gp_size h, gp_pixel color)
+{
+	gp_size w = pixmap->w;
+	gp_coord px = 0, py = 0;
+	size_t b;
+
+	for (b = 0; b < ui->cols; b++) {
+		gp_coord x = bucket_to_x(ui, b, w);
+		gp_coord y_min = val_to_y(dec[b].min, min, max, y0, h);
+		gp_coord y_max = val_to_y(dec[b].max, min, max, y0, h);
+		gp_coord y = val_to_y(dec[b].mean, min, max, y0, h);
+
+		if (b)
+			gp_line(pixmap, px, py, x, y, color);
+
+		gp_vline_xyy(pixmap, x, y_min, y_max, color);
+
+		px = x;
+		py = y;
+	}
+}
+
+static void draw_grid(struct bode_ui *ui, const gp_widget_render_ctx *ctx, gp_pixmap *pixmap,
+                      double mag_min, double mag_max, gp_size h)
+{
+	double decades = log10(ui->f_hi / ui->f_lo);
+	double d;
+	gp_size w = pixmap->w;
+	char buf[64];
+
+	for (d = ceil(log10(ui->f_lo)); d <= log10(ui->f_hi); d++) {
+		gp_coord x = (d - log10(ui->f_lo)) / decades * (w - 1) + 0.5;
+
+		gp_vline_xyy(pixmap, x, 0, pixmap->h - 1, ctx->col_disabled);
+		elec_fmt_si(pow(10, d), 0, "Hz", buf, sizeof(buf));
+		gp_text(pixmap, ctx->font, x + 2, pixmap->h - 1, GP_ALIGN_RIGHT | GP_VALIGN_ABOVE,
+		        ctx->text_color, ctx->bg_color, buf);
+	}
+
+	for (d = ceil(mag_min / 20) * 20; d <= mag_max; d += 20) {
+		gp_coord y = val_to_y(d, mag_min, mag_max, 0, h);
+
+		gp_hline_xxy(pixmap, 0, w - 1, y, ctx->col_disabled);
+		elec_fmt_digits(d, 6, buf);
+		strcat(buf, " dB");
+		gp_text(pixmap, ctx->font, 2, y, GP_ALIGN_RIGHT | GP_VALIGN_BELOW,
+		        ctx->text_color, ctx->bg_color, buf);
+	}
+
+	for (d = -180; d <= 180; d += 90) {
+		gp_coord y = val_to_y(d, -180, 180, h, h);
+
+		gp_hline_xxy(pixmap, 0, w - 1, y, ctx->col_disabled);
+		elec_fmt_digits(d, 6, buf);
+		strcat(buf, "°");
+		gp_text(pixmap, ctx->font, 2, y, GP_ALIGN_RIGHT | GP_VALIGN_BELOW,
+		        ctx->text_color, ctx->bg_color, buf);
+	}
+
+	gp_hline_xxy(pixmap, 0, w - 1, h, ctx->text_color);
+}
+
+static void draw_plot(struct bode_ui *ui, const gp_widget_render_ctx *ctx, gp_pixmap *pixmap)
+{
+	gp_size h = pixmap->h / 2;
+	double mag_min, mag_max;
+	size_t b;
+
+	gp_fill(pixmap, ctx->bg_color);
+
+	if (!ui->f_hi || pixmap->w < 2 || h < 2)
+		return;
+
+	decimate(ui, pixmap->w);
+	if (!ui->cols)
+		return;
+
+	mag_min = mag_max = ui->mag_dec[0].max;
+
+	for (b = 0; b < ui->cols; b++) {
+		if (ui->mag_dec[b].min < mag_min)
+			mag_min = ui->mag_dec[b].min;
+		if (ui->mag_dec[b].max > mag_max)
+			mag_max = ui->mag_dec[b].max;
+	}
+
+	mag_max = ceil(mag_max / 10) * 10 + 10;
+	mag_min = floor(mag_min / 10) * 10 - 10;
+
+	if (mag_min < MAG_FLOOR)
+		mag_min = MAG_FLOOR;
+
+	draw_grid(ui, ctx, pixmap, mag_min, mag_max, h);
+	draw_pane(ui, pixmap, ui->mag_dec, mag_min, mag_max, 0, h, ctx->hl_color);
+	draw_pane(ui, pixmap, ui->phase_dec, -180, 180, h, pixmap->h - h, ctx->warn_color);
+}
+
+static int plot_on_event(gp_widget_event *ev)
+{
+	struct bode_ui *ui = ev->self->priv;
+
+	switch (ev->type) {
+	case GP_WIDGET_EVENT_REDRAW:
+		draw_plot(ui, ev->ctx, ev->self->pixmap->pixmap);
+		return 1;
+	case GP_WIDGET_EVENT_RESIZE:
+		ui->cols = 0;
+		return 1;
+	}
+
+	return 0;
+}
+
+static int tbox_number_callback(gp_widget_event *ev)
+{
+	if (ev->type != GP_WIDGET_EVENT_WIDGET)
+		return 0;
+
+	struct bode_ui *ui = ev->self->priv;
+	const char *text = gp_widget_tbox_text(ev->self);
+	char *end;
+
+	switch (ev->sub_type) {
+	case GP_WIDGET_TBOX_POST_FILTER:
+		strtod(text, &end);
+		if (*end)
+			return 1;
+		return 0;
+	break;
+	case GP_WIDGET_TBOX_EDIT:
+		recalc_bode(ui);
+	break;
+	}
+
+	return 0;
+}
+
+static int params_callback(gp_widget_event *ev)
+{
+	if (ev->type != GP_WIDGET_EVENT_WIDGET)
+		return 0;
+
+	recalc_bode(ev->self->priv);
+
+	return 0;
+}
+
+void bode_init(gp_htable *uids)
+{
+	bode_ui.r = gp_widget_by_uid(uids, "bode_r", GP_WIDGET_TBOX);
+	bode_ui.l = gp_widget_by_uid(uids, "bode_l", GP_WIDGET_TBOX);
+	bode_ui.c = gp_widget_by_uid(uids, "bode_c", GP_WIDGET_TBOX);
+	bode_ui.f_min = gp_widget_by_uid(uids, "bode_fmin", GP_WIDGET_TBOX);
+	bode_ui.f_max = gp_widget_by_uid(uids, "bode_fmax", GP_WIDGET_TBOX);
+
+	gp_widget_on_event_set(bode_ui.r, tbox_number_callback, &bode_ui);
+	gp_widget_on_event_set(bode_ui.l, tbox_number_callback, &bode_ui);
+	gp_widget_on_event_set(bode_ui.c, tbox_number_callback, &bode_ui);
+	gp_widget_on_event_set(bode_ui.f_min, tbox_number_callback, &bode_ui);
+	gp_widget_on_event_set(bode_ui.f_max, tbox_number_callback, &bode_ui);
+
+	bode_ui.filter = gp_widget_by_cuid(uids, "bode_filter", GP_WIDGET_CLASS_CHOICE);
+	bode_ui.r_unit = gp_widget_by_cuid(uids, "bode_r_unit", GP_WIDGET_CLASS_CHOICE);
+	bode_ui.l_unit = gp_widget_by_cuid(uids, "bode_l_unit", GP_WIDGET_CLASS_CHOICE);
+	bode_ui.c_unit = gp_widget_by_cuid(uids, "bode_c_unit", GP_WIDGET_CLASS_CHOICE);
+	bode_ui.points = gp_widget_by_cuid(uids, "bode_points", GP_WIDGET_CLASS_CHOICE);
+
+	gp_widget_on_event_set(bode_ui.filter, params_callback, &bode_ui);
+	gp_widget_on_event_set(bode_ui.r_unit, params_callback, &bode_ui);
+	gp_widget_on_event_set(bode_ui.l_unit, params_callback, &bode_ui);
+	gp_widget_on_event_set(bode_ui.c_unit, params_callback, &bode_ui);
+	gp_widget_on_event_set(bode_ui.points, params_callback, &bode_ui);
+
+	bode_ui.res_f0 = gp_widget_by_uid(uids, "bode_f0", GP_WIDGET_LABEL);
+	bode_ui.res_q = gp_widget_by_uid(uids, "bode_q", GP_WIDGET_LABEL);
+
+	bode_ui.plot = gp_widget_by_uid(uids, "bode_plot", GP_WIDGET_PIXMAP);
+	gp_widget_on_event_set(bode_ui.plot, plot_on_event, &bode_ui);
+	gp_widget_events_unmask(bode_ui.plot, GP_WIDGET_EVENT_REDRAW);
+	gp_widget_events_unmask(bode_ui.plot, GP_WIDGET_EVENT_RESIZE);
+
+	recalc_bode(&bode_ui);
+}
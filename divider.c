@@ -0,0 +1,170 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#include <string.h>
+#include <widgets/gp_widgets.h>
+#include "divider.h"
+#include "libelec.h"
+#include "elec_fmt.h"
+#include "elec_divider.h"
+
+#define DIVIDER_RESULTS 5
+
+static struct divider_ui {
+	gp_widget *vin;
+	gp_widget *vout;
+	gp_widget *imax;
+	gp_widget *vin_unit;
+	gp_widget *vout_unit;
+	gp_widget *imax_unit;
+	gp_widget *series;
+	gp_widget *three;
+	gp_widget *res[DIVIDER_RESULTS];
+} divider_ui;
+
+static double get_val(gp_widget *tbox, gp_widget *unit, enum elec_unit type, elec_unit unit_to)
+{
+	struct elec_val val = {
+		.val = atof(gp_widget_tbox_text(tbox)),
+		.unit = gp_widget_choice_sel_get(unit),
+		.type = type,
+	};
+
+	elec_unit_convert(&val, unit_to);
+
+	return val.val;
+}
+
+static const char *r_str(double r, char *buf, size_t buf_len)
+{
+	elec_fmt_si(r, 0, "\u03a9", buf, buf_len);
+
+	return buf;
+}
+
+static const char *rs_str(double r1, double r2, char *buf, size_t buf_len)
+{
+	char tmp[2][32];
+
+	if (!r2)
+		return r_str(r1, buf, buf_len);
+
+	snprintf(buf, buf_len, "%s + %s",
+	         r_str(r1, tmp[0], sizeof(tmp[0])),
+	         r_str(r2, tmp[1], sizeof(tmp[1])));
+
+	return buf;
+}
+
+static void recalc_divider(struct divider_ui *ui)
+{
+	struct elec_divider res[DIVIDER_RESULTS];
+	size_t imax_unit = gp_widget_choice_sel_get(ui->imax_unit);
+	double vin = get_val(ui->vin, ui->vin_unit, ELEC_UNIT_VOLTAGE, ELEC_UNIT_V);
+	double vout = get_val(ui->vout, ui->vout_unit, ELEC_UNIT_VOLTAGE, ELEC_UNIT_V);
+	struct elec_divider_params params = {
+		.series = gp_widget_choice_sel_get(ui->series),
+		.r_min = 100,
+		.r_max = 10000000,
+		.ratio = vout / vin,
+		.vin = vin,
+		.i_max = get_val(ui->imax, ui->imax_unit, ELEC_UNIT_CURRENT, ELEC_UNIT_A),
+		.three = gp_widget_bool_get(ui->three),
+	};
+	int i, cnt;
+
+	cnt = elec_divider_search(&params, res, DIVIDER_RESULTS);
+
+	for (i = 0; i < DIVIDER_RESULTS; i++) {
+		char top[64], bot[64];
+
+		if (i >= cnt) {
+			gp_widget_label_set(ui->res[i], "---");
+			continue;
+		}
+
+		struct elec_val current = {
+			.val = res[i].current,
+			.unit = ELEC_UNIT_A,
+			.type = ELEC_UNIT_CURRENT,
+		};
+
+		elec_unit_convert(&current, imax_unit);
+
+		gp_widget_label_printf(ui->res[i], "%s / %s  %+.3f %%  %.3g %s",
+		                       rs_str(res[i].r_top, res[i].r_top2, top, sizeof(top)),
+		                       rs_str(res[i].r_bot, res[i].r_bot2, bot, sizeof(bot)),
+		                       100 * res[i].err, current.val,
+		                       elec_units_current[imax_unit].name);
+	}
+}
+
+static int tbox_number_callback(gp_widget_event *ev)
+{
+	if (ev->type != GP_WIDGET_EVENT_WIDGET)
+		return 0;
+
+	struct divider_ui *ui = ev->self->priv;
+	const char *text = gp_widget_tbox_text(ev->self);
+	char *end;
+
+	switch (ev->sub_type) {
+	case GP_WIDGET_TBOX_POST_FILTER:
+		strtod(text, &end);
+		if (*end)
+			return 1;
+		return 0;
+	break;
+	case GP_WIDGET_TBOX_EDIT:
+		recalc_divider(ui);
+	break;
+	}
+
+	return 0;
+}
+
+static int params_callback(gp_widget_event *ev)
+{
+	if (ev->type != GP_WIDGET_EVENT_WIDGET)
+		return 0;
+
+	recalc_divider(ev->self->priv);
+
+	return 0;
+}
+
+void divider_init(gp_htable *uids)
+{
+	char uid[16];
+	int i;
+
+	divider_ui.vin = gp_widget_by_uid(uids, "div_vin", GP_WIDGET_TBOX);
+	divider_ui.vout = gp_widget_by_uid(uids, "div_vout", GP_WIDGET_TBOX);
+	divider_ui.imax = gp_widget_by_uid(uids, "div_imax", GP_WIDGET_TBOX);
+
+	gp_widget_on_event_set(divider_ui.vin, tbox_number_callback, &divider_ui);
+	gp_widget_on_event_set(divider_ui.vout, tbox_number_callback, &divider_ui);
+	gp_widget_on_event_set(divider_ui.imax, tbox_number_callback, &divider_ui);
+
+	divider_ui.vin_unit = gp_widget_by_cuid(uids, "div_vin_unit", GP_WIDGET_CLASS_CHOICE);
+	divider_ui.vout_unit = gp_widget_by_cuid(uids, "div_vout_unit", GP_WIDGET_CLASS_CHOICE);
+	divider_ui.imax_unit = gp_widget_by_cuid(uids, "div_imax_unit", GP_WIDGET_CLASS_CHOICE);
+	divider_ui.series = gp_widget_by_cuid(uids, "div_series", GP_WIDGET_CLASS_CHOICE);
+	divider_ui.three = gp_widget_by_cuid(uids, "div_three", GP_WIDGET_CLASS_BOOL);
+
+	gp_widget_on_event_set(divider_ui.vin_unit, params_callback, &divider_ui);
+	gp_widget_on_event_set(divider_ui.vout_unit, params_callback, &divider_ui);
+	gp_widget_on_event_set(divider_ui.imax_unit, params_callback, &divider_ui);
+	gp_widget_on_event_set(divider_ui.series, params_callback, &divider_ui);
+	gp_widget_on_event_set(divider_ui.three, params_callback, &divider_ui);
+
+	for (i = 0; i < DIVIDER_RESULTS; i++) {
+		snprintf(uid, sizeof(uid), "div_res%i", i);
+		divider_ui.res[i] = gp_widget_by_uid(uids, uid, GP_WIDGET_LABEL);
+	}
+}
@@ -0,0 +1,16 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#ifndef DIVIDER_H
+#define DIVIDER_H
+
+#include <utils/gp_types.h>
+
+void divider_init(gp_htable *uids);
+
+#endif /* DIVIDER_H */
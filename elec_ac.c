@@ -0,0 +1,230 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#include <math.h>
+#include <complex.h>
+#include "elec_ac.h"
+
+/*
+ * Above this |z| the Hankel asymptotic expansion is used instead of the
+ * backward recurrence.
+ */
+#define HANKEL_MIN 30
+
+/*
+ * Returns J1(z)/J0(z).
+ */
+static double complex bessel_ratio(double complex z)
+{
+	double complex p[2], q[2];
+	double az = cabs(z);
+	int n, k;
+
+	if (az < HANKEL_MIN) {
+		double complex h = 0;
+
+		/* J_n/J_{n-1} = 1/(2n/z - J_{n+1}/J_n) */
+		for (n = az + 40; n >= 1; n--)
+			h = 1.0 / (2.0 * n / z - h);
+
+		return h;
+	}
+
+	/*
+	 * J_n(z) ~ sqrt(2/(pi z)) * (P cos(chi) - Q sin(chi)) and for Im(z) > 0
+	 * the e^{-i chi} term dominates both cos and sin.
+	 */
+	for (n = 0; n < 2; n++) {
+		double complex term = 1;
+		double mu = 4.0 * n * n;
+
+		p[n] = 1;
+		q[n] = 0;
+
+		for (k = 1; k <= 24; k++) {
+			double sign = ((k / 2) % 2) ? -1 : 1;
+
+			term *= (mu - (2 * k - 1) * (2 * k - 1)) / (8.0 * k * z);
+
+			if (k % 2)
+				q[n] += sign * term;
+			else
+				p[n] += sign * term;
+		}
+	}
+
+	return I * (p[1] - I * q[1]) / (p[0] - I * q[0]);
+}
+
+/*
+ * Skin and proximity factors from Kelvin functions of argument g.
+ *
+ * ber_n(g) + i bei_n(g) = J_n(g e^{3 pi i / 4}), everything is expressed as
+ * ratios of Bessel functions so that nothing overflows for large g.
+ */
+static void kelvin_factors(double g, double *fs, double *gp)
+{
+	double complex e = cexp(I * 3 * M_PI / 4);
+	double complex z = g * e;
+	double complex r1 = bessel_ratio(z);
+	double complex r2 = 2 * r1 / z - 1;
+	/* (ber' + i bei') / (ber + i bei) */
+	double complex w = -e * r1;
+	/* (ber bei' - bei ber') / (ber'^2 + bei'^2) */
+	double psi1 = -cimag(1.0 / w);
+	/* (ber2 ber' + bei2 bei') / (ber^2 + bei^2) */
+	double psi2 = creal(r2 * conj(w));
+
+	*fs = g / 2 * psi1;
+	*gp = -g * M_PI * psi2;
+}
+
+/*
+ * Rational approximations of the factors, for g <= FAST_SPLIT in t = g^4 and
+ * above as a correction to the asymptotic expansion in u = 1/g.
+ */
+#define FAST_SPLIT 10
+
+static inline double rat4(const double *c, double x)
+{
+	double n = c[0] + x * (c[1] + x * (c[2] + x * c[3]));
+	double d = 1 + x * (c[4] + x * (c[5] + x * (c[6] + x * c[7])));
+
+	return n / d;
+}
+
+static const double fs_small[8] = {
+	0.005208333267152697, 5.105694758289191e-06,
+	6.948845412189877e-10, 1.362129383287501e-14,
+	0.005146956151234311, 2.396649889486717e-06,
+	1.8800503511648377e-10, 1.7881483058857827e-15,
+};
+
+static const double fs_large[8] = {
+	0.13258257804832999, -3.016797634140312,
+	20.303104834615315, -33.201652170358194,
+	-22.753888348329003, 154.435936593403,
+	-276.94763823403736, 135.91309686841976,
+};
+
+static const double gp_small[8] = {
+	0.1963495071702392, 0.0004922351107741409,
+	1.3043454875060231e-07, 4.219421341350567e-12,
+	0.03115261709789165, 3.766863646953171e-05,
+	5.843066909346553e-09, 9.336872816629227e-14,
+};
+
+static const double gp_large[8] = {
+	-0.277680696291422, 6.476991975752039,
+	-45.92014904528594, 87.8130793980418,
+	-23.324360846618305, 166.87220630828557,
+	-346.97216336555186, 157.1921320759,
+};
+
+static inline double fast_factor(double g, double proximity)
+{
+	double t = g * g * g * g;
+	double u = 1 / g;
+	double fs_s = 1 + t * rat4(fs_small, t);
+	double gp_s = t * rat4(gp_small, t);
+	double fs_l = g / (2 * M_SQRT2) + 0.25 + u * rat4(fs_large, u);
+	double gp_l = M_PI * (g / M_SQRT2 - 0.5) + u * rat4(gp_large, u);
+	int small = g <= FAST_SPLIT;
+
+	return small ? fs_s + proximity * gp_s : fs_l + proximity * gp_l;
+}
+
+double elec_skin_depth(const struct elec_material *material, double freq)
+{
+	return sqrt(material->ro / (M_PI * freq * ELEC_MU0));
+}
+
+double elec_ac_proximity(double porosity, unsigned int layers)
+{
+	if (!layers)
+		return 0;
+
+	return porosity * porosity * (4.0 * ((double)layers * layers - 1) / 3 + 1);
+}
+
+double elec_ac_factor(double diameter, double skin_depth, double proximity)
+{
+	double g = diameter / (M_SQRT2 * skin_depth);
+	double fs, gp;
+
+	if (!(g > 0))
+		return 1;
+
+	kelvin_factors(g, &fs, &gp);
+
+	return fs + proximity * gp;
+}
+
+double elec_ac_factor_fast(double diameter, double skin_depth, double proximity)
+{
+	double g = diameter / (M_SQRT2 * skin_depth);
+
+	if (!(g > 0))
+		return 1;
+
+	return fast_factor(g, proximity);
+}
+
+void elec_ac_factor_batch(const struct elec_material *material, double diameter,
+                          double proximity, const double *restrict freq,
+                          double *restrict factor, size_t cnt)
+{
+	/* g = d / (sqrt(2) * skin_depth) = c * sqrt(f) */
+	double c = diameter * sqrt(M_PI * ELEC_MU0 / (2 * material->ro));
+	size_t i;
+
+	for (i = 0; i < cnt; i++) {
+		double g = c * sqrt(freq[i]);
+
+		factor[i] = g > 0 ? fast_factor(g, proximity) : 1;
+	}
+}
+
+void elec_ac_factor_batch_exact(const struct elec_material *material, double diameter,
+                                double proximity, const double *freq, double *factor,
+                                size_t cnt)
+{
+	size_t i;
+
+	for (i = 0; i < cnt; i++) {
+		double skin_depth = elec_skin_depth(material, freq[i]);
+
+		factor[i] = elec_ac_factor(diameter, skin_depth, proximity);
+	}
+}
+
+void elec_log_sweep(double f_min, double f_max, double *freq, size_t cnt)
+{
+	double step = cnt > 1 ? log(f_max / f_min) / (cnt - 1) : 0;
+	size_t i;
+
+	for (i = 0; i < cnt; i++)
+		freq[i] = f_min * exp(step * i);
+}
+
+struct elec_val elec_ac_resistance_block(struct elec_material *material,
+                                         struct elec_val length, struct elec_val diameter,
+                                         double freq, double proximity)
+{
+	struct elec_val area = diameter;
+	struct elec_val res;
+
+	elec_circle_area(&area, ELEC_UNIT_M2);
+	elec_unit_convert(&diameter, ELEC_UNIT_M);
+
+	res = elec_resistance_block(material, length, area);
+
+	res.val *= elec_ac_factor(diameter.val, elec_skin_depth(material, freq), proximity);
+
+	return res;
+}
@@ -0,0 +1,108 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * AC resistance of round conductors with skin and proximity effect.
+ *
+ * The model is the Ferreira solution for round conductors:
+ *
+ * Rac/Rdc = Fs(g) + k * Gp(g)
+ *
+ * where g = d / (sqrt(2) * skin_depth), Fs(g) is the skin effect factor,
+ * Gp(g) the proximity effect factor, both expressed with Kelvin functions,
+ * and k = porosity² * (4 * (layers² - 1) / 3 + 1) with porosity being ratio
+ * of the wire diameter to the winding pitch, k = 0 for an isolated conductor.
+ *
+ * Non-magnetic conductors, i.e. mu_r = 1, are assumed.
+ */
+
+#ifndef ELEC_AC_H
+#define ELEC_AC_H
+
+#include <stddef.h>
+#include <math.h>
+#include "libelec.h"
+
+/* Vacuum permeability in H/m */
+#define ELEC_MU0 (4e-7 * M_PI)
+
+/**
+ * Computes skin depth in meters.
+ *
+ * @material A material description.
+ * @freq A frequency in Hz.
+ */
+double elec_skin_depth(const struct elec_material *material, double freq);
+
+/**
+ * Computes proximity effect coefficient for a winding.
+ *
+ * @porosity Ratio of wire diameter and winding pitch.
+ * @layers Number of winding layers, 0 for an isolated conductor.
+ */
+double elec_ac_proximity(double porosity, unsigned int layers);
+
+/**
+ * Computes Rac/Rdc from Kelvin functions, accurate to about 1e-12 but slow.
+ *
+ * @diameter A conductor diameter in m.
+ * @skin_depth A skin depth in m.
+ * @proximity A proximity coefficient, see elec_ac_proximity().
+ */
+double elec_ac_factor(double diameter, double skin_depth, double proximity);
+
+/**
+ * Computes Rac/Rdc from rational approximations of the Kelvin function
+ * terms, relative error is below 1e-5 over the whole range.
+ */
+double elec_ac_factor_fast(double diameter, double skin_depth, double proximity);
+
+/**
+ * Computes Rac/Rdc for an array of frequencies with the fast approximation.
+ *
+ * The loop is branch free so that it could be vectorized by the compiler.
+ *
+ * @material A material description.
+ * @diameter A conductor diameter in m.
+ * @proximity A proximity coefficient, see elec_ac_proximity().
+ * @freq An array of frequencies in Hz.
+ * @factor An output array of Rac/Rdc.
+ * @cnt A size of the arrays.
+ */
+void elec_ac_factor_batch(const struct elec_material *material, double diameter,
+                          double proximity, const double *freq, double *factor,
+                          size_t cnt);
+
+/**
+ * Same as elec_ac_factor_batch() but using the exact elec_ac_factor().
+ */
+void elec_ac_factor_batch_exact(const struct elec_material *material, double diameter,
+                                double proximity, const double *freq, double *factor,
+                                size_t cnt);
+
+/**
+ * Fills in logarithmically spaced frequencies from f_min to f_max.
+ */
+void elec_log_sweep(double f_min, double f_max, double *freq, size_t cnt);
+
+/**
+ * Calculates AC resistance of a round conductor.
+ *
+ * @material A material description.
+ * @length A conductor length.
+ * @diameter A conductor diameter.
+ * @freq A frequency in Hz.
+ * @proximity A proximity coefficient, see elec_ac_proximity().
+ *
+ * @return Resistance in Ohms.
+ */
+struct elec_val elec_ac_resistance_block(struct elec_material *material,
+                                         struct elec_val length, struct elec_val diameter,
+                                         double freq, double proximity);
+
+#endif /* ELEC_AC_H */
@@ -0,0 +1,35 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#include <stdlib.h>
+#include "elec_approx.h"
+
+int elec_approx_enabled;
+
+double elec_approx_exp2_tbl[ELEC_APPROX_TBL];
+double elec_approx_log2_inv[ELEC_APPROX_TBL];
+double elec_approx_log2_tbl[ELEC_APPROX_TBL];
+
+__attribute__((constructor))
+static void approx_init(void)
+{
+	const char *env = getenv(ELEC_APPROX_ENV);
+	int i;
+
+	for (i = 0; i < ELEC_APPROX_TBL; i++) {
+		double c = 1 + (i + 0.5) / ELEC_APPROX_TBL;
+
+		elec_approx_exp2_tbl[i] = exp2((double)i / ELEC_APPROX_TBL);
+		elec_approx_log2_inv[i] = 1 / c;
+		/* log2(m) = log2(m * inv) - log2(inv) holds for the rounded inv too */
+		elec_approx_log2_tbl[i] = -log2(elec_approx_log2_inv[i]);
+	}
+
+	if (env && *env)
+		elec_approx_set(atoi(env));
+}
@@ -0,0 +1,138 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Approximate math mode for bulk sweeps.
+ *
+ * When enabled the pow() and log() in the AWG conversions are replaced by
+ * the table driven exp2 and log2 approximations below. The areas stay
+ * within a few ULPs, the AWG gauges within 1e-12 absolute,
+ * `elecalc-batch approx` measures the ULP and relative error of each path
+ * against the exact one over dense input grids next to the speedup.
+ *
+ * The square roots, the logarithm in the fusing I²t and the powers in the
+ * PCB current capacity are left exact, the libm functions are as fast as
+ * the approximations there.
+ *
+ * The mode is off by default and can be enabled from the environment by
+ * setting ELEC_APPROX=1.
+ */
+
+#ifndef ELEC_APPROX_H
+#define ELEC_APPROX_H
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#define ELEC_APPROX_ENV "ELEC_APPROX"
+
+extern int elec_approx_enabled;
+
+/**
+ * Enables or disables the approximate mode, must not be called while
+ * calculations are running in other threads.
+ */
+static inline void elec_approx_set(int enable)
+{
+	elec_approx_enabled = !!enable;
+}
+
+/**
+ * Returns non-zero if the approximate mode is enabled.
+ */
+static inline int elec_approx(void)
+{
+	return elec_approx_enabled;
+}
+
+/* Table size for the argument reduction */
+#define ELEC_APPROX_BITS 6
+#define ELEC_APPROX_TBL (1 << ELEC_APPROX_BITS)
+
+/* 2^(i/64) */
+extern double elec_approx_exp2_tbl[ELEC_APPROX_TBL];
+/* 1/c and log2(c) for c in the middle of [1 + i/64, 1 + (i+1)/64) */
+extern double elec_approx_log2_inv[ELEC_APPROX_TBL];
+extern double elec_approx_log2_tbl[ELEC_APPROX_TBL];
+
+/**
+ * Base 2 exponential, relative error below 1e-15 for results in the normal
+ * range, falls back to exp2() outside of it.
+ *
+ * 2^x = 2^e * 2^(i/64) * 2^r with |r| <= 1/128, the last term is a degree 5
+ * polynomial.
+ */
+static inline double elec_approx_exp2(double x)
+{
+	double k, r, p, t;
+	int64_t ki;
+	uint64_t bits;
+
+	/* Result outside of the normal range, or NaN */
+	if (!(x > -1022 && x < 1023))
+		return exp2(x);
+
+	/* Rounds to nearest integer for |x| < 2^51 */
+	k = (x * ELEC_APPROX_TBL + 0x1.8p52) - 0x1.8p52;
+	ki = (int64_t)k;
+	r = (x - k / ELEC_APPROX_TBL) * M_LN2;
+
+	p = 1.0 / 120;
+	p = p * r + 1.0 / 24;
+	p = p * r + 1.0 / 6;
+	p = p * r + 0.5;
+	p = p * r + 1;
+	p = p * r + 1;
+
+	t = elec_approx_exp2_tbl[ki & (ELEC_APPROX_TBL - 1)];
+	memcpy(&bits, &t, sizeof(bits));
+	bits += (uint64_t)(ki >> ELEC_APPROX_BITS) << 52;
+	memcpy(&t, &bits, sizeof(t));
+
+	return t * p;
+}
+
+/**
+ * Base 2 logarithm, absolute error below 1e-15, falls back to log2() for
+ * zero, negative, subnormal and non-finite inputs.
+ *
+ * log2(x) = e + log2(c) + log2(m/c) with m in [1, 2), c the middle of the
+ * table interval m falls into and |m/c - 1| < 1/128, the last term is a
+ * degree 6 polynomial.
+ */
+static inline double elec_approx_log2(double x)
+{
+	uint64_t bits;
+	unsigned int i;
+	double m, r, p;
+	int64_t e;
+
+	/* Zero, negative, subnormal, infinity and NaN */
+	if (!(x >= 0x1p-1022 && x < INFINITY))
+		return log2(x);
+
+	memcpy(&bits, &x, sizeof(bits));
+	e = (int64_t)(bits >> 52) - 1023;
+	i = (bits >> (52 - ELEC_APPROX_BITS)) & (ELEC_APPROX_TBL - 1);
+	bits = (bits & ((1ull << 52) - 1)) | (1023ull << 52);
+	memcpy(&m, &bits, sizeof(m));
+
+	r = m * elec_approx_log2_inv[i] - 1;
+
+	p = -1.0 / 6;
+	p = p * r + 1.0 / 5;
+	p = p * r - 1.0 / 4;
+	p = p * r + 1.0 / 3;
+	p = p * r - 0.5;
+	p = p * r + 1;
+
+	return e + (elec_approx_log2_tbl[i] + p * r * M_LOG2E);
+}
+
+#endif /* ELEC_APPROX_H */
@@ -0,0 +1,238 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "elec_batch.h"
+
+struct batch_kernels {
+	void (*resistance)(double ro, const double *length, const double *cross_section,
+	                   double *resistance, size_t cnt);
+	void (*mass)(double density, const double *length, const double *cross_section,
+	             double *mass, size_t cnt);
+	void (*linear)(double a, double b, const double *x, double *y, size_t cnt);
+	void (*scale)(double mul, double div, const double *in, double *out, size_t cnt);
+	void (*ohm_law)(const double *u, const double *i, double *r, double *p, size_t cnt);
+};
+
+/* Keeps a * b + c from being fused into FMA where available */
+#ifdef __clang__
+# pragma clang fp contract(off)
+# define NO_CONTRACT
+#else
+# define NO_CONTRACT optimize("fp-contract=off")
+#endif
+
+#define KERN_NAME generic
+#define KERN_ATTR __attribute__((NO_CONTRACT))
+#define KERN_BYTES 0
+#include "elec_batch_kern.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+# define ISA_X86
+
+# define KERN_NAME sse2
+# define KERN_ATTR __attribute__((target("sse2"), NO_CONTRACT))
+# define KERN_BYTES 16
+# include "elec_batch_kern.h"
+
+# define KERN_NAME avx2
+# define KERN_ATTR __attribute__((target("avx2"), NO_CONTRACT))
+# define KERN_BYTES 32
+# include "elec_batch_kern.h"
+
+# define KERN_NAME avx512
+# define KERN_ATTR __attribute__((target("avx512f"), NO_CONTRACT))
+# define KERN_BYTES 64
+# include "elec_batch_kern.h"
+#endif
+
+#if defined(__aarch64__)
+# define ISA_NEON
+
+/* NEON is mandatory on arm64 */
+# define KERN_NAME neon
+# define KERN_ATTR __attribute__((NO_CONTRACT))
+# define KERN_BYTES 16
+# include "elec_batch_kern.h"
+#endif
+
+static const struct batch_isa {
+	const char *name;
+	const struct batch_kernels *kernels;
+} isas[] = {
+	{"generic", &kernels_generic},
+#ifdef ISA_X86
+	{"sse2", &kernels_sse2},
+	{"avx2", &kernels_avx2},
+	{"avx512", &kernels_avx512},
+#endif
+#ifdef ISA_NEON
+	{"neon", &kernels_neon},
+#endif
+};
+
+#define ISAS_CNT (sizeof(isas) / sizeof(*isas))
+
+static const struct batch_isa *isa = &isas[0];
+
+static int isa_supported(const struct batch_isa *i)
+{
+#ifdef ISA_X86
+	if (i->kernels == &kernels_sse2)
+		return __builtin_cpu_supports("sse2");
+
+	if (i->kernels == &kernels_avx2)
+		return __builtin_cpu_supports("avx2");
+
+	if (i->kernels == &kernels_avx512)
+		return __builtin_cpu_supports("avx512f");
+#endif
+	(void) i;
+
+	return 1;
+}
+
+int elec_batch_isa_set(const char *name)
+{
+	size_t i;
+
+	for (i = 0; i < ISAS_CNT; i++) {
+		if (strcmp(isas[i].name, name))
+			continue;
+
+		if (!isa_supported(&isas[i]))
+			return 1;
+
+		isa = &isas[i];
+		return 0;
+	}
+
+	return 1;
+}
+
+const char *elec_batch_isa(void)
+{
+	return isa->name;
+}
+
+const char *elec_batch_isa_name(unsigned int i)
+{
+	return i < ISAS_CNT ? isas[i].name : NULL;
+}
+
+/*
+ * Picks the last, i.e. the widest, supported variant when the library is
+ * loaded, the choice can be overriden from the environment for testing.
+ */
+__attribute__((constructor))
+static void batch_isa_init(void)
+{
+	const char *env = getenv(ELEC_BATCH_ISA_ENV);
+	size_t i;
+
+#ifdef ISA_X86
+	__builtin_cpu_init();
+#endif
+
+	for (i = ISAS_CNT; i-- > 0;) {
+		if (isa_supported(&isas[i])) {
+			isa = &isas[i];
+			break;
+		}
+	}
+
+	if (env && *env && elec_batch_isa_set(env)) {
+		fprintf(stderr, "%s: ISA '%s' unknown or unsupported, using '%s'\n",
+		        ELEC_BATCH_ISA_ENV, env, isa->name);
+	}
+}
+
+void elec_resistance_batch(const struct elec_material *material,
+                           const double *length, const double *cross_section,
+                           double *resistance, size_t cnt)
+{
+	isa->kernels->resistance(material->ro, length, cross_section, resistance, cnt);
+}
+
+void elec_mass_batch(const struct elec_material *material,
+                     const double *length, const double *cross_section,
+                     double *mass, size_t cnt)
+{
+	isa->kernels->mass(material->density, length, cross_section, mass, cnt);
+}
+
+void elec_resistance_temp_batch(const struct elec_material *material, double r_ref,
+                                const double *temp, double *resistance, size_t cnt)
+{
+	const double a = r_ref * material->tc;
+	const double b = r_ref - a * ELEC_TEMP_REF;
+
+	isa->kernels->linear(a, b, temp, resistance, cnt);
+}
+
+void elec_ohm_law_batch(const double *u, const double *i, double *r, double *p, size_t cnt)
+{
+	isa->kernels->ohm_law(u, i, r, p, cnt);
+}
+
+static const struct elec_units *units_by_type(enum elec_unit type)
+{
+	switch (type) {
+	case ELEC_UNIT_UNDEF:
+	break;
+	case ELEC_UNIT_LENGTH:
+		return elec_units_length;
+	case ELEC_UNIT_AREA:
+		return elec_units_area;
+	case ELEC_UNIT_MASS:
+		return elec_units_mass;
+	case ELEC_UNIT_RESISTANCE:
+		return elec_units_resistance;
+	case ELEC_UNIT_VOLTAGE:
+		return elec_units_voltage;
+	case ELEC_UNIT_CURRENT:
+		return elec_units_current;
+	case ELEC_UNIT_POWER:
+		return elec_units_power;
+	case ELEC_UNIT_CAPACITANCE:
+		return elec_units_capacitance;
+	case ELEC_UNIT_INDUCTANCE:
+		return elec_units_inductance;
+	}
+
+	return NULL;
+}
+
+void elec_unit_convert_batch(enum elec_unit type, elec_unit unit_from, elec_unit unit_to,
+                             const double *in, double *out, size_t cnt)
+{
+	const struct elec_units *units = units_by_type(type);
+	size_t i;
+
+	if (!units) {
+		if (in != out)
+			memmove(out, in, cnt * sizeof(double));
+		return;
+	}
+
+	/* AWG is not a linear scale */
+	if (isnan(units[unit_from].mul) || isnan(units[unit_to].mul)) {
+		for (i = 0; i < cnt; i++) {
+			struct elec_val val = {.type = type, .unit = unit_from, .val = in[i]};
+
+			elec_unit_convert(&val, unit_to);
+			out[i] = val.val;
+		}
+		return;
+	}
+
+	isa->kernels->scale(units[unit_from].mul, units[unit_to].mul, in, out, cnt);
+}
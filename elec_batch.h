@@ -0,0 +1,115 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Array variants of the libelec calculations.
+ *
+ * All the values are passed in base SI units, i.e. meters, square meters,
+ * ohms and kilograms, so that no unit conversions are done in the loops.
+ *
+ * The loops are compiled for several instruction sets, e.g. SSE2, AVX2 and
+ * AVX-512 on x86, and the widest one supported by the CPU is picked when the
+ * library is loaded. All variants produce bit identical results.
+ */
+
+#ifndef ELEC_BATCH_H
+#define ELEC_BATCH_H
+
+#include <stddef.h>
+#include "libelec.h"
+
+/**
+ * Array variant of elec_resistance_block().
+ *
+ * @material A material description.
+ * @length An array of lengths in m.
+ * @cross_section An array of cross sections in m².
+ * @resistance An output array of resistances in Ohms.
+ * @cnt A number of elements in the arrays.
+ */
+void elec_resistance_batch(const struct elec_material *material,
+                           const double *length, const double *cross_section,
+                           double *resistance, size_t cnt);
+
+/**
+ * Array variant of elec_mass_block().
+ *
+ * @material A material description.
+ * @length An array of lengths in m.
+ * @cross_section An array of cross sections in m².
+ * @mass An output array of masses in kg.
+ * @cnt A number of elements in the arrays.
+ */
+void elec_mass_batch(const struct elec_material *material,
+                     const double *length, const double *cross_section,
+                     double *mass, size_t cnt);
+
+/**
+ * Array variant of elec_resistance_temp().
+ *
+ * @material A material description.
+ * @r_ref A resistance at ELEC_TEMP_REF in Ohms.
+ * @temp An array of temperatures in °C.
+ * @resistance An output array of resistances in Ohms.
+ * @cnt A number of elements in the arrays.
+ */
+void elec_resistance_temp_batch(const struct elec_material *material, double r_ref,
+                                const double *temp, double *resistance, size_t cnt);
+
+/**
+ * Array variant of elec_ohm_law() solving R and P for known U and I.
+ *
+ * @u An array of voltages in V.
+ * @i An array of currents in A.
+ * @r An output array of resistances in Ohms.
+ * @p An output array of powers in W.
+ * @cnt A number of elements in the arrays.
+ */
+void elec_ohm_law_batch(const double *u, const double *i, double *r, double *p, size_t cnt);
+
+/**
+ * Converts an array of values from one unit to another.
+ *
+ * @type A unit type e.g. ELEC_UNIT_LENGTH.
+ * @unit_from A unit of the input values.
+ * @unit_to A unit of the output values.
+ * @in An input array.
+ * @out An output array, may be the same as in.
+ * @cnt A number of elements in the arrays.
+ */
+void elec_unit_convert_batch(enum elec_unit type, elec_unit unit_from, elec_unit unit_to,
+                             const double *in, double *out, size_t cnt);
+
+/*
+ * Environment variable that overrides the instruction set variant, e.g.
+ * ELEC_BATCH_ISA=generic for the plain C loops.
+ */
+#define ELEC_BATCH_ISA_ENV "ELEC_BATCH_ISA"
+
+/**
+ * Returns name of the instruction set variant in use.
+ */
+const char *elec_batch_isa(void);
+
+/**
+ * Returns name of i-th compiled in variant or NULL if i is out of range.
+ */
+const char *elec_batch_isa_name(unsigned int i);
+
+/**
+ * Switches the instruction set variant, this is not thread safe and should
+ * be called only when no batch calculation is running.
+ *
+ * @name A variant name.
+ *
+ * @return Zero on success, non-zero if variant is unknown or not supported
+ *         by the CPU.
+ */
+int elec_batch_isa_set(const char *name);
+
+#endif /* ELEC_BATCH_H */
@@ -0,0 +1,154 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Batch kernels template, included by elec_batch.c once per instruction set
+ * with the following macros defined:
+ *
+ * KERN_NAME  - variant name, used as a suffix for the function names
+ * KERN_ATTR  - function attributes, i.e. the target
+ * KERN_BYTES - vector size in bytes, 0 for scalar loops
+ *
+ * The vector loops do exactly the same operations in the same order as the
+ * scalar loops, and floating point contraction is disabled, so that all
+ * variants produce bit identical results.
+ */
+
+#define KERN_CAT2(a, b) a##_##b
+#define KERN_CAT(a, b) KERN_CAT2(a, b)
+#define KERN(fn) KERN_CAT(fn, KERN_NAME)
+
+#if KERN_BYTES
+typedef double KERN(vd) __attribute__((vector_size(KERN_BYTES)));
+# define KERN_LANES (KERN_BYTES / sizeof(double))
+# define KERN_LOAD(v, ptr) memcpy(&(v), (ptr), sizeof(v))
+# define KERN_STORE(ptr, v) memcpy((ptr), &(v), sizeof(v))
+#endif
+
+static KERN_ATTR void KERN(resistance)(double ro,
+                                       const double *restrict length,
+                                       const double *restrict cross_section,
+                                       double *restrict resistance, size_t cnt)
+{
+	size_t i = 0;
+
+#if KERN_BYTES
+	for (; i + KERN_LANES <= cnt; i += KERN_LANES) {
+		KERN(vd) l, a, r;
+
+		KERN_LOAD(l, length + i);
+		KERN_LOAD(a, cross_section + i);
+		r = ro * l / a;
+		KERN_STORE(resistance + i, r);
+	}
+#endif
+
+	for (; i < cnt; i++)
+		resistance[i] = ro * length[i] / cross_section[i];
+}
+
+static KERN_ATTR void KERN(mass)(double density,
+                                 const double *restrict length,
+                                 const double *restrict cross_section,
+                                 double *restrict mass, size_t cnt)
+{
+	size_t i = 0;
+
+#if KERN_BYTES
+	for (; i + KERN_LANES <= cnt; i += KERN_LANES) {
+		KERN(vd) l, a, m;
+
+		KERN_LOAD(l, length + i);
+		KERN_LOAD(a, cross_section + i);
+		m = density * l * a;
+		KERN_STORE(mass + i, m);
+	}
+#endif
+
+	for (; i < cnt; i++)
+		mass[i] = density * length[i] * cross_section[i];
+}
+
+static KERN_ATTR void KERN(linear)(double a, double b,
+                                   const double *restrict x,
+                                   double *restrict y, size_t cnt)
+{
+	size_t i = 0;
+
+#if KERN_BYTES
+	for (; i + KERN_LANES <= cnt; i += KERN_LANES) {
+		KERN(vd) v;
+
+		KERN_LOAD(v, x + i);
+		v = a * v + b;
+		KERN_STORE(y + i, v);
+	}
+#endif
+
+	for (; i < cnt; i++)
+		y[i] = a * x[i] + b;
+}
+
+/* May be called in place */
+static KERN_ATTR void KERN(scale)(double mul, double div,
+                                  const double *in, double *out, size_t cnt)
+{
+	size_t i = 0;
+
+#if KERN_BYTES
+	for (; i + KERN_LANES <= cnt; i += KERN_LANES) {
+		KERN(vd) v;
+
+		KERN_LOAD(v, in + i);
+		v = v * mul / div;
+		KERN_STORE(out + i, v);
+	}
+#endif
+
+	for (; i < cnt; i++)
+		out[i] = in[i] * mul / div;
+}
+
+static KERN_ATTR void KERN(ohm_law)(const double *restrict u, const double *restrict i,
+                                    double *restrict r, double *restrict p, size_t cnt)
+{
+	size_t j = 0;
+
+#if KERN_BYTES
+	for (; j + KERN_LANES <= cnt; j += KERN_LANES) {
+		KERN(vd) vu, vi, vr, vp;
+
+		KERN_LOAD(vu, u + j);
+		KERN_LOAD(vi, i + j);
+		vr = vu / vi;
+		vp = vu * vi;
+		KERN_STORE(r + j, vr);
+		KERN_STORE(p + j, vp);
+	}
+#endif
+
+	for (; j < cnt; j++) {
+		r[j] = u[j] / i[j];
+		p[j] = u[j] * i[j];
+	}
+}
+
+static const struct batch_kernels KERN(kernels) = {
+	.resistance = KERN(resistance),
+	.mass = KERN(mass),
+	.linear = KERN(linear),
+	.scale = KERN(scale),
+	.ohm_law = KERN(ohm_law),
+};
+
+#undef KERN_LANES
+#undef KERN_LOAD
+#undef KERN_STORE
+#undef KERN_NAME
+#undef KERN_ATTR
+#undef KERN_BYTES
@@ -0,0 +1,444 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "elec_col.h"
+
+#define COL_VERSION 1
+#define COL_BOM 0x01020304
+
+struct file_hdr {
+	char magic[4];
+	uint32_t version;
+	uint32_t bom;
+	uint32_t cols;
+};
+
+struct col_hdr {
+	char name[ELEC_COL_NAME_MAX];
+	uint8_t type;
+	uint8_t unit;
+	uint8_t storage;
+	uint8_t reserved;
+	uint32_t labels;
+};
+
+static const size_t storage_size[] = {
+	[ELEC_COL_F64] = sizeof(double),
+	[ELEC_COL_F32] = sizeof(float),
+	[ELEC_COL_U16] = sizeof(uint16_t),
+};
+
+/* Number of units per column type, label columns have no unit */
+static const unsigned int units_cnt[] = {
+	[ELEC_UNIT_UNDEF] = 1,
+	[ELEC_UNIT_LENGTH] = ELEC_UNIT_LENGTH_CNT,
+	[ELEC_UNIT_AREA] = ELEC_UNIT_AREA_CNT,
+	[ELEC_UNIT_MASS] = ELEC_UNIT_MASS_CNT,
+	[ELEC_UNIT_RESISTANCE] = ELEC_UNIT_RESISTANCE_CNT,
+	[ELEC_UNIT_VOLTAGE] = ELEC_UNIT_VOLTAGE_CNT,
+	[ELEC_UNIT_CURRENT] = ELEC_UNIT_CURRENT_CNT,
+	[ELEC_UNIT_POWER] = ELEC_UNIT_POWER_CNT,
+	[ELEC_UNIT_CAPACITANCE] = ELEC_UNIT_CAPACITANCE_CNT,
+	[ELEC_UNIT_INDUCTANCE] = ELEC_UNIT_INDUCTANCE_CNT,
+};
+
+static size_t pad8(size_t len)
+{
+	return (8 - len % 8) % 8;
+}
+
+static void w_write(struct elec_col_writer *w, const void *buf, size_t len)
+{
+	if (len && fwrite(buf, len, 1, w->f) != 1)
+		w->err = 1;
+
+	w->bytes += len;
+}
+
+static void w_pad(struct elec_col_writer *w)
+{
+	static const char zeros[8];
+
+	w_write(w, zeros, pad8(w->bytes));
+}
+
+struct elec_col_writer *elec_col_writer_open(FILE *f, const struct elec_col_desc *cols,
+                                             size_t cols_cnt)
+{
+	struct file_hdr hdr = {.magic = "ELCF", .version = COL_VERSION,
+	                       .bom = COL_BOM, .cols = cols_cnt};
+	struct elec_col_writer *w;
+	size_t i, j;
+
+	if (!cols_cnt)
+		return NULL;
+
+	w = calloc(1, sizeof(*w));
+	if (!w)
+		return NULL;
+
+	w->storage = malloc(cols_cnt * sizeof(*w->storage));
+	if (!w->storage) {
+		free(w);
+		return NULL;
+	}
+
+	w->f = f;
+	w->cols_cnt = cols_cnt;
+
+	w_write(w, &hdr, sizeof(hdr));
+
+	for (i = 0; i < cols_cnt; i++) {
+		struct col_hdr col = {
+			.type = cols[i].type,
+			.unit = cols[i].unit,
+			.storage = cols[i].storage,
+			.labels = cols[i].storage == ELEC_COL_U16 ? cols[i].labels_cnt : 0,
+		};
+
+		strncpy(col.name, cols[i].name, sizeof(col.name) - 1);
+		w->storage[i] = cols[i].storage;
+
+		w_write(w, &col, sizeof(col));
+	}
+
+	for (i = 0; i < cols_cnt; i++) {
+		if (cols[i].storage != ELEC_COL_U16)
+			continue;
+
+		for (j = 0; j < cols[i].labels_cnt; j++) {
+			size_t len = strlen(cols[i].labels[j]);
+			uint8_t l = len > 255 ? 255 : len;
+
+			w_write(w, &l, 1);
+			w_write(w, cols[i].labels[j], l);
+		}
+	}
+
+	w_pad(w);
+
+	return w;
+}
+
+int elec_col_write(struct elec_col_writer *w, const void *const *data, size_t rows)
+{
+	uint64_t hdr = rows;
+	size_t i, j;
+
+	if (!rows)
+		return w->err;
+
+	w_write(w, &hdr, sizeof(hdr));
+
+	for (i = 0; i < w->cols_cnt; i++) {
+		if (w->storage[i] != ELEC_COL_F32) {
+			w_write(w, data[i], rows * storage_size[w->storage[i]]);
+			w_pad(w);
+			continue;
+		}
+
+		if (w->tmp_size < rows) {
+			float *tmp = realloc(w->tmp, rows * sizeof(float));
+
+			if (!tmp) {
+				w->err = 1;
+				return 1;
+			}
+
+			w->tmp = tmp;
+			w->tmp_size = rows;
+		}
+
+		for (j = 0; j < rows; j++)
+			w->tmp[j] = ((const double *)data[i])[j];
+
+		w_write(w, w->tmp, rows * sizeof(float));
+		w_pad(w);
+	}
+
+	return w->err;
+}
+
+int elec_col_writer_close(struct elec_col_writer *w)
+{
+	uint64_t end = 0;
+	int err;
+
+	w_write(w, &end, sizeof(end));
+
+	err = w->err;
+
+	free(w->storage);
+	free(w->tmp);
+	free(w);
+
+	return err;
+}
+
+/*
+ * Called only for columns with labels, labels_cnt is never zero.
+ */
+static int parse_labels(struct elec_col_info *col, const char *map,
+                        size_t map_len, size_t *pos)
+{
+	size_t i;
+
+	col->labels = calloc(col->labels_cnt, sizeof(char *));
+	if (!col->labels)
+		return ENOMEM;
+
+	for (i = 0; i < col->labels_cnt; i++) {
+		uint8_t len;
+
+		if (*pos + 1 > map_len)
+			return EINVAL;
+
+		len = map[(*pos)++];
+
+		if (*pos + len > map_len)
+			return EINVAL;
+
+		col->labels[i] = strndup(map + *pos, len);
+		if (!col->labels[i])
+			return ENOMEM;
+
+		*pos += len;
+	}
+
+	return 0;
+}
+
+static int parse_groups(struct elec_col_file *f, const char *map, size_t pos)
+{
+	size_t size = 0, i;
+
+	for (;;) {
+		struct elec_col_group *g;
+		uint64_t rows;
+
+		if (pos + sizeof(rows) > f->map_len)
+			return 0;
+
+		memcpy(&rows, map + pos, sizeof(rows));
+		pos += sizeof(rows);
+
+		if (!rows) {
+			f->complete = 1;
+			return 0;
+		}
+
+		if (f->groups_cnt >= size) {
+			size_t new_size = size ? 2 * size : 64;
+			struct elec_col_group *tmp;
+
+			tmp = realloc(f->groups, new_size * sizeof(*tmp));
+			if (!tmp)
+				return ENOMEM;
+
+			f->groups = tmp;
+			size = new_size;
+		}
+
+		g = &f->groups[f->groups_cnt];
+		g->rows = rows;
+		g->data = malloc(f->cols_cnt * sizeof(void *));
+		if (!g->data)
+			return ENOMEM;
+
+		f->groups_cnt++;
+
+		for (i = 0; i < f->cols_cnt; i++) {
+			size_t len = storage_size[f->cols[i].storage];
+
+			/* Truncated group including the padding, ignore it */
+			if (rows > (f->map_len - pos) / len ||
+			    rows * len + pad8(rows * len) > f->map_len - pos) {
+				free(g->data);
+				f->groups_cnt--;
+				return 0;
+			}
+
+			len *= rows;
+			g->data[i] = map + pos;
+			pos += len + pad8(len);
+		}
+
+		f->rows += rows;
+	}
+}
+
+struct elec_col_file *elec_col_open(const char *path)
+{
+	struct elec_col_file *f;
+	struct file_hdr hdr;
+	struct stat st;
+	size_t pos, i;
+	int fd, err = EINVAL;
+	char *map;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return NULL;
+
+	if (fstat(fd, &st)) {
+		err = errno;
+		close(fd);
+		errno = err;
+		return NULL;
+	}
+
+	if ((size_t)st.st_size < sizeof(hdr)) {
+		close(fd);
+		errno = EINVAL;
+		return NULL;
+	}
+
+	map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	err = errno;
+	close(fd);
+
+	if (map == MAP_FAILED) {
+		errno = err;
+		return NULL;
+	}
+
+	madvise(map, st.st_size, MADV_SEQUENTIAL);
+
+	f = calloc(1, sizeof(*f));
+	if (!f) {
+		munmap(map, st.st_size);
+		errno = ENOMEM;
+		return NULL;
+	}
+
+	f->map = map;
+	f->map_len = st.st_size;
+
+	memcpy(&hdr, map, sizeof(hdr));
+
+	err = EINVAL;
+
+	if (memcmp(hdr.magic, "ELCF", 4) || hdr.version != COL_VERSION || hdr.bom != COL_BOM)
+		goto err;
+
+	pos = sizeof(hdr);
+
+	if (!hdr.cols || hdr.cols > (f->map_len - pos) / sizeof(struct col_hdr))
+		goto err;
+
+	f->cols = calloc(hdr.cols, sizeof(*f->cols));
+	if (!f->cols) {
+		err = ENOMEM;
+		goto err;
+	}
+
+	f->cols_cnt = hdr.cols;
+
+	for (i = 0; i < f->cols_cnt; i++) {
+		struct col_hdr col;
+
+		memcpy(&col, map + pos, sizeof(col));
+		pos += sizeof(col);
+
+		if (col.storage > ELEC_COL_U16)
+			goto err;
+
+		if (col.type >= sizeof(units_cnt)/sizeof(*units_cnt) ||
+		    col.unit >= units_cnt[col.type])
+			goto err;
+
+		memcpy(f->cols[i].name, col.name, ELEC_COL_NAME_MAX);
+		f->cols[i].name[ELEC_COL_NAME_MAX - 1] = 0;
+		f->cols[i].type = col.type;
+		f->cols[i].unit = col.unit;
+		f->cols[i].storage = col.storage;
+		f->cols[i].labels_cnt = col.labels;
+	}
+
+	for (i = 0; i < f->cols_cnt; i++) {
+		if (!f->cols[i].labels_cnt)
+			continue;
+
+		err = parse_labels(&f->cols[i], map, f->map_len, &pos);
+		if (err)
+			goto err;
+	}
+
+	pos += pad8(pos);
+
+	err = parse_groups(f, map, pos);
+	if (err)
+		goto err;
+
+	return f;
+err:
+	elec_col_close(f);
+	errno = err;
+	return NULL;
+}
+
+void elec_col_close(struct elec_col_file *f)
+{
+	size_t i, j;
+
+	for (i = 0; i < f->cols_cnt; i++) {
+		for (j = 0; f->cols[i].labels && j < f->cols[i].labels_cnt; j++)
+			free(f->cols[i].labels[j]);
+
+		free(f->cols[i].labels);
+	}
+
+	for (i = 0; i < f->groups_cnt; i++)
+		free(f->groups[i].data);
+
+	munmap(f->map, f->map_len);
+	free(f->groups);
+	free(f->cols);
+	free(f);
+}
+
+int elec_col_find(const struct elec_col_file *f, const char *name)
+{
+	size_t i;
+
+	for (i = 0; i < f->cols_cnt; i++) {
+		if (!strcmp(f->cols[i].name, name))
+			return i;
+	}
+
+	return -1;
+}
+
+const char *elec_col_label(const struct elec_col_file *f, size_t group,
+                           size_t col, size_t row)
+{
+	const struct elec_col_info *info = &f->cols[col];
+	uint16_t idx;
+
+	if (info->storage != ELEC_COL_U16)
+		return NULL;
+
+	idx = ((const uint16_t *)f->groups[group].data[col])[row];
+
+	return idx < info->labels_cnt ? info->labels[idx] : NULL;
+}
+
+void elec_col_to_f64(const struct elec_col_file *f, size_t group, size_t col, double *out)
+{
+	size_t i, rows = f->groups[group].rows;
+
+	for (i = 0; i < rows; i++)
+		out[i] = elec_col_get(f, group, col, i);
+}
@@ -0,0 +1,204 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Columnar binary format for calculation results.
+ *
+ * Each column stores its quantity type and unit once in the header, the
+ * values are dense arrays of doubles or floats. Columns of small integers
+ * carry a list of labels, e.g. material names, and store label indexes.
+ *
+ * The file is written as a stream of row groups so that a batch tool does
+ * not have to keep the whole result in memory, and it is read by mapping it
+ * into memory, the column arrays are used in place without any copying.
+ *
+ * The layout is in native endianity with all arrays aligned to 8 bytes:
+ *
+ * "ELCF" uint32_t version, uint32_t byte order mark, uint32_t columns
+ * columns x {char name[32], uint8_t type, uint8_t unit, uint8_t storage,
+ *            uint8_t reserved, uint32_t labels}
+ * for each column labels x {uint8_t len, char label[len]}, padded to 8 bytes
+ *
+ * followed by row groups:
+ *
+ * uint64_t rows, for each column rows x value, padded to 8 bytes
+ *
+ * and terminated by a row group with zero rows.
+ */
+
+#ifndef ELEC_COL_H
+#define ELEC_COL_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include "libelec.h"
+
+#define ELEC_COL_NAME_MAX 32
+
+enum elec_col_storage {
+	/* double values */
+	ELEC_COL_F64,
+	/* double values stored as floats */
+	ELEC_COL_F32,
+	/* uint16_t label indexes */
+	ELEC_COL_U16,
+};
+
+struct elec_col_desc {
+	const char *name;
+	enum elec_unit type;
+	elec_unit unit;
+	enum elec_col_storage storage;
+
+	/* labels for ELEC_COL_U16 columns */
+	const char *const *labels;
+	size_t labels_cnt;
+};
+
+struct elec_col_writer {
+	FILE *f;
+	size_t cols_cnt;
+	enum elec_col_storage *storage;
+	/* conversion buffer for ELEC_COL_F32 */
+	float *tmp;
+	size_t tmp_size;
+	/* bytes written so far */
+	size_t bytes;
+	int err;
+};
+
+/**
+ * Writes the file header.
+ *
+ * @f A stream opened for writing.
+ * @cols Column descriptions.
+ * @cols_cnt Number of columns, at least one.
+ *
+ * @return A writer or NULL on failure.
+ */
+struct elec_col_writer *elec_col_writer_open(FILE *f, const struct elec_col_desc *cols,
+                                             size_t cols_cnt);
+
+/**
+ * Writes a row group.
+ *
+ * @w A writer.
+ * @data An array of cols_cnt pointers, double arrays for ELEC_COL_F64 and
+ *       ELEC_COL_F32 columns and uint16_t arrays for ELEC_COL_U16 columns.
+ * @rows Number of rows in the arrays.
+ *
+ * @return Zero on success.
+ */
+int elec_col_write(struct elec_col_writer *w, const void *const *data, size_t rows);
+
+/**
+ * Writes the end marker and frees the writer, the stream is not closed.
+ *
+ * @return Zero if everything was written successfully.
+ */
+int elec_col_writer_close(struct elec_col_writer *w);
+
+struct elec_col_info {
+	char name[ELEC_COL_NAME_MAX];
+	enum elec_unit type;
+	elec_unit unit;
+	enum elec_col_storage storage;
+	size_t labels_cnt;
+	char **labels;
+};
+
+struct elec_col_group {
+	size_t rows;
+	/* pointers to the column arrays in the mapped file */
+	const void **data;
+};
+
+struct elec_col_file {
+	void *map;
+	size_t map_len;
+
+	size_t cols_cnt;
+	struct elec_col_info *cols;
+
+	size_t groups_cnt;
+	struct elec_col_group *groups;
+
+	/* total number of rows */
+	size_t rows;
+	/* the end marker was found, i.e. the file is not truncated */
+	int complete;
+};
+
+/**
+ * Maps a file and indexes the row groups.
+ *
+ * @path A path to the file.
+ *
+ * @return A file or NULL on failure with errno set, EINVAL for malformed
+ *         files.
+ */
+struct elec_col_file *elec_col_open(const char *path);
+
+void elec_col_close(struct elec_col_file *f);
+
+/**
+ * Returns column index by name or -1 if not found.
+ */
+int elec_col_find(const struct elec_col_file *f, const char *name);
+
+/**
+ * Returns a value from a column converted to double, label index for
+ * ELEC_COL_U16 columns.
+ */
+static inline double elec_col_get(const struct elec_col_file *f, size_t group,
+                                  size_t col, size_t row)
+{
+	const void *data = f->groups[group].data[col];
+
+	switch (f->cols[col].storage) {
+	case ELEC_COL_F64:
+		return ((const double *)data)[row];
+	case ELEC_COL_F32:
+		return ((const float *)data)[row];
+	case ELEC_COL_U16:
+		return ((const uint16_t *)data)[row];
+	}
+
+	return 0;
+}
+
+/**
+ * Returns a value together with its type and unit.
+ */
+static inline struct elec_val elec_col_val(const struct elec_col_file *f, size_t group,
+                                           size_t col, size_t row)
+{
+	struct elec_val ret = {
+		.type = f->cols[col].type,
+		.val = elec_col_get(f, group, col, row),
+		.unit = f->cols[col].unit,
+	};
+
+	return ret;
+}
+
+/**
+ * Returns a label for a row in ELEC_COL_U16 column or NULL.
+ */
+const char *elec_col_label(const struct elec_col_file *f, size_t group,
+                           size_t col, size_t row);
+
+/**
+ * Copies a column of a row group into a double array.
+ *
+ * ELEC_COL_F64 columns can be used in place via the group data pointer, this
+ * is meant for ELEC_COL_F32 columns.
+ */
+void elec_col_to_f64(const struct elec_col_file *f, size_t group, size_t col, double *out);
+
+#endif /* ELEC_COL_H */
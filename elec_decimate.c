@@ -0,0 +1,32 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#include "elec_decimate.h"
+
+void elec_decimate(const double *y, size_t cnt,
+                   struct elec_decimated *out, size_t buckets)
+{
+	size_t b, i, from, to = 0;
+
+	for (b = 0; b < buckets; b++) {
+		double min = y[to], max = y[to], sum = 0;
+
+		from = to;
+		to = elec_decimate_start(cnt, buckets, b + 1);
+
+		for (i = from; i < to; i++) {
+			min = y[i] < min ? y[i] : min;
+			max = y[i] > max ? y[i] : max;
+			sum += y[i];
+		}
+
+		out[b].min = min;
+		out[b].max = max;
+		out[b].mean = sum / (to - from);
+	}
+}
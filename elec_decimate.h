@@ -0,0 +1,46 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Reduces long series of samples to a few buckets for plotting.
+ */
+
+#ifndef ELEC_DECIMATE_H
+#define ELEC_DECIMATE_H
+
+#include <stddef.h>
+
+struct elec_decimated {
+	double min;
+	double max;
+	double mean;
+};
+
+/**
+ * Splits samples into buckets of (almost) equal size and computes minimum,
+ * maximum and mean for each of them. Drawing a vertical line from min to max
+ * for each bucket preserves all peaks of the original series.
+ *
+ * @y An array of samples.
+ * @cnt A number of samples.
+ * @out An output array of buckets.
+ * @buckets A number of buckets, must not be larger than cnt.
+ */
+void elec_decimate(const double *y, size_t cnt,
+                   struct elec_decimated *out, size_t buckets);
+
+/**
+ * Returns index of the first sample in a bucket, the bucket ends where the
+ * next bucket starts.
+ */
+static inline size_t elec_decimate_start(size_t cnt, size_t buckets, size_t bucket)
+{
+	return (size_t)((unsigned long long)bucket * cnt / buckets);
+}
+
+#endif /* ELEC_DECIMATE_H */
@@ -0,0 +1,217 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#include <math.h>
+#include "elec_divider.h"
+
+/* Errors below this are considered exact match */
+#define EXACT_ERR 1e-12
+
+struct divider_search {
+	const struct elec_divider_params *params;
+	const struct elec_eseries_list *list;
+	double total_min;
+	double total_max;
+	struct elec_divider *res;
+	size_t k;
+	size_t cnt;
+};
+
+static int divider_worse(const struct elec_divider *a, const struct elec_divider *b)
+{
+	double ea = fabs(a->err), eb = fabs(b->err);
+
+	if (fabs(ea - eb) > EXACT_ERR)
+		return ea > eb;
+
+	return a->current > b->current;
+}
+
+static int search_full_exact(struct divider_search *s)
+{
+	return s->cnt == s->k && fabs(s->res[s->k - 1].err) <= EXACT_ERR;
+}
+
+static void divider_add(struct divider_search *s, double r_top, double r_top2,
+                        double r_bot, double r_bot2)
+{
+	const struct elec_divider_params *p = s->params;
+	double top = r_top + r_top2, bot = r_bot + r_bot2;
+	double total = top + bot;
+	struct elec_divider d = {
+		.r_top = r_top,
+		.r_top2 = r_top2,
+		.r_bot = r_bot,
+		.r_bot2 = r_bot2,
+		.ratio = bot / total,
+		.current = p->vin / total,
+	};
+	size_t i;
+
+	if (total < s->total_min || total > s->total_max)
+		return;
+
+	d.err = (d.ratio - p->ratio) / p->ratio;
+
+	if (s->cnt == s->k && !divider_worse(&s->res[s->k - 1], &d))
+		return;
+
+	/* Insertion into a short sorted array */
+	i = s->cnt < s->k ? s->cnt++ : s->k - 1;
+
+	while (i > 0 && divider_worse(&s->res[i - 1], &d)) {
+		s->res[i] = s->res[i - 1];
+		i--;
+	}
+
+	s->res[i] = d;
+}
+
+static size_t lower_bound(const struct elec_eseries_list *list, double val)
+{
+	size_t l = 0, r = list->cnt;
+
+	while (l < r) {
+		size_t m = (l + r) / 2;
+
+		if (list->vals[m] < val)
+			l = m + 1;
+		else
+			r = m;
+	}
+
+	return l;
+}
+
+/*
+ * Finds the closest sum of two values from the list to the target by walking
+ * the values not bigger than target from both ends.
+ */
+static int closest_pair(const struct elec_eseries_list *list, double target,
+                        double *r1, double *r2)
+{
+	const double *v = list->vals;
+	size_t i = 0, j = lower_bound(list, target);
+	double best = INFINITY;
+
+	if (!j)
+		return 1;
+
+	j--;
+
+	while (i <= j) {
+		double sum = v[i] + v[j];
+
+		if (fabs(sum - target) < best) {
+			best = fabs(sum - target);
+			*r1 = v[j];
+			*r2 = v[i];
+		}
+
+		if (sum < target)
+			i++;
+		else if (j)
+			j--;
+		else
+			break;
+	}
+
+	return 0;
+}
+
+/*
+ * Iterates over the fixed resistor from the largest one, i.e. from the lowest
+ * divider current, so that once we have k exact matches we can stop.
+ */
+static void divider_pass(struct divider_search *s, int fixed_bot)
+{
+	const struct elec_divider_params *p = s->params;
+	const struct elec_eseries_list *list = s->list;
+	double fixed_ratio = fixed_bot ? p->ratio : 1 - p->ratio;
+	double mul = (1 - fixed_ratio) / fixed_ratio;
+	size_t i, j;
+
+	for (i = list->cnt; i-- > 0;) {
+		double fixed = list->vals[i];
+		double ideal = fixed * mul;
+		double total = fixed / fixed_ratio;
+		double r1 = 0, r2 = 0;
+
+		if (search_full_exact(s))
+			return;
+
+		/* Prune dividers way outside of the current budget */
+		if (total > 2 * s->total_max)
+			continue;
+
+		if (total < s->total_min / 2)
+			return;
+
+		/* Two closest values for the other resistor */
+		j = lower_bound(list, ideal);
+
+		/* Single resistor dividers are found in the first pass */
+		if (fixed_bot) {
+			if (j < list->cnt)
+				divider_add(s, list->vals[j], 0, fixed, 0);
+
+			if (j > 0)
+				divider_add(s, list->vals[j-1], 0, fixed, 0);
+		}
+
+		if (!p->three)
+			continue;
+
+		/* No need to look for a pair if the single value is exact */
+		if (j < list->cnt && fabs(list->vals[j] - ideal) <= EXACT_ERR * ideal)
+			continue;
+
+		if (closest_pair(list, ideal, &r1, &r2))
+			continue;
+
+		if (fixed_bot)
+			divider_add(s, r1, r2, fixed, 0);
+		else
+			divider_add(s, fixed, 0, r1, r2);
+	}
+}
+
+int elec_divider_search(const struct elec_divider_params *params,
+                        struct elec_divider *res, size_t k)
+{
+	struct elec_eseries_list list;
+	struct divider_search s = {
+		.params = params,
+		.list = &list,
+		.total_min = 0,
+		.total_max = INFINITY,
+		.res = res,
+		.k = k,
+	};
+
+	if (!k || !(params->ratio > 0) || !(params->ratio < 1))
+		return -1;
+
+	if (params->vin > 0 && params->i_max > 0)
+		s.total_min = params->vin / params->i_max;
+
+	if (params->vin > 0 && params->i_min > 0)
+		s.total_max = params->vin / params->i_min;
+
+	if (elec_eseries_list_init(&list, params->series, params->r_min, params->r_max))
+		return -1;
+
+	divider_pass(&s, 1);
+
+	if (params->three)
+		divider_pass(&s, 0);
+
+	elec_eseries_list_exit(&list);
+
+	return s.cnt;
+}
@@ -0,0 +1,70 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Resistor divider synthesis from E-series values.
+ *
+ * The divider ratio is Vout/Vin = Rbot / (Rtop + Rbot), for a regulator
+ * feedback network set Vin to the regulator output voltage and Vout to the
+ * feedback reference voltage.
+ */
+
+#ifndef ELEC_DIVIDER_H
+#define ELEC_DIVIDER_H
+
+#include <stddef.h>
+#include "elec_eseries.h"
+
+struct elec_divider_params {
+	/* E-series and range of resistors to use */
+	enum elec_eseries series;
+	double r_min;
+	double r_max;
+
+	/* target ratio Vout/Vin */
+	double ratio;
+
+	/* input voltage, used only for current limits, may be 0 */
+	double vin;
+	/* current through the divider limits in A, 0 means no limit */
+	double i_min;
+	double i_max;
+
+	/* allow replacing one of the resistors with two in series */
+	int three;
+};
+
+struct elec_divider {
+	/* r_top2 and r_bot2 are zero if unused */
+	double r_top;
+	double r_top2;
+	double r_bot;
+	double r_bot2;
+
+	double ratio;
+	/* relative error of the ratio */
+	double err;
+	/* current through the divider at vin */
+	double current;
+};
+
+/**
+ * Searches for k best dividers ranked by the absolute value of the ratio error
+ * and then by the divider current.
+ *
+ * @params Search parameters.
+ * @res An array of at least k results.
+ * @k Number of results to return.
+ *
+ * @return Number of results found or -1 on invalid parameters or allocation
+ *         failure.
+ */
+int elec_divider_search(const struct elec_divider_params *params,
+                        struct elec_divider *res, size_t k);
+
+#endif /* ELEC_DIVIDER_H */
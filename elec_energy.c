@@ -0,0 +1,115 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#include <math.h>
+#include "libelec.h"
+#include "elec_energy.h"
+
+#define BLOCK 256
+
+void elec_energy_init(struct elec_energy *energy)
+{
+	*energy = (struct elec_energy) {
+		.peak = -INFINITY,
+		.peak_time = NAN,
+		.first_time = NAN,
+		.last_time = NAN,
+	};
+}
+
+/*
+ * Computes losses for a block of samples, the loop has no branches so that
+ * it vectorizes.
+ */
+static void block_power(const struct elec_energy_params *params,
+                        const double *restrict current, const double *restrict temp,
+                        double *restrict power, size_t cnt)
+{
+	double a = params->r_ref * params->tc;
+	double b = params->r_ref - a * ELEC_TEMP_REF;
+	size_t i;
+
+	if (!temp) {
+		double r = a * params->temp + b;
+
+		for (i = 0; i < cnt; i++)
+			power[i] = current[i] * current[i] * r;
+
+		return;
+	}
+
+	for (i = 0; i < cnt; i++)
+		power[i] = current[i] * current[i] * (a * temp[i] + b);
+}
+
+void elec_energy_batch(struct elec_energy *energy, const struct elec_energy_params *params,
+                       const double *time, const double *current, const double *temp,
+                       size_t cnt)
+{
+	double power[BLOCK];
+	size_t i, j, n;
+
+	for (i = 0; i < cnt; i += n) {
+		double sum = 0, peak = energy->peak;
+		size_t peak_idx = BLOCK;
+
+		n = cnt - i < BLOCK ? cnt - i : BLOCK;
+
+		block_power(params, current + i, temp ? temp + i : NULL, power, n);
+
+		for (j = 1; j < n; j++)
+			sum += (time[i + j] - time[i + j - 1]) * (power[j] + power[j - 1]);
+
+		for (j = 0; j < n; j++) {
+			if (power[j] > peak) {
+				peak = power[j];
+				peak_idx = j;
+			}
+		}
+
+		if (peak_idx != BLOCK) {
+			energy->peak = peak;
+			energy->peak_time = time[i + peak_idx];
+		}
+
+		if (energy->cnt) {
+			sum += (time[i] - energy->last_time) * (power[0] + energy->last_power);
+		} else {
+			energy->first_time = time[i];
+			energy->first_power = power[0];
+		}
+
+		energy->energy += sum / 2;
+		energy->cnt += n;
+		energy->last_time = time[i + n - 1];
+		energy->last_power = power[n - 1];
+	}
+}
+
+void elec_energy_merge(struct elec_energy *dst, const struct elec_energy *src)
+{
+	if (!src->cnt)
+		return;
+
+	if (!dst->cnt) {
+		*dst = *src;
+		return;
+	}
+
+	dst->energy += src->energy;
+	dst->energy += (src->first_time - dst->last_time) * (src->first_power + dst->last_power) / 2;
+
+	if (src->peak > dst->peak) {
+		dst->peak = src->peak;
+		dst->peak_time = src->peak_time;
+	}
+
+	dst->cnt += src->cnt;
+	dst->last_time = src->last_time;
+	dst->last_power = src->last_power;
+}
@@ -0,0 +1,69 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * I²R energy losses integrated over a load profile.
+ *
+ * The profile is a time series of current samples, the losses are
+ * integrated with the trapezoidal rule between consecutive samples. The
+ * resistance may be corrected for the conductor temperature per sample.
+ *
+ * A profile can be split into consecutive parts that are integrated
+ * independently and merged in time order afterwards.
+ */
+
+#ifndef ELEC_ENERGY_H
+#define ELEC_ENERGY_H
+
+#include <stddef.h>
+
+struct elec_energy_params {
+	/* resistance at ELEC_TEMP_REF in Ohm */
+	double r_ref;
+	/* resistance temperature coefficient in 1/K */
+	double tc;
+	/* conductor temperature in °C used when there are no per sample temperatures */
+	double temp;
+};
+
+struct elec_energy {
+	size_t cnt;
+	/* J */
+	double energy;
+	/* peak loss in W and time it happened */
+	double peak;
+	double peak_time;
+	/* first and last sample, needed for merging */
+	double first_time;
+	double first_power;
+	double last_time;
+	double last_power;
+};
+
+void elec_energy_init(struct elec_energy *energy);
+
+/**
+ * Integrates next part of the profile.
+ *
+ * @energy An integrator state.
+ * @params A conductor parameters.
+ * @time An array of sample times in s in ascending order.
+ * @current An array of currents in A.
+ * @temp An array of conductor temperatures in °C, may be NULL.
+ * @cnt A number of samples.
+ */
+void elec_energy_batch(struct elec_energy *energy, const struct elec_energy_params *params,
+                       const double *time, const double *current, const double *temp,
+                       size_t cnt);
+
+/**
+ * Appends integrated part of the profile that follows dst in time.
+ */
+void elec_energy_merge(struct elec_energy *dst, const struct elec_energy *src);
+
+#endif /* ELEC_ENERGY_H */
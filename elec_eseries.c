@@ -0,0 +1,311 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include "elec_eseries.h"
+#include "elec_par.h"
+
+/* E3 to E24 use two digits precision */
+static const unsigned short e24[24] = {
+	10, 11, 12, 13, 15, 16, 18, 20, 22, 24, 27, 30,
+	33, 36, 39, 43, 47, 51, 56, 62, 68, 75, 82, 91,
+};
+
+/* E48 to E192 use three digits precision */
+static const unsigned short e192[192] = {
+	100, 101, 102, 104, 105, 106, 107, 109, 110, 111, 113, 114,
+	115, 117, 118, 120, 121, 123, 124, 126, 127, 129, 130, 132,
+	133, 135, 137, 138, 140, 142, 143, 145, 147, 149, 150, 152,
+	154, 156, 158, 160, 162, 164, 165, 167, 169, 172, 174, 176,
+	178, 180, 182, 184, 187, 189, 191, 193, 196, 198, 200, 203,
+	205, 208, 210, 213, 215, 218, 221, 223, 226, 229, 232, 234,
+	237, 240, 243, 246, 249, 252, 255, 258, 261, 264, 267, 271,
+	274, 277, 280, 284, 287, 291, 294, 298, 301, 305, 309, 312,
+	316, 320, 324, 328, 332, 336, 340, 344, 348, 352, 357, 361,
+	365, 370, 374, 379, 383, 388, 392, 397, 402, 407, 412, 417,
+	422, 427, 432, 437, 442, 448, 453, 459, 464, 470, 475, 481,
+	487, 493, 499, 505, 511, 517, 523, 530, 536, 542, 549, 556,
+	562, 569, 576, 583, 590, 597, 604, 612, 619, 626, 634, 642,
+	649, 657, 665, 673, 681, 690, 698, 706, 715, 723, 732, 741,
+	750, 759, 768, 777, 787, 796, 806, 816, 825, 835, 845, 856,
+	866, 876, 887, 898, 909, 920, 931, 942, 953, 965, 976, 988,
+};
+
+static const struct eseries_desc {
+	const char *name;
+	const unsigned short *base;
+	unsigned int step;
+	unsigned int cnt;
+	double div;
+} eseries[ELEC_ESERIES_CNT] = {
+	[ELEC_E6] = {"E6", e24, 4, 6, 10},
+	[ELEC_E12] = {"E12", e24, 2, 12, 10},
+	[ELEC_E24] = {"E24", e24, 1, 24, 10},
+	[ELEC_E48] = {"E48", e192, 4, 48, 100},
+	[ELEC_E96] = {"E96", e192, 2, 96, 100},
+	[ELEC_E192] = {"E192", e192, 1, 192, 100},
+};
+
+static double eseries_val(const struct eseries_desc *desc, unsigned int i)
+{
+	if (i >= desc->cnt)
+		return 10;
+
+	return desc->base[i * desc->step] / desc->div;
+}
+
+const char *elec_eseries_name(enum elec_eseries series)
+{
+	if (series >= ELEC_ESERIES_CNT)
+		return "invalid";
+
+	return eseries[series].name;
+}
+
+enum elec_eseries elec_eseries_by_name(const char *name)
+{
+	enum elec_eseries i;
+
+	for (i = 0; i < ELEC_ESERIES_CNT; i++) {
+		if (!strcasecmp(eseries[i].name, name))
+			return i;
+	}
+
+	return ELEC_ESERIES_CNT;
+}
+
+double elec_eseries_nearest(enum elec_eseries series, double val)
+{
+	const struct eseries_desc *desc;
+	unsigned int l = 0, r;
+	double decade, mantissa, lo, hi;
+
+	if (series >= ELEC_ESERIES_CNT || !(val > 0) || isinf(val))
+		return NAN;
+
+	desc = &eseries[series];
+	r = desc->cnt;
+
+	decade = pow(10, floor(log10(val)));
+	mantissa = val / decade;
+
+	/* rounding in log10() may put us just below or above the decade */
+	if (mantissa < 1) {
+		decade /= 10;
+		mantissa *= 10;
+	} else if (mantissa >= 10) {
+		decade *= 10;
+		mantissa /= 10;
+	}
+
+	/* Finds first value greater than mantissa, the last one is 10 */
+	while (l < r) {
+		unsigned int m = (l + r) / 2;
+
+		if (eseries_val(desc, m) <= mantissa)
+			l = m + 1;
+		else
+			r = m;
+	}
+
+	lo = eseries_val(desc, l - 1);
+	hi = eseries_val(desc, l);
+
+	/* Compare against geometric mean so that relative error is minimized */
+	if (mantissa * mantissa < lo * hi)
+		return lo * decade;
+
+	return hi * decade;
+}
+
+void elec_eseries_snap(struct elec_val *value, enum elec_eseries series)
+{
+	elec_unit unit = value->unit;
+
+	elec_unit_convert(value, ELEC_UNIT_OHM);
+	value->val = elec_eseries_nearest(series, value->val);
+	elec_unit_convert(value, unit);
+}
+
+int elec_eseries_list_init(struct elec_eseries_list *list,
+                           enum elec_eseries series, double min, double max)
+{
+	const struct eseries_desc *desc;
+	double decade;
+	size_t cnt = 0, size;
+	unsigned int i;
+
+	list->series = series;
+	list->vals = NULL;
+	list->cnt = 0;
+
+	if (series >= ELEC_ESERIES_CNT || !(min > 0) || !(max >= min) || isinf(max))
+		return 1;
+
+	desc = &eseries[series];
+
+	min = elec_eseries_nearest(series, min);
+	max = elec_eseries_nearest(series, max);
+
+	size = (log10(max / min) + 2) * desc->cnt;
+
+	list->vals = malloc(size * sizeof(double));
+	if (!list->vals)
+		return 1;
+
+	decade = pow(10, floor(log10(min) + 1e-9));
+
+	while (cnt < size) {
+		for (i = 0; i < desc->cnt && cnt < size; i++) {
+			double val = eseries_val(desc, i) * decade;
+
+			if (val > max * (1 + 1e-9))
+				goto done;
+
+			if (val >= min * (1 - 1e-9))
+				list->vals[cnt++] = val;
+		}
+
+		decade *= 10;
+	}
+done:
+	list->cnt = cnt;
+
+	return 0;
+}
+
+void elec_eseries_list_exit(struct elec_eseries_list *list)
+{
+	free(list->vals);
+	list->vals = NULL;
+	list->cnt = 0;
+}
+
+static double list_nearest(const struct elec_eseries_list *list, double val)
+{
+	size_t l = 0, r = list->cnt;
+
+	while (l < r) {
+		size_t m = (l + r) / 2;
+
+		if (list->vals[m] < val)
+			l = m + 1;
+		else
+			r = m;
+	}
+
+	if (l == list->cnt)
+		return list->vals[l - 1];
+
+	if (l == 0)
+		return list->vals[0];
+
+	if (val * val < list->vals[l - 1] * list->vals[l])
+		return list->vals[l - 1];
+
+	return list->vals[l];
+}
+
+static void pair_update(struct elec_eseries_pair *best, enum elec_eseries_comb comb,
+                        double r1, double r2, double val, double target)
+{
+	double err = (val - target) / target;
+
+	if (fabs(err) >= fabs(best->err))
+		return;
+
+	best->comb = comb;
+	best->r1 = r1;
+	best->r2 = r2;
+	best->val = val;
+	best->err = err;
+}
+
+int elec_eseries_pair(const struct elec_eseries_list *list, double target,
+                      struct elec_eseries_pair *res)
+{
+	const double *v = list->vals;
+	size_t i, j;
+
+	res->err = INFINITY;
+	res->r1 = res->r2 = res->val = NAN;
+	res->comb = ELEC_ESERIES_SINGLE;
+
+	if (!list->cnt || !(target > 0))
+		return 1;
+
+	double single = list_nearest(list, target);
+
+	pair_update(res, ELEC_ESERIES_SINGLE, single, NAN, single, target);
+
+	/* R1 + R2 grows with both i and j */
+	for (i = 0, j = list->cnt - 1; i <= j;) {
+		double val = v[i] + v[j];
+
+		pair_update(res, ELEC_ESERIES_SERIES, v[i], v[j], val, target);
+
+		if (val < target)
+			i++;
+		else if (j)
+			j--;
+		else
+			break;
+	}
+
+	/* So does R1 || R2 */
+	for (i = 0, j = list->cnt - 1; i <= j;) {
+		double val = v[i] * v[j] / (v[i] + v[j]);
+
+		pair_update(res, ELEC_ESERIES_PARALLEL, v[i], v[j], val, target);
+
+		if (val < target)
+			i++;
+		else if (j)
+			j--;
+		else
+			break;
+	}
+
+	return 0;
+}
+
+struct pair_batch {
+	const struct elec_eseries_list *list;
+	const double *targets;
+	struct elec_eseries_pair *res;
+	size_t failed;
+};
+
+static void pair_batch_range(void *priv, size_t from, size_t to)
+{
+	struct pair_batch *batch = priv;
+	size_t i, failed = 0;
+
+	for (i = from; i < to; i++)
+		failed += !!elec_eseries_pair(batch->list, batch->targets[i], &batch->res[i]);
+
+	__atomic_add_fetch(&batch->failed, failed, __ATOMIC_RELAXED);
+}
+
+size_t elec_eseries_pair_batch(const struct elec_eseries_list *list,
+                               const double *targets,
+                               struct elec_eseries_pair *res, size_t cnt)
+{
+	struct pair_batch batch = {
+		.list = list,
+		.targets = targets,
+		.res = res,
+	};
+
+	elec_par_for(cnt, 0, pair_batch_range, &batch);
+
+	return batch.failed;
+}
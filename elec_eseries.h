@@ -0,0 +1,123 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * IEC 60063 E-series of preferred resistor values.
+ */
+
+#ifndef ELEC_ESERIES_H
+#define ELEC_ESERIES_H
+
+#include <stddef.h>
+#include "libelec.h"
+
+enum elec_eseries {
+	ELEC_E6,
+	ELEC_E12,
+	ELEC_E24,
+	ELEC_E48,
+	ELEC_E96,
+	ELEC_E192,
+	ELEC_ESERIES_CNT,
+};
+
+/**
+ * Returns E-series name e.g. "E24".
+ */
+const char *elec_eseries_name(enum elec_eseries series);
+
+/**
+ * Looks up E-series by a name, returns ELEC_ESERIES_CNT if not found.
+ */
+enum elec_eseries elec_eseries_by_name(const char *name);
+
+/**
+ * Returns a value from series closest to the val.
+ *
+ * The closest value is searched in logarithmic scale i.e. the relative error
+ * is minimized.
+ *
+ * @series An E-series.
+ * @val A positive value.
+ *
+ * @return A closest value from the series or NAN if val is not positive or
+ *         the series is invalid.
+ */
+double elec_eseries_nearest(enum elec_eseries series, double val);
+
+/**
+ * Snaps a resistance to the closest value from the series, the unit is
+ * preserved.
+ */
+void elec_eseries_snap(struct elec_val *value, enum elec_eseries series);
+
+/**
+ * A sorted list of E-series values spanning several decades.
+ */
+struct elec_eseries_list {
+	enum elec_eseries series;
+	size_t cnt;
+	double *vals;
+};
+
+/**
+ * Fills in the list with all values from series in [min, max] range.
+ *
+ * @return Zero on success, non-zero on allocation failure or invalid range.
+ */
+int elec_eseries_list_init(struct elec_eseries_list *list,
+                           enum elec_eseries series, double min, double max);
+
+void elec_eseries_list_exit(struct elec_eseries_list *list);
+
+enum elec_eseries_comb {
+	ELEC_ESERIES_SINGLE,
+	ELEC_ESERIES_SERIES,
+	ELEC_ESERIES_PARALLEL,
+};
+
+/**
+ * Result of a search for a resistor combination.
+ */
+struct elec_eseries_pair {
+	enum elec_eseries_comb comb;
+	/* resistors, r2 is unused for ELEC_ESERIES_SINGLE */
+	double r1;
+	double r2;
+	/* resulting resistance */
+	double val;
+	/* relative error (val - target) / target */
+	double err;
+};
+
+/**
+ * Finds a single value or a series or parallel combination of two values from
+ * the list closest to the target.
+ *
+ * Runs in O(n) since both series and parallel combinations are monotonic in
+ * both resistors so that a two pointer search on the sorted list can be used.
+ *
+ * @list A list of available values.
+ * @target A target resistance.
+ * @res A best match.
+ *
+ * @return Zero on success, non-zero if list is empty or target not positive.
+ */
+int elec_eseries_pair(const struct elec_eseries_list *list, double target,
+                      struct elec_eseries_pair *res);
+
+/**
+ * Runs elec_eseries_pair() for an array of targets in parallel.
+ *
+ * @return Number of targets that failed.
+ */
+size_t elec_eseries_pair_batch(const struct elec_eseries_list *list,
+                               const double *targets,
+                               struct elec_eseries_pair *res, size_t cnt);
+
+#endif /* ELEC_ESERIES_H */
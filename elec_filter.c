@@ -0,0 +1,166 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#include <math.h>
+#include "elec_par.h"
+#include "elec_filter.h"
+
+/* Sweeps shorter than this are not worth starting threads for */
+#define PAR_MIN 65536
+
+const char *const elec_filter_names[ELEC_FILTER_CNT] = {
+	"RC low pass",
+	"RC high pass",
+	"RL low pass",
+	"RL high pass",
+	"RLC low pass",
+	"RLC high pass",
+	"RLC band pass",
+	"RLC band stop",
+};
+
+struct coefs {
+	double b[3];
+	double a[3];
+};
+
+static void filter_coefs(const struct elec_filter *f, struct coefs *c)
+{
+	double rc = f->r * f->c, lr = f->l / f->r, lc = f->l * f->c;
+
+	*c = (struct coefs) {};
+
+	switch (f->type) {
+	case ELEC_FILTER_RC_LOW:
+		c->b[0] = 1;
+		c->a[0] = 1;
+		c->a[1] = rc;
+	break;
+	case ELEC_FILTER_RC_HIGH:
+		c->b[1] = rc;
+		c->a[0] = 1;
+		c->a[1] = rc;
+	break;
+	case ELEC_FILTER_RL_LOW:
+		c->b[0] = 1;
+		c->a[0] = 1;
+		c->a[1] = lr;
+	break;
+	case ELEC_FILTER_RL_HIGH:
+		c->b[1] = lr;
+		c->a[0] = 1;
+		c->a[1] = lr;
+	break;
+	case ELEC_FILTER_RLC_LOW:
+		c->b[0] = 1;
+	break;
+	case ELEC_FILTER_RLC_HIGH:
+		c->b[2] = lc;
+	break;
+	case ELEC_FILTER_RLC_BAND:
+		c->b[1] = rc;
+	break;
+	case ELEC_FILTER_RLC_NOTCH:
+		c->b[0] = 1;
+		c->b[2] = lc;
+	break;
+	case ELEC_FILTER_CNT:
+	break;
+	}
+
+	if (f->type >= ELEC_FILTER_RLC_LOW) {
+		c->a[0] = 1;
+		c->a[1] = rc;
+		c->a[2] = lc;
+	}
+}
+
+double elec_filter_f0(const struct elec_filter *filter)
+{
+	switch (filter->type) {
+	case ELEC_FILTER_RC_LOW:
+	case ELEC_FILTER_RC_HIGH:
+		return 1 / (2 * M_PI * filter->r * filter->c);
+	case ELEC_FILTER_RL_LOW:
+	case ELEC_FILTER_RL_HIGH:
+		return filter->r / (2 * M_PI * filter->l);
+	default:
+		return 1 / (2 * M_PI * sqrt(filter->l * filter->c));
+	}
+}
+
+double elec_filter_q(const struct elec_filter *filter)
+{
+	if (filter->type < ELEC_FILTER_RLC_LOW)
+		return NAN;
+
+	return sqrt(filter->l / filter->c) / filter->r;
+}
+
+struct response {
+	struct coefs c;
+	const double *freq;
+	double *mag_db;
+	double *phase_deg;
+};
+
+#define BLOCK 256
+
+/*
+ * The complex division is done on split real and imaginary parts in a loop
+ * without calls so that it vectorizes, the transcendental functions are
+ * evaluated in a second pass over the block.
+ */
+static void response_range(void *priv, size_t from, size_t to)
+{
+	struct response *r = priv;
+	const double *b = r->c.b, *a = r->c.a;
+	double mag2[BLOCK], re[BLOCK], im[BLOCK];
+	size_t i, j, n;
+
+	for (i = from; i < to; i += n) {
+		n = to - i < BLOCK ? to - i : BLOCK;
+
+		for (j = 0; j < n; j++) {
+			double w = 2 * M_PI * r->freq[i + j];
+			double w2 = w * w;
+			double n_re = b[0] - b[2] * w2, n_im = b[1] * w;
+			double d_re = a[0] - a[2] * w2, d_im = a[1] * w;
+			double d2 = d_re * d_re + d_im * d_im;
+
+			/* H * |D|² = N * conj(D) */
+			re[j] = n_re * d_re + n_im * d_im;
+			im[j] = n_im * d_re - n_re * d_im;
+			mag2[j] = (n_re * n_re + n_im * n_im) / d2;
+		}
+
+		for (j = 0; j < n; j++) {
+			r->mag_db[i + j] = 10 * log10(mag2[j]);
+			r->phase_deg[i + j] = atan2(im[j], re[j]) * (180 / M_PI);
+		}
+	}
+}
+
+void elec_filter_response(const struct elec_filter *filter, const double *freq,
+                          double *mag_db, double *phase_deg, size_t cnt)
+{
+	struct response r = {
+		.freq = freq,
+		.mag_db = mag_db,
+		.phase_deg = phase_deg,
+	};
+
+	filter_coefs(filter, &r.c);
+
+	if (cnt < PAR_MIN) {
+		response_range(&r, 0, cnt);
+		return;
+	}
+
+	elec_par_for(cnt, 0, response_range, &r);
+}
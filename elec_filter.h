@@ -0,0 +1,81 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Frequency response of passive RC, RL and series RLC filters.
+ *
+ * All the filters are written as a second order transfer function
+ *
+ *         b0 + b1 s + b2 s²
+ * H(s) = -------------------
+ *         a0 + a1 s + a2 s²
+ *
+ * evaluated at s = j 2 pi f. The filters are unloaded, i.e. the output is
+ * connected to an infinite impedance.
+ */
+
+#ifndef ELEC_FILTER_H
+#define ELEC_FILTER_H
+
+#include <stddef.h>
+
+enum elec_filter_type {
+	/* series R, output across C */
+	ELEC_FILTER_RC_LOW,
+	/* series C, output across R */
+	ELEC_FILTER_RC_HIGH,
+	/* series L, output across R */
+	ELEC_FILTER_RL_LOW,
+	/* series R, output across L */
+	ELEC_FILTER_RL_HIGH,
+	/* series RLC, output across C */
+	ELEC_FILTER_RLC_LOW,
+	/* series RLC, output across L */
+	ELEC_FILTER_RLC_HIGH,
+	/* series RLC, output across R */
+	ELEC_FILTER_RLC_BAND,
+	/* series RLC, output across L and C */
+	ELEC_FILTER_RLC_NOTCH,
+	ELEC_FILTER_CNT,
+};
+
+extern const char *const elec_filter_names[ELEC_FILTER_CNT];
+
+struct elec_filter {
+	enum elec_filter_type type;
+	/* resistance in Ohm, inductance in H, capacitance in F */
+	double r;
+	double l;
+	double c;
+};
+
+/**
+ * Returns filter corner frequency in Hz, resonant frequency for RLC filters.
+ */
+double elec_filter_f0(const struct elec_filter *filter);
+
+/**
+ * Returns quality factor of RLC filters, NAN for first order filters.
+ */
+double elec_filter_q(const struct elec_filter *filter);
+
+/**
+ * Computes magnitude and phase for an array of frequencies.
+ *
+ * Large sweeps are split between all CPUs.
+ *
+ * @filter A filter description.
+ * @freq An array of frequencies in Hz.
+ * @mag_db An output array of magnitudes in dB.
+ * @phase_deg An output array of phase shifts in degrees.
+ * @cnt A size of the arrays.
+ */
+void elec_filter_response(const struct elec_filter *filter, const double *freq,
+                          double *mag_db, double *phase_deg, size_t cnt);
+
+#endif /* ELEC_FILTER_H */
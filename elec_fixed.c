@@ -0,0 +1,656 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#include <stddef.h>
+#include "elec_fixed.h"
+
+/*
+ * Unsigned 128bit arithmetics, native where the compiler supports it and
+ * emulated with 64bit halves on 32bit targets. The emulation can be forced
+ * with ELEC_FIXED_NO_INT128.
+ */
+#if defined(__SIZEOF_INT128__) && !defined(ELEC_FIXED_NO_INT128)
+
+typedef unsigned __int128 u128;
+
+static inline u128 mul_64(uint64_t a, uint64_t b)
+{
+	return (u128)a * b;
+}
+
+static inline u128 add_64(u128 a, uint64_t b)
+{
+	return a + b;
+}
+
+static inline int lt_128(u128 a, u128 b)
+{
+	return a < b;
+}
+
+static inline unsigned int bits_128(u128 a)
+{
+	if (a >> 64)
+		return 128 - __builtin_clzll(a >> 64);
+
+	return a ? 64 - __builtin_clzll(a) : 0;
+}
+
+/* Returns non-zero if the quotient does not fit into 64 bits */
+static inline int div_64(u128 a, uint64_t b, uint64_t *res)
+{
+	if ((uint64_t)(a >> 64) >= b)
+		return 1;
+
+	*res = a / b;
+	return 0;
+}
+
+#else
+
+typedef struct {
+	uint64_t hi;
+	uint64_t lo;
+} u128;
+
+static u128 mul_64(uint64_t a, uint64_t b)
+{
+	uint64_t a_lo = a & 0xffffffff, a_hi = a >> 32;
+	uint64_t b_lo = b & 0xffffffff, b_hi = b >> 32;
+	uint64_t ll = a_lo * b_lo, lh = a_lo * b_hi;
+	uint64_t hl = a_hi * b_lo, hh = a_hi * b_hi;
+	uint64_t mid = (ll >> 32) + (lh & 0xffffffff) + (hl & 0xffffffff);
+	u128 ret;
+
+	ret.lo = (mid << 32) | (ll & 0xffffffff);
+	ret.hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+
+	return ret;
+}
+
+static u128 add_64(u128 a, uint64_t b)
+{
+	a.lo += b;
+	a.hi += a.lo < b;
+
+	return a;
+}
+
+static int lt_128(u128 a, u128 b)
+{
+	return a.hi < b.hi || (a.hi == b.hi && a.lo < b.lo);
+}
+
+static unsigned int bits_128(u128 a)
+{
+	if (a.hi)
+		return 128 - __builtin_clzll(a.hi);
+
+	return a.lo ? 64 - __builtin_clzll(a.lo) : 0;
+}
+
+static int div_64(u128 a, uint64_t b, uint64_t *res)
+{
+	uint64_t r = a.hi, q = 0;
+	int i;
+
+	if (r >= b)
+		return 1;
+
+	/* Long division, the remainder always fits into 64 bits */
+	for (i = 63; i >= 0; i--) {
+		uint64_t carry = r >> 63;
+
+		r = (r << 1) | ((a.lo >> i) & 1);
+
+		if (carry || r >= b) {
+			r -= b;
+			q |= 1ull << i;
+		}
+	}
+
+	*res = q;
+	return 0;
+}
+
+#endif
+
+/* Rounded a * b / c */
+static int muldiv_u(uint64_t a, uint64_t b, uint64_t c, uint64_t *res)
+{
+	if (!c)
+		return 1;
+
+	return div_64(add_64(mul_64(a, b), c / 2), c, res);
+}
+
+static inline uint64_t abs_64(int64_t a)
+{
+	return a < 0 ? -(uint64_t)a : (uint64_t)a;
+}
+
+static int muldiv(int64_t a, int64_t b, int64_t c, int64_t *res)
+{
+	int neg = (a < 0) ^ (b < 0) ^ (c < 0);
+	uint64_t r;
+
+	if (muldiv_u(abs_64(a), abs_64(b), abs_64(c), &r) || r > INT64_MAX)
+		return 1;
+
+	*res = neg ? -(int64_t)r : (int64_t)r;
+	return 0;
+}
+
+/* Rounded square root */
+static uint64_t isqrt_128(u128 n)
+{
+	unsigned int bits = bits_128(n);
+	uint64_t x, q, y;
+
+	if (!bits)
+		return 0;
+
+	/* Starts above the root so that the iteration decreases monotonically */
+	x = bits > 126 ? UINT64_MAX : 1ull << ((bits + 1) / 2);
+
+	for (;;) {
+		if (div_64(n, x, &q))
+			break;
+
+		y = x / 2 + q / 2 + (x & q & 1);
+		if (y >= x)
+			break;
+
+		x = y;
+	}
+
+	/* (x + 0.5)² < n */
+	if (lt_128(add_64(mul_64(x, x), x), n))
+		x++;
+
+	return x;
+}
+
+#define S6 1000000ll
+#define S9 1000000000ll
+#define S12 1000000000000ll
+#define S18 1000000000000000000ll
+
+/* π/4 and 4/π scaled by 1e18 */
+#define PI_4 785398163397448310ull
+#define INV_PI_4 1273239544735162686ull
+
+struct ratio {
+	/* base units per unit as num/den */
+	int64_t num;
+	int64_t den;
+};
+
+static const struct ratio length_ratio[ELEC_UNIT_LENGTH_CNT] = {
+	[ELEC_UNIT_KM] = {1000 * S9, 1},
+	[ELEC_UNIT_M] = {S9, 1},
+	[ELEC_UNIT_DM] = {100000000, 1},
+	[ELEC_UNIT_CM] = {10000000, 1},
+	[ELEC_UNIT_MM] = {S6, 1},
+	[ELEC_UNIT_INCH] = {25400000, 1},
+	[ELEC_UNIT_FOOT] = {304800000, 1},
+};
+
+static const struct ratio area_ratio[ELEC_UNIT_AREA_CNT] = {
+	[ELEC_UNIT_M2] = {S18, 1},
+	[ELEC_UNIT_DM2] = {S18 / 100, 1},
+	[ELEC_UNIT_CM2] = {S18 / 10000, 1},
+	[ELEC_UNIT_MM2] = {S12, 1},
+	/* AWG is handled separately */
+	[ELEC_UNIT_AWG] = {0, 1},
+};
+
+static const struct ratio mass_ratio[ELEC_UNIT_MASS_CNT] = {
+	[ELEC_UNIT_T] = {S12, 1},
+	[ELEC_UNIT_kG] = {S9, 1},
+	[ELEC_UNIT_G] = {S6, 1},
+	[ELEC_UNIT_mG] = {1000, 1},
+	[ELEC_UNIT_uG] = {1, 1},
+};
+
+static const struct ratio resistance_ratio[ELEC_UNIT_RESISTANCE_CNT] = {
+	[ELEC_UNIT_MOHM] = {S12, 1},
+	[ELEC_UNIT_kOHM] = {S9, 1},
+	[ELEC_UNIT_OHM] = {S6, 1},
+	[ELEC_UNIT_mOHM] = {1000, 1},
+};
+
+static const struct ratio voltage_ratio[ELEC_UNIT_VOLTAGE_CNT] = {
+	[ELEC_UNIT_KV] = {S9, 1},
+	[ELEC_UNIT_V] = {S6, 1},
+	[ELEC_UNIT_MV] = {1000, 1},
+	[ELEC_UNIT_UV] = {1, 1},
+};
+
+/* Matches elec_units_current[] that has pA defined as 1e-9 A */
+static const struct ratio current_ratio[ELEC_UNIT_CURRENT_CNT] = {
+	[ELEC_UNIT_kA] = {S9, 1},
+	[ELEC_UNIT_A] = {S6, 1},
+	[ELEC_UNIT_mA] = {1000, 1},
+	[ELEC_UNIT_uA] = {1, 1},
+	[ELEC_UNIT_pA] = {1, 1000},
+};
+
+static const struct ratio power_ratio[ELEC_UNIT_POWER_CNT] = {
+	[ELEC_UNIT_MW] = {S12, 1},
+	[ELEC_UNIT_kW] = {S9, 1},
+	[ELEC_UNIT_W] = {S6, 1},
+	[ELEC_UNIT_mW] = {1000, 1},
+	[ELEC_UNIT_uW] = {1, 1},
+	[ELEC_UNIT_ELECTRICAL_HP] = {746 * S6, 1},
+};
+
+static const struct ratio capacitance_ratio[ELEC_UNIT_CAPACITANCE_CNT] = {
+	[ELEC_UNIT_F] = {S12, 1},
+	[ELEC_UNIT_mF] = {S9, 1},
+	[ELEC_UNIT_uF] = {S6, 1},
+	[ELEC_UNIT_nF] = {1000, 1},
+	[ELEC_UNIT_pF] = {1, 1},
+};
+
+static const struct ratio inductance_ratio[ELEC_UNIT_INDUCTANCE_CNT] = {
+	[ELEC_UNIT_H] = {S9, 1},
+	[ELEC_UNIT_mH] = {S6, 1},
+	[ELEC_UNIT_uH] = {1000, 1},
+	[ELEC_UNIT_nH] = {1, 1},
+};
+
+static const struct ratio *type_ratios(enum elec_unit type, unsigned int *cnt)
+{
+	switch (type) {
+	case ELEC_UNIT_UNDEF:
+	break;
+	case ELEC_UNIT_LENGTH:
+		*cnt = ELEC_UNIT_LENGTH_CNT;
+		return length_ratio;
+	case ELEC_UNIT_AREA:
+		*cnt = ELEC_UNIT_AREA_CNT;
+		return area_ratio;
+	case ELEC_UNIT_MASS:
+		*cnt = ELEC_UNIT_MASS_CNT;
+		return mass_ratio;
+	case ELEC_UNIT_RESISTANCE:
+		*cnt = ELEC_UNIT_RESISTANCE_CNT;
+		return resistance_ratio;
+	case ELEC_UNIT_VOLTAGE:
+		*cnt = ELEC_UNIT_VOLTAGE_CNT;
+		return voltage_ratio;
+	case ELEC_UNIT_CURRENT:
+		*cnt = ELEC_UNIT_CURRENT_CNT;
+		return current_ratio;
+	case ELEC_UNIT_POWER:
+		*cnt = ELEC_UNIT_POWER_CNT;
+		return power_ratio;
+	case ELEC_UNIT_CAPACITANCE:
+		*cnt = ELEC_UNIT_CAPACITANCE_CNT;
+		return capacitance_ratio;
+	case ELEC_UNIT_INDUCTANCE:
+		*cnt = ELEC_UNIT_INDUCTANCE_CNT;
+		return inductance_ratio;
+	}
+
+	return NULL;
+}
+
+/* AWG 0000 to 40 areas in nm² */
+static const int64_t awg_area[ELEC_AWG_MAX - ELEC_AWG_MIN + 1] = {
+	107219302577031ll, 85028772574278ll, 67430882235911ll, 53475120732118ll,
+	42407698705619ll, 33630834019350ll, 26670463886483ll, 21150639425443ll,
+	16773219618869ll, 13301767890969ll, 10548781512773ll, 8365564060081ll,
+	6634193907474ll, 5261154954510ll, 4172285561956ll, 3308772876111ll,
+	2623976183586ll, 2080907717098ll, 1650234843657ll, 1308695727755ll,
+	1037842895166ll, 823046833731ll, 652705812865ll, 517619241928ll,
+	410490720832ll, 325533941245ll, 258160152044ll, 204730308147ll,
+	162358515604ll, 128756156466ll, 102108274187ll, 80975542791ll,
+	64216524884ll, 50926019464ll, 40386169496ll, 32027688473ll,
+	25399111669ll, 20142411280ll, 15973658350ll, 12667686977ll,
+	10045932488ll, 7966786654ll, 6317949047ll, 5010361378ll,
+};
+
+/* Area ratio between two consecutive gauges is exp(LN_R), scaled by 1e9 */
+#define LN_R 231886594ll
+
+/* exp(-x) for x in [0, LN_R] scaled by 1e9 */
+static int64_t exp_neg(int64_t x)
+{
+	int64_t r = S9;
+	int k;
+
+	for (k = 8; k > 0; k--)
+		r = S9 - x * r / (k * S9);
+
+	return r;
+}
+
+/* log(x) for x in [1, exp(LN_R)] scaled by 1e9 */
+static int64_t log_small(int64_t x)
+{
+	int64_t z = (x - S9) * S9 / (x + S9);
+	int64_t z2 = z * z / S9, t = z, r = 0;
+	int k;
+
+	for (k = 1; k <= 9; k += 2) {
+		r += t / k;
+		t = t * z2 / S9;
+	}
+
+	return 2 * r;
+}
+
+static int awg_to_area(elec_fixed awg, int64_t *area)
+{
+	int64_t n = awg / ELEC_FIXED_ONE, frac = awg % ELEC_FIXED_ONE;
+
+	if (frac < 0) {
+		n--;
+		frac += ELEC_FIXED_ONE;
+	}
+
+	if (n < ELEC_AWG_MIN || n > ELEC_AWG_MAX || (n == ELEC_AWG_MAX && frac))
+		return 1;
+
+	if (!frac) {
+		*area = awg_area[n - ELEC_AWG_MIN];
+		return 0;
+	}
+
+	return muldiv(awg_area[n - ELEC_AWG_MIN],
+	              exp_neg(frac * (S9 / ELEC_FIXED_ONE) * LN_R / S9), S9, area);
+}
+
+static int area_to_awg(int64_t area, elec_fixed *awg)
+{
+	size_t lo = 0, hi = ELEC_AWG_MAX - ELEC_AWG_MIN;
+	int64_t ratio, frac;
+
+	if (area > awg_area[0] || area < awg_area[hi])
+		return 1;
+
+	/* Finds the gauge with area[lo] >= area > area[lo + 1] */
+	while (hi - lo > 1) {
+		size_t mid = (lo + hi) / 2;
+
+		if (awg_area[mid] >= area)
+			lo = mid;
+		else
+			hi = mid;
+	}
+
+	if (muldiv(awg_area[lo], S9, area, &ratio))
+		return 1;
+
+	frac = (log_small(ratio) * ELEC_FIXED_ONE + LN_R / 2) / LN_R;
+
+	*awg = ((int64_t)lo + ELEC_AWG_MIN) * ELEC_FIXED_ONE + frac;
+
+	return 0;
+}
+
+static int to_base(const struct elec_fixed_val *value, int64_t *base)
+{
+	const struct ratio *ratios;
+	unsigned int cnt;
+
+	ratios = type_ratios(value->type, &cnt);
+	if (!ratios || value->unit >= cnt)
+		return 1;
+
+	if (value->type == ELEC_UNIT_AREA && value->unit == ELEC_UNIT_AWG)
+		return awg_to_area(value->val, base);
+
+	return muldiv(value->val, ratios[value->unit].num,
+	              ratios[value->unit].den * ELEC_FIXED_ONE, base);
+}
+
+static int from_base(struct elec_fixed_val *value, int64_t base, elec_unit unit_to)
+{
+	const struct ratio *ratios;
+	unsigned int cnt;
+
+	ratios = type_ratios(value->type, &cnt);
+	if (!ratios || unit_to >= cnt)
+		return 1;
+
+	value->unit = unit_to;
+
+	if (value->type == ELEC_UNIT_AREA && unit_to == ELEC_UNIT_AWG)
+		return area_to_awg(base, &value->val);
+
+	return muldiv(base, ratios[unit_to].den * ELEC_FIXED_ONE,
+	              ratios[unit_to].num, &value->val);
+}
+
+void elec_fixed_material_init(struct elec_fixed_material *fixed,
+                              const struct elec_material *material)
+{
+	fixed->ro = material->ro * 1e12 + 0.5;
+	fixed->density = material->density * 1e3 + 0.5;
+}
+
+int elec_fixed_unit_convert(struct elec_fixed_val *value, elec_unit unit_to)
+{
+	int64_t base;
+
+	if (value->type == ELEC_UNIT_UNDEF)
+		return 0;
+
+	if (to_base(value, &base))
+		return 1;
+
+	return from_base(value, base, unit_to);
+}
+
+int elec_fixed_circle_area(struct elec_fixed_val *value, elec_unit unit_to)
+{
+	int64_t d;
+	uint64_t area;
+
+	if (value->type != ELEC_UNIT_LENGTH || to_base(value, &d))
+		return 1;
+
+	if (abs_64(d) > UINT32_MAX)
+		return 1;
+
+	if (muldiv_u(abs_64(d) * abs_64(d), PI_4, S18, &area) || area > INT64_MAX)
+		return 1;
+
+	value->type = ELEC_UNIT_AREA;
+
+	return from_base(value, area, unit_to);
+}
+
+int elec_fixed_circle_diameter(struct elec_fixed_val *value, elec_unit unit_to)
+{
+	int64_t area;
+
+	if (value->type != ELEC_UNIT_AREA || to_base(value, &area) || area < 0)
+		return 1;
+
+	value->type = ELEC_UNIT_LENGTH;
+
+	/* The root is in 1e-9 nm */
+	return from_base(value, (isqrt_128(mul_64(area, INV_PI_4)) + S9 / 2) / S9, unit_to);
+}
+
+static int base_of(struct elec_fixed_val value, enum elec_unit type, int64_t *base)
+{
+	if (value.type != type)
+		return 1;
+
+	return to_base(&value, base);
+}
+
+int elec_fixed_resistance_block(const struct elec_fixed_material *material,
+                                struct elec_fixed_val length,
+                                struct elec_fixed_val cross_section,
+                                elec_unit unit_to, struct elec_fixed_val *resistance)
+{
+	int64_t l, a, r;
+
+	if (base_of(length, ELEC_UNIT_LENGTH, &l) ||
+	    base_of(cross_section, ELEC_UNIT_AREA, &a))
+		return 1;
+
+	/* pΩ m * nm / nm² = mΩ, hence the ro * 1000 for µΩ */
+	if (muldiv(material->ro * 1000, l, a, &r))
+		return 1;
+
+	resistance->type = ELEC_UNIT_RESISTANCE;
+
+	return from_base(resistance, r, unit_to);
+}
+
+int elec_fixed_length_block(const struct elec_fixed_material *material,
+                            struct elec_fixed_val resistance,
+                            struct elec_fixed_val cross_section,
+                            elec_unit unit_to, struct elec_fixed_val *length)
+{
+	int64_t r, a, l;
+
+	if (base_of(resistance, ELEC_UNIT_RESISTANCE, &r) ||
+	    base_of(cross_section, ELEC_UNIT_AREA, &a))
+		return 1;
+
+	/* µΩ * nm² / pΩ m = 1e-3 nm */
+	if (muldiv(r, a, material->ro * 1000, &l))
+		return 1;
+
+	length->type = ELEC_UNIT_LENGTH;
+
+	return from_base(length, l, unit_to);
+}
+
+int elec_fixed_mass_block(const struct elec_fixed_material *material,
+                          struct elec_fixed_val length,
+                          struct elec_fixed_val cross_section,
+                          elec_unit unit_to, struct elec_fixed_val *mass)
+{
+	int64_t l, a, vol, m;
+
+	if (base_of(length, ELEC_UNIT_LENGTH, &l) ||
+	    base_of(cross_section, ELEC_UNIT_AREA, &a))
+		return 1;
+
+	/* nm * nm² = 1e-27 m³, the volume is in 1e-16 m³ */
+	if (muldiv(l, a, 100000000000ll, &vol))
+		return 1;
+
+	/* 1e-16 m³ * g/m³ = 1e-10 µg */
+	if (muldiv(vol, material->density, 10000000000ll, &m))
+		return 1;
+
+	mass->type = ELEC_UNIT_MASS;
+
+	return from_base(mass, m, unit_to);
+}
+
+static int set_base(struct elec_fixed_val *value, enum elec_unit type,
+                    elec_unit unit, int64_t base)
+{
+	value->type = type;
+
+	return from_base(value, base, unit);
+}
+
+int elec_fixed_ohm_law(struct elec_fixed_ohm_law *ohm_law)
+{
+	int64_t r, i, u, p;
+
+	ohm_law->r.type = ELEC_UNIT_RESISTANCE;
+	ohm_law->p.type = ELEC_UNIT_POWER;
+	ohm_law->i.type = ELEC_UNIT_CURRENT;
+	ohm_law->u.type = ELEC_UNIT_VOLTAGE;
+
+	if (ohm_law->r.unit == ELEC_UNIT_UNDEF && ohm_law->p.unit == ELEC_UNIT_UNDEF) {
+		if (to_base(&ohm_law->u, &u) || to_base(&ohm_law->i, &i) ||
+		    muldiv(u, S6, i, &r) || muldiv(u, i, S6, &p))
+			return 1;
+
+		return set_base(&ohm_law->r, ELEC_UNIT_RESISTANCE, ELEC_UNIT_OHM, r) ||
+		       set_base(&ohm_law->p, ELEC_UNIT_POWER, ELEC_UNIT_W, p);
+	}
+
+	if (ohm_law->r.unit == ELEC_UNIT_UNDEF && ohm_law->i.unit == ELEC_UNIT_UNDEF) {
+		if (to_base(&ohm_law->p, &p) || to_base(&ohm_law->u, &u) ||
+		    muldiv(p, S6, u, &i) || muldiv(u, u, p, &r))
+			return 1;
+
+		return set_base(&ohm_law->i, ELEC_UNIT_CURRENT, ELEC_UNIT_A, i) ||
+		       set_base(&ohm_law->r, ELEC_UNIT_RESISTANCE, ELEC_UNIT_OHM, r);
+	}
+
+	if (ohm_law->r.unit == ELEC_UNIT_UNDEF && ohm_law->u.unit == ELEC_UNIT_UNDEF) {
+		if (to_base(&ohm_law->p, &p) || to_base(&ohm_law->i, &i) ||
+		    muldiv(p, S6, i, &u))
+			return 1;
+
+		/* µW / µA² = 1e12 µΩ */
+		if (abs_64(i) <= 3 * S9) {
+			if (muldiv(p, S12, i * i, &r))
+				return 1;
+		} else if (muldiv(u, S6, i, &r)) {
+			return 1;
+		}
+
+		return set_base(&ohm_law->u, ELEC_UNIT_VOLTAGE, ELEC_UNIT_V, u) ||
+		       set_base(&ohm_law->r, ELEC_UNIT_RESISTANCE, ELEC_UNIT_OHM, r);
+	}
+
+	if (ohm_law->i.unit == ELEC_UNIT_UNDEF && ohm_law->u.unit == ELEC_UNIT_UNDEF) {
+		uint64_t root;
+
+		if (to_base(&ohm_law->p, &p) || to_base(&ohm_law->r, &r) ||
+		    p < 0 || r <= 0 || muldiv(p, S12, r, &i))
+			return 1;
+
+		/* µW / µΩ * 1e12 = µA² and µW * µΩ = µV² */
+		i = isqrt_128(mul_64(i, 1));
+		root = isqrt_128(mul_64(p, r));
+
+		if (root > INT64_MAX)
+			return 1;
+
+		u = root;
+
+		return set_base(&ohm_law->i, ELEC_UNIT_CURRENT, ELEC_UNIT_A, i) ||
+		       set_base(&ohm_law->u, ELEC_UNIT_VOLTAGE, ELEC_UNIT_V, u);
+	}
+
+	if (ohm_law->u.unit == ELEC_UNIT_UNDEF && ohm_law->p.unit == ELEC_UNIT_UNDEF) {
+		if (to_base(&ohm_law->i, &i) || to_base(&ohm_law->r, &r) ||
+		    muldiv(i, r, S6, &u))
+			return 1;
+
+		/* µA² * µΩ = 1e-12 µW */
+		if (abs_64(i) <= 3 * S9) {
+			if (muldiv(i * i, r, S12, &p))
+				return 1;
+		} else if (muldiv(u, i, S6, &p)) {
+			return 1;
+		}
+
+		return set_base(&ohm_law->u, ELEC_UNIT_VOLTAGE, ELEC_UNIT_V, u) ||
+		       set_base(&ohm_law->p, ELEC_UNIT_POWER, ELEC_UNIT_W, p);
+	}
+
+	if (ohm_law->i.unit == ELEC_UNIT_UNDEF && ohm_law->p.unit == ELEC_UNIT_UNDEF) {
+		if (to_base(&ohm_law->u, &u) || to_base(&ohm_law->r, &r) ||
+		    muldiv(u, S6, r, &i) || muldiv(u, u, r, &p))
+			return 1;
+
+		return set_base(&ohm_law->i, ELEC_UNIT_CURRENT, ELEC_UNIT_A, i) ||
+		       set_base(&ohm_law->p, ELEC_UNIT_POWER, ELEC_UNIT_W, p);
+	}
+
+	return 1;
+}
@@ -0,0 +1,148 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Fixed point variant of the basic libelec calculations for targets without
+ * FPU, enabled by building with FIXED=1.
+ *
+ * Values are 64bit integers scaled by ELEC_FIXED_ONE, i.e. with six decimal
+ * places in the value unit, so that 1.5 mm is {1500000, ELEC_UNIT_MM}. The
+ * representable range is ±9.2e12 of the unit.
+ *
+ * Internally the values are converted to integer base units:
+ *
+ * - length in nm
+ * - area in nm²
+ * - mass in µg
+ * - resistance, voltage, current and power in µΩ, µV, µA and µW
+ * - capacitance in pF and inductance in nH
+ *
+ * All unit ratios are exact and every operation rounds to the nearest
+ * integer exactly once, products and quotients are computed with 128bit
+ * intermediates. Hence the results are within 0.5 of the last place of the
+ * output plus the error caused by rounding the inputs to the base units.
+ * The exceptions are:
+ *
+ * - Mass rounds the volume to 1e-16 m³ (1e-7 mm³) first.
+ * - AWG to area and back uses exp() and log() series with relative error
+ *   below 1e-9, only AWG 0000 to 40 is supported.
+ * - P from I and R and R from P and I are computed from the rounded U when
+ *   I is over 3 kA, which adds up to 0.5 µW or 0.5 µΩ per kA.
+ *
+ * None of the functions uses floating point, with the exception of
+ * elec_fixed_material_init() that converts the material table once.
+ *
+ * All functions return zero on success and non-zero on overflow, division by
+ * zero, square root of a negative number, or a value outside of the
+ * supported range.
+ */
+
+#ifndef ELEC_FIXED_H
+#define ELEC_FIXED_H
+
+#include <stdint.h>
+#include "libelec.h"
+
+#define ELEC_FIXED_ONE 1000000
+
+typedef int64_t elec_fixed;
+
+struct elec_fixed_val {
+	enum elec_unit type;
+	elec_fixed val;
+	elec_unit unit;
+};
+
+/**
+ * Material constants in integer units.
+ */
+struct elec_fixed_material {
+	/* resistivity in pΩ m */
+	int64_t ro;
+	/* density in g/m³ */
+	int64_t density;
+};
+
+/**
+ * Converts a material description into integer units.
+ */
+void elec_fixed_material_init(struct elec_fixed_material *fixed,
+                              const struct elec_material *material);
+
+/**
+ * Converts a value into a specified unit.
+ */
+int elec_fixed_unit_convert(struct elec_fixed_val *value, elec_unit unit_to);
+
+/**
+ * Computes circle area from diameter, the diameter must be smaller than
+ * 4.29 m.
+ */
+int elec_fixed_circle_area(struct elec_fixed_val *value, elec_unit unit_to);
+
+/**
+ * Computes circle diameter from area.
+ */
+int elec_fixed_circle_diameter(struct elec_fixed_val *value, elec_unit unit_to);
+
+/**
+ * Fixed point variant of elec_resistance_block().
+ *
+ * @material A material description.
+ * @length A material length.
+ * @cross_section A material cross section.
+ * @unit_to A resistance unit of the result.
+ * @resistance The result.
+ */
+int elec_fixed_resistance_block(const struct elec_fixed_material *material,
+                                struct elec_fixed_val length,
+                                struct elec_fixed_val cross_section,
+                                elec_unit unit_to, struct elec_fixed_val *resistance);
+
+/**
+ * Fixed point variant of elec_length_block().
+ *
+ * @material A material description.
+ * @resistance A material resistance.
+ * @cross_section A material cross section.
+ * @unit_to A length unit of the result.
+ * @length The result.
+ */
+int elec_fixed_length_block(const struct elec_fixed_material *material,
+                            struct elec_fixed_val resistance,
+                            struct elec_fixed_val cross_section,
+                            elec_unit unit_to, struct elec_fixed_val *length);
+
+/**
+ * Fixed point variant of elec_mass_block().
+ *
+ * @material A material description.
+ * @length A material length.
+ * @cross_section A material cross section.
+ * @unit_to A mass unit of the result.
+ * @mass The result.
+ */
+int elec_fixed_mass_block(const struct elec_fixed_material *material,
+                          struct elec_fixed_val length,
+                          struct elec_fixed_val cross_section,
+                          elec_unit unit_to, struct elec_fixed_val *mass);
+
+/**
+ * The ohm law is solved for the two values with unit set to ELEC_UNIT_UNDEF,
+ * the results are in Ω, A, V and W.
+ */
+struct elec_fixed_ohm_law {
+	struct elec_fixed_val r;
+	struct elec_fixed_val i;
+	struct elec_fixed_val u;
+	struct elec_fixed_val p;
+};
+
+int elec_fixed_ohm_law(struct elec_fixed_ohm_law *ohm_law);
+
+#endif /* ELEC_FIXED_H */
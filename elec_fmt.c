@@ -0,0 +1,415 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "elec_fmt.h"
+
+typedef unsigned __int128 u128;
+
+#define DIGITS_MAX 17
+
+struct dec {
+	char d[DIGITS_MAX + 1];
+	int len;
+	/* decimal exponent of the first digit */
+	int exp;
+};
+
+static const uint64_t pow10_u64[20] = {
+	1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull,
+	10000000ull, 100000000ull, 1000000000ull, 10000000000ull,
+	100000000000ull, 1000000000000ull, 10000000000000ull,
+	100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+	100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull,
+};
+
+static inline u128 pow10_u128(int k)
+{
+	if (k < 20)
+		return pow10_u64[k];
+
+	return (u128)pow10_u64[19] * pow10_u64[k - 19];
+}
+
+/*
+ * One decimal digit of r / s where r < 10 * s, r is replaced by the
+ * remainder.
+ */
+static inline int digit(u128 *r, u128 s, u128 s2, u128 s4, u128 s8)
+{
+	int d = 0;
+
+	if (*r >= s8) {
+		*r -= s8;
+		d += 8;
+	}
+
+	if (*r >= s4) {
+		*r -= s4;
+		d += 4;
+	}
+
+	if (*r >= s2) {
+		*r -= s2;
+		d += 2;
+	}
+
+	if (*r >= s) {
+		*r -= s;
+		d += 1;
+	}
+
+	return d;
+}
+
+/*
+ * Exact digit generation for positive finite values (Steele & White, Burger &
+ * Dybvig). The value is r/s and the rounding interval, i.e. values that
+ * parse back to the same double, is (r - mm)/s to (r + mp)/s.
+ *
+ * With prec == 0 shortest digits inside the interval are generated,
+ * otherwise prec digits correctly rounded to nearest even.
+ *
+ * Returns non-zero if the value does not fit into 128-bit arithmetic.
+ */
+static int dec_exact(double v, int prec, struct dec *out)
+{
+	uint64_t bits, f;
+	u128 r, s, mp, mm, s2, s4, s8;
+	int be, e, k, even, boundary;
+
+	memcpy(&bits, &v, sizeof(bits));
+
+	be = (bits >> 52) & 0x7ff;
+	f = bits & ((1ull << 52) - 1);
+
+	/* Subnormals */
+	if (!be)
+		return 1;
+
+	f |= 1ull << 52;
+	e = be - 1075;
+
+	/* Keeps r * 10 and s * 8 below 2^128 */
+	if (e < -116 || e > 64)
+		return 1;
+
+	even = !(f & 1);
+	/* The interval below the value is half size at powers of two */
+	boundary = f == 1ull << 52 && be > 1;
+
+	if (e >= 0) {
+		u128 be2 = (u128)1 << e;
+
+		r = (u128)f * be2 * (boundary ? 4 : 2);
+		s = boundary ? 4 : 2;
+		mp = boundary ? 2 * be2 : be2;
+		mm = be2;
+	} else {
+		r = (u128)f * (boundary ? 4 : 2);
+		s = (u128)1 << (boundary ? 2 - e : 1 - e);
+		mp = boundary ? 2 : 1;
+		mm = 1;
+	}
+
+	/* Estimate of ceil(log10(v)) from the binary exponent, may be one less */
+	k = ceil((be - 1023) * 0.30102999566398114);
+
+	if (k >= 0) {
+		s *= pow10_u128(k);
+	} else {
+		u128 p = pow10_u128(-k);
+
+		r *= p;
+		mp *= p;
+		mm *= p;
+	}
+
+	/* Fix the estimate so that r/s is in [0.1, 1) */
+	if (prec) {
+		mp = 0;
+		even = 1;
+	}
+
+	if (even ? r + mp >= s : r + mp > s) {
+		s *= 10;
+		k++;
+	}
+
+	s2 = 2 * s;
+	s4 = 4 * s;
+	s8 = 8 * s;
+
+	out->exp = k - 1;
+	out->len = 0;
+
+	if (prec) {
+		int i;
+
+		while (out->len < prec) {
+			r *= 10;
+			out->d[out->len++] = '0' + digit(&r, s, s2, s4, s8);
+		}
+
+		if (2 * r < s || (2 * r == s && !((out->d[prec - 1] - '0') & 1)))
+			return 0;
+
+		/* Round up */
+		for (i = prec - 1; i >= 0; i--) {
+			if (out->d[i] != '9') {
+				out->d[i]++;
+				return 0;
+			}
+
+			out->d[i] = '0';
+		}
+
+		out->d[0] = '1';
+		out->exp++;
+
+		return 0;
+	}
+
+	for (;;) {
+		int d, low, high;
+
+		r *= 10;
+		mp *= 10;
+		mm *= 10;
+
+		d = digit(&r, s, s2, s4, s8);
+
+		low = even ? r <= mm : r < mm;
+		high = even ? r + mp >= s : r + mp > s;
+
+		if (low && high)
+			d += 2 * r >= s;
+		else if (high)
+			d++;
+
+		out->d[out->len++] = '0' + d;
+
+		if (low || high)
+			return 0;
+	}
+}
+
+/*
+ * Extracts digits from %.*e output, skips whatever the locale uses as a
+ * decimal point.
+ */
+static void dec_parse(const char *str, struct dec *out)
+{
+	out->len = 0;
+
+	for (; *str && *str != 'e'; str++) {
+		if (*str >= '0' && *str <= '9' && out->len < DIGITS_MAX)
+			out->d[out->len++] = *str;
+	}
+
+	out->exp = *str ? atoi(str + 1) : 0;
+}
+
+static void dec_libc(double v, int prec, struct dec *out)
+{
+	char buf[64];
+	int p;
+
+	if (prec) {
+		snprintf(buf, sizeof(buf), "%.*e", prec - 1, v);
+		dec_parse(buf, out);
+		return;
+	}
+
+	for (p = 1; p < DIGITS_MAX; p++) {
+		snprintf(buf, sizeof(buf), "%.*e", p - 1, v);
+
+		if (strtod(buf, NULL) == v)
+			break;
+	}
+
+	snprintf(buf, sizeof(buf), "%.*e", p - 1, v);
+	dec_parse(buf, out);
+}
+
+/*
+ * Converts finite value to digits, returns the sign.
+ */
+static int dec_conv(double val, int prec, struct dec *out)
+{
+	int neg = signbit(val);
+
+	if (neg)
+		val = -val;
+
+	if (val == 0) {
+		out->d[0] = '0';
+		out->len = 1;
+		out->exp = 0;
+		return neg;
+	}
+
+	if (dec_exact(val, prec, out))
+		dec_libc(val, prec, out);
+
+	while (out->len > 1 && out->d[out->len - 1] == '0')
+		out->len--;
+
+	return neg;
+}
+
+static size_t fmt_special(double val, char *buf)
+{
+	if (isnan(val))
+		strcpy(buf, "nan");
+	else
+		strcpy(buf, val < 0 ? "-inf" : "inf");
+
+	return strlen(buf);
+}
+
+/*
+ * Writes digits with decimal point after int_digits, pads with zeros.
+ */
+static size_t put_mantissa(const struct dec *dec, int int_digits, char *buf)
+{
+	size_t len = 0;
+	int i;
+
+	if (int_digits <= 0) {
+		buf[len++] = '0';
+		buf[len++] = '.';
+
+		for (i = int_digits; i < 0; i++)
+			buf[len++] = '0';
+
+		for (i = 0; i < dec->len; i++)
+			buf[len++] = dec->d[i];
+
+		return len;
+	}
+
+	for (i = 0; i < int_digits; i++)
+		buf[len++] = i < dec->len ? dec->d[i] : '0';
+
+	if (dec->len > int_digits) {
+		buf[len++] = '.';
+
+		for (i = int_digits; i < dec->len; i++)
+			buf[len++] = dec->d[i];
+	}
+
+	return len;
+}
+
+static size_t fmt_g(double val, int prec, char *buf)
+{
+	struct dec dec;
+	size_t len = 0;
+	int exp;
+
+	if (!isfinite(val))
+		return fmt_special(val, buf);
+
+	if (dec_conv(val, prec, &dec))
+		buf[len++] = '-';
+
+	if (dec.exp >= -4 && dec.exp < (prec ? prec : DIGITS_MAX)) {
+		len += put_mantissa(&dec, dec.exp + 1, buf + len);
+		buf[len] = 0;
+		return len;
+	}
+
+	len += put_mantissa(&dec, 1, buf + len);
+
+	exp = dec.exp;
+
+	buf[len++] = 'e';
+	buf[len++] = exp < 0 ? '-' : '+';
+
+	if (exp < 0)
+		exp = -exp;
+
+	if (exp >= 100)
+		buf[len++] = '0' + exp / 100;
+
+	buf[len++] = '0' + exp / 10 % 10;
+	buf[len++] = '0' + exp % 10;
+	buf[len] = 0;
+
+	return len;
+}
+
+size_t elec_fmt_shortest(double val, char *buf)
+{
+	return fmt_g(val, 0, buf);
+}
+
+size_t elec_fmt_digits(double val, int digits, char *buf)
+{
+	if (digits < 0)
+		digits = 0;
+
+	if (digits > DIGITS_MAX)
+		digits = DIGITS_MAX;
+
+	return fmt_g(val, digits, buf);
+}
+
+static const char *si_prefixes[] = {
+	"y", "z", "a", "f", "p", "n", "\u00b5", "m", "",
+	"k", "M", "G", "T", "P", "E", "Z", "Y",
+};
+
+#define SI_MIN_EXP -24
+#define SI_MAX_EXP 24
+
+size_t elec_fmt_si(double val, int digits, const char *unit, char *buf, size_t buf_len)
+{
+	const char *prefix = "";
+	char num[ELEC_FMT_MAX];
+	struct dec dec;
+	size_t len = 0;
+	int eng;
+
+	if (!buf_len)
+		return 0;
+
+	if (digits < 0 || digits > DIGITS_MAX)
+		digits = DIGITS_MAX;
+
+	if (!isfinite(val)) {
+		fmt_special(val, num);
+		goto out;
+	}
+
+	if (dec_conv(val, digits, &dec))
+		num[len++] = '-';
+
+	/* Exponent of the prefix, a multiple of three */
+	eng = dec.exp >= 0 ? dec.exp / 3 * 3 : -((2 - dec.exp) / 3 * 3);
+
+	if (val == 0 || eng < SI_MIN_EXP || eng > SI_MAX_EXP) {
+		fmt_g(val, digits, num);
+		goto out;
+	}
+
+	prefix = si_prefixes[(eng - SI_MIN_EXP) / 3];
+
+	len += put_mantissa(&dec, dec.exp - eng + 1, num + len);
+	num[len] = 0;
+out:
+	snprintf(buf, buf_len, "%s%s%s%s", num,
+	         (*prefix || (unit && *unit)) ? " " : "", prefix, unit ? unit : "");
+
+	return strlen(buf);
+}
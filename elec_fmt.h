@@ -0,0 +1,70 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Locale independent number formatting.
+ *
+ * Decimal digits are generated exactly from the binary value with 128-bit
+ * integer arithmetic, either the shortest digit string that parses back to
+ * the same double or a fixed number of correctly rounded significant digits.
+ * Values outside of about 5e-20 to 1.6e35 (2^-64 to 2^117), which do not
+ * fit the 128-bit arithmetic, fall back to the C library.
+ *
+ * The functions do not allocate memory and always use '.' as a decimal
+ * point.
+ */
+
+#ifndef ELEC_FMT_H
+#define ELEC_FMT_H
+
+#include <stddef.h>
+
+/* Buffer size large enough for elec_fmt_shortest() and elec_fmt_digits() */
+#define ELEC_FMT_MAX 32
+
+/**
+ * Formats the shortest string that parses back to the same value.
+ *
+ * The notation follows %g, i.e. exponent is used for values below 1e-4 and
+ * above 1e16.
+ *
+ * @val A value.
+ * @buf A buffer of at least ELEC_FMT_MAX bytes.
+ *
+ * @return Length of the string.
+ */
+size_t elec_fmt_shortest(double val, char *buf);
+
+/**
+ * Formats a value rounded to significant digits, the output matches %.*g in
+ * the C locale.
+ *
+ * @val A value.
+ * @digits Number of significant digits 1 to 17, 0 for elec_fmt_shortest().
+ * @buf A buffer of at least ELEC_FMT_MAX bytes.
+ *
+ * @return Length of the string.
+ */
+size_t elec_fmt_digits(double val, int digits, char *buf);
+
+/**
+ * Formats a value in engineering notation with SI prefix, e.g. 1500 with
+ * unit "Ω" is formatted as "1.5 kΩ".
+ *
+ * @val A value.
+ * @digits Number of significant digits 1 to 17, 0 for the shortest round
+ *         trip digits.
+ * @unit A unit appended after the prefix, may be NULL.
+ * @buf An output buffer.
+ * @buf_len The buffer size.
+ *
+ * @return Length of the string, the output is truncated if it does not fit.
+ */
+size_t elec_fmt_si(double val, int digits, const char *unit, char *buf, size_t buf_len);
+
+#endif /* ELEC_FMT_H */
@@ -0,0 +1,110 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#include <math.h>
+#include <string.h>
+#include "elec_fuse.h"
+
+/*
+ * I²t per area² i.e. A²s/m⁴ from t_init to t_final.
+ */
+static double i2t_coef(const struct elec_material *material, double t_init, double t_final)
+{
+	double cd = material->heat_capacity * material->density;
+	double tc = material->tc;
+
+	if (!(t_final > t_init))
+		return 0;
+
+	/* Resistivity does not depend on temperature */
+	if (!(tc > 0))
+		return cd * (t_final - t_init) / material->ro;
+
+	return cd / (material->ro * tc) *
+	       log((1 + tc * (t_final - 20)) / (1 + tc * (t_init - 20)));
+}
+
+double elec_i2t(const struct elec_material *material, double area,
+                double t_init, double t_final)
+{
+	return i2t_coef(material, t_init, t_final) * area * area;
+}
+
+double elec_fusing_current(const struct elec_material *material, double area,
+                           double t_ambient, double time)
+{
+	if (t_ambient >= material->melting_point)
+		return NAN;
+
+	return area * sqrt(i2t_coef(material, t_ambient, material->melting_point) / time);
+}
+
+/* Preece constants for diameter in inches */
+static const struct preece {
+	const char *name;
+	double a;
+} preece[] = {
+	{"copper", 10244},
+	{"annealed copper", 10244},
+	{"aluminium", 7585},
+	{"platinum", 5172},
+	{"iron", 3148},
+	{"tin", 1642},
+	{"lead", 1379},
+	{}
+};
+
+double elec_fusing_current_preece(const struct elec_material *material, double diameter)
+{
+	const struct preece *i;
+	double d = diameter / 0.0254;
+
+	for (i = preece; i->name; i++) {
+		if (!strcmp(i->name, material->name))
+			return i->a * d * sqrt(d);
+	}
+
+	return NAN;
+}
+
+struct elec_val elec_fusing_current_block(struct elec_material *material,
+                                          struct elec_val cross_section,
+                                          double t_ambient, double time)
+{
+	elec_unit_convert(&cross_section, ELEC_UNIT_M2);
+
+	return (struct elec_val) {
+		.val = elec_fusing_current(material, cross_section.val, t_ambient, time),
+		.type = ELEC_UNIT_CURRENT,
+		.unit = ELEC_UNIT_A,
+	};
+}
+
+void elec_i2t_batch(const struct elec_material *material, const double *restrict area,
+                    double t_init, double t_final, double *restrict i2t, size_t cnt)
+{
+	double coef = i2t_coef(material, t_init, t_final);
+	size_t i;
+
+	for (i = 0; i < cnt; i++)
+		i2t[i] = coef * area[i] * area[i];
+}
+
+void elec_fusing_current_batch(const struct elec_material *material,
+                               const double *restrict area, const double *restrict time,
+                               double t_ambient, double *restrict current, size_t cnt)
+{
+	double coef = NAN;
+	size_t i;
+
+	if (t_ambient < material->melting_point)
+		coef = i2t_coef(material, t_ambient, material->melting_point);
+
+	for (i = 0; i < cnt; i++)
+		current[i] = area[i] * sqrt(coef / time[i]);
+}
@@ -0,0 +1,93 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Fusing current and short time thermal withstand of conductors.
+ *
+ * The short time calculations assume adiabatic heating, i.e. all the I²R
+ * losses heat up the conductor, with resistivity linear in temperature:
+ *
+ * I²t = A² * c * D / (ro * tc) * ln((1 + tc (Tf - 20)) / (1 + tc (Ti - 20)))
+ *
+ * which for copper is the Onderdonk equation. This is valid for times up to
+ * a few seconds, for longer times the heat dissipation cannot be neglected.
+ */
+
+#ifndef ELEC_FUSE_H
+#define ELEC_FUSE_H
+
+#include <stddef.h>
+#include "libelec.h"
+
+/**
+ * Calculates I²t a conductor withstands while heating from t_init to
+ * t_final.
+ *
+ * @material A material description.
+ * @area A cross section in m².
+ * @t_init An initial temperature in °C.
+ * @t_final A final temperature in °C.
+ *
+ * @return I²t in A²s.
+ */
+double elec_i2t(const struct elec_material *material, double area,
+                double t_init, double t_final);
+
+/**
+ * Calculates a current that melts the conductor in a given time.
+ *
+ * @material A material description.
+ * @area A cross section in m².
+ * @t_ambient An initial temperature in °C.
+ * @time A time in seconds.
+ *
+ * @return A fusing current in A or NAN if material is already molten.
+ */
+double elec_fusing_current(const struct elec_material *material, double area,
+                           double t_ambient, double time);
+
+/**
+ * Calculates a current that melts a wire in free air over long time using
+ * Preece equation I = a * d^(3/2).
+ *
+ * @material A material description.
+ * @diameter A wire diameter in m.
+ *
+ * @return A fusing current in A or NAN if Preece constant is not known for
+ *         the material.
+ */
+double elec_fusing_current_preece(const struct elec_material *material, double diameter);
+
+/**
+ * Calculates fusing current, see elec_fusing_current().
+ *
+ * @material A material description.
+ * @cross_section A conductor cross section.
+ * @t_ambient An initial temperature in °C.
+ * @time A time in seconds.
+ *
+ * @return A fusing current in A.
+ */
+struct elec_val elec_fusing_current_block(struct elec_material *material,
+                                          struct elec_val cross_section,
+                                          double t_ambient, double time);
+
+/**
+ * Array variant of elec_i2t(), areas are in m².
+ */
+void elec_i2t_batch(const struct elec_material *material, const double *area,
+                    double t_init, double t_final, double *i2t, size_t cnt);
+
+/**
+ * Array variant of elec_fusing_current(), areas are in m² and times in s.
+ */
+void elec_fusing_current_batch(const struct elec_material *material,
+                               const double *area, const double *time,
+                               double t_ambient, double *current, size_t cnt);
+
+#endif /* ELEC_FUSE_H */
@@ -0,0 +1,148 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#include <math.h>
+#include <string.h>
+#include "elec_batch.h"
+#include "elec_geometry.h"
+
+/* Conductors per batch kernel call */
+#define BATCH_CHUNK 256
+
+const char *const elec_geometry_names[ELEC_GEOMETRY_CNT] = {
+	[ELEC_GEOMETRY_ROUND] = "round",
+	[ELEC_GEOMETRY_RECT] = "rect",
+	[ELEC_GEOMETRY_TUBE] = "tube",
+	[ELEC_GEOMETRY_STRANDED] = "stranded",
+};
+
+int elec_geometry_by_name(const char *name)
+{
+	int i;
+
+	for (i = 0; i < ELEC_GEOMETRY_CNT; i++) {
+		if (!strcmp(elec_geometry_names[i], name))
+			return i;
+	}
+
+	return -1;
+}
+
+static double circle_area(double d)
+{
+	return M_PI * d * d / 4;
+}
+
+double elec_geometry_area(const struct elec_geometry *geometry)
+{
+	const struct elec_geometry *g = geometry;
+	double r;
+
+	switch (g->type) {
+	case ELEC_GEOMETRY_ROUND:
+		if (!(g->round.diameter > 0))
+			break;
+
+		return circle_area(g->round.diameter);
+	case ELEC_GEOMETRY_RECT:
+		r = g->rect.radius;
+
+		if (!(g->rect.width > 0) || !(g->rect.height > 0) || !(r >= 0) ||
+		    2 * r > g->rect.width || 2 * r > g->rect.height)
+			break;
+
+		/* Four rounded corners remove (4 - pi) r² */
+		return g->rect.width * g->rect.height - (4 - M_PI) * r * r;
+	case ELEC_GEOMETRY_TUBE:
+		if (!(g->tube.wall > 0) || 2 * g->tube.wall > g->tube.diameter)
+			break;
+
+		return M_PI * g->tube.wall * (g->tube.diameter - g->tube.wall);
+	case ELEC_GEOMETRY_STRANDED:
+		if (!(g->stranded.diameter > 0) || !g->stranded.strands)
+			break;
+
+		return g->stranded.strands * circle_area(g->stranded.diameter);
+	case ELEC_GEOMETRY_CNT:
+	break;
+	}
+
+	return NAN;
+}
+
+double elec_geometry_lay_factor(const struct elec_geometry *geometry)
+{
+	if (geometry->type != ELEC_GEOMETRY_STRANDED)
+		return 1;
+
+	if (!(geometry->stranded.lay_factor >= 1))
+		return NAN;
+
+	return geometry->stranded.lay_factor;
+}
+
+static void geometry_vals(const struct elec_geometry *geometry, struct elec_val *length,
+                          struct elec_val *area)
+{
+	elec_unit_convert(length, ELEC_UNIT_M);
+	length->val *= elec_geometry_lay_factor(geometry);
+
+	*area = (struct elec_val) {
+		.type = ELEC_UNIT_AREA,
+		.unit = ELEC_UNIT_M2,
+		.val = elec_geometry_area(geometry),
+	};
+}
+
+struct elec_val elec_geometry_resistance(struct elec_material *material,
+                                         const struct elec_geometry *geometry,
+                                         struct elec_val length)
+{
+	struct elec_val area;
+
+	geometry_vals(geometry, &length, &area);
+
+	return elec_resistance_block(material, length, area);
+}
+
+struct elec_val elec_geometry_mass(struct elec_material *material,
+                                   const struct elec_geometry *geometry,
+                                   struct elec_val length)
+{
+	struct elec_val area;
+
+	geometry_vals(geometry, &length, &area);
+
+	return elec_mass_block(material, length, area);
+}
+
+void elec_geometry_batch(const struct elec_material *material,
+                         const struct elec_geometry *geometry, const double *length,
+                         double *area, double *resistance, double *mass, size_t cnt)
+{
+	double l[BATCH_CHUNK], a[BATCH_CHUNK];
+	size_t i, j, n;
+
+	for (i = 0; i < cnt; i += n) {
+		n = cnt - i < BATCH_CHUNK ? cnt - i : BATCH_CHUNK;
+
+		for (j = 0; j < n; j++) {
+			l[j] = length[i + j] * elec_geometry_lay_factor(&geometry[i + j]);
+			a[j] = elec_geometry_area(&geometry[i + j]);
+		}
+
+		if (area)
+			memcpy(area + i, a, n * sizeof(double));
+
+		if (resistance)
+			elec_resistance_batch(material, l, a, resistance + i, n);
+
+		if (mass)
+			elec_mass_batch(material, l, a, mass + i, n);
+	}
+}
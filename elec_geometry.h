@@ -0,0 +1,133 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Conductor geometries beyond a solid round wire.
+ *
+ * A geometry is reduced to the metal cross section and a lay factor, i.e.
+ * the conductor length per unit of cable length, which is 1 for all solid
+ * conductors. Strands of a stranded conductor are twisted, hence each strand
+ * is longer than the cable by the lay factor, typically 1.02 to 1.04, which
+ * increases both the resistance and the mass.
+ */
+
+#ifndef ELEC_GEOMETRY_H
+#define ELEC_GEOMETRY_H
+
+#include <stddef.h>
+#include "libelec.h"
+
+enum elec_geometry_type {
+	ELEC_GEOMETRY_ROUND,
+	ELEC_GEOMETRY_RECT,
+	ELEC_GEOMETRY_TUBE,
+	ELEC_GEOMETRY_STRANDED,
+	ELEC_GEOMETRY_CNT,
+};
+
+extern const char *const elec_geometry_names[ELEC_GEOMETRY_CNT];
+
+/**
+ * Conductor geometry, all dimensions are in meters.
+ */
+struct elec_geometry {
+	enum elec_geometry_type type;
+	union {
+		struct {
+			double diameter;
+		} round;
+		/* a busbar */
+		struct {
+			double width;
+			double height;
+			/* edge radius, zero for sharp edges */
+			double radius;
+		} rect;
+		struct {
+			double diameter;
+			double wall;
+		} tube;
+		struct {
+			double diameter;
+			unsigned int strands;
+			double lay_factor;
+		} stranded;
+	};
+};
+
+/**
+ * Looks up geometry type by name, e.g. "rect".
+ *
+ * @return A geometry type or -1 if not found.
+ */
+int elec_geometry_by_name(const char *name);
+
+/**
+ * Computes the metal cross section.
+ *
+ * @geometry A conductor geometry.
+ *
+ * @return A cross section in m² or NaN for invalid geometry, e.g. a tube wall
+ *         thicker than the radius.
+ */
+double elec_geometry_area(const struct elec_geometry *geometry);
+
+/**
+ * Returns the conductor length per unit of cable length.
+ *
+ * @geometry A conductor geometry.
+ *
+ * @return A lay factor, 1 for solid conductors.
+ */
+double elec_geometry_lay_factor(const struct elec_geometry *geometry);
+
+/**
+ * Calculates resistance of a conductor, elec_resistance_block() for the
+ * metal cross section and length multiplied by the lay factor.
+ *
+ * @material A material description.
+ * @geometry A conductor geometry.
+ * @length A cable length.
+ *
+ * @return Resistance in Ohms.
+ */
+struct elec_val elec_geometry_resistance(struct elec_material *material,
+                                         const struct elec_geometry *geometry,
+                                         struct elec_val length);
+
+/**
+ * Calculates mass of a conductor, elec_mass_block() for the metal cross
+ * section and length multiplied by the lay factor.
+ *
+ * @material A material description.
+ * @geometry A conductor geometry.
+ * @length A cable length.
+ *
+ * @return A mass in kilograms.
+ */
+struct elec_val elec_geometry_mass(struct elec_material *material,
+                                   const struct elec_geometry *geometry,
+                                   struct elec_val length);
+
+/**
+ * Resistance and mass of an array of conductors of a single material using
+ * the batch kernels.
+ *
+ * @material A material description.
+ * @geometry An array of geometries.
+ * @length An array of cable lengths in m.
+ * @area An output array of cross sections in m², may be NULL.
+ * @resistance An output array of resistances in Ohm, may be NULL.
+ * @mass An output array of masses in kg, may be NULL.
+ * @cnt Number of conductors.
+ */
+void elec_geometry_batch(const struct elec_material *material,
+                         const struct elec_geometry *geometry, const double *length,
+                         double *area, double *resistance, double *mass, size_t cnt);
+
+#endif /* ELEC_GEOMETRY_H */
@@ -0,0 +1,191 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#include <math.h>
+#include <string.h>
+#include "elec_heatrun.h"
+
+/* Maximal number of fit coefficients */
+#define COEFS 3
+
+const char *const elec_heatrun_fit_names[ELEC_HEATRUN_FIT_CNT] = {
+	[ELEC_HEATRUN_LINEAR] = "linear",
+	[ELEC_HEATRUN_QUADRATIC] = "quadratic",
+	[ELEC_HEATRUN_EXP] = "exp",
+};
+
+int elec_heatrun_fit_by_name(const char *name)
+{
+	int i;
+
+	for (i = 0; i < ELEC_HEATRUN_FIT_CNT; i++) {
+		if (!strcmp(elec_heatrun_fit_names[i], name))
+			return i;
+	}
+
+	return -1;
+}
+
+double elec_heatrun_temp(const struct elec_material *material, double r_cold,
+                         double t_cold, double r_hot)
+{
+	if (!(material->tc > 0))
+		return NAN;
+
+	return t_cold + (r_hot / r_cold - 1) * (1 / material->tc + t_cold - ELEC_TEMP_REF);
+}
+
+void elec_heatrun_reset(struct elec_heatrun *hr)
+{
+	memset(hr->st, 0, sizeof(hr->st));
+	memset(hr->sty, 0, sizeof(hr->sty));
+	hr->syy = 0;
+	memset(hr->lst, 0, sizeof(hr->lst));
+	memset(hr->lsty, 0, sizeof(hr->lsty));
+	hr->lsyy = 0;
+}
+
+double elec_heatrun_sample(struct elec_heatrun *hr, double time, double r_hot)
+{
+	double temp = elec_heatrun_temp(hr->material, hr->r_cold, hr->t_cold, r_hot);
+	double t = time - hr->t_shutdown;
+	double tk = 1, y;
+	unsigned int k;
+
+	if (!(t >= 0 && t <= hr->window) || !isfinite(temp))
+		return temp;
+
+	for (k = 0; k < 5; k++) {
+		hr->st[k] += tk;
+		if (k < 3)
+			hr->sty[k] += tk * temp;
+		tk *= t;
+	}
+
+	hr->syy += temp * temp;
+
+	if (!(temp > hr->t_coolant))
+		return temp;
+
+	y = log(temp - hr->t_coolant);
+
+	hr->lst[0] += 1;
+	hr->lst[1] += t;
+	hr->lst[2] += t * t;
+	hr->lsty[0] += y;
+	hr->lsty[1] += t * y;
+	hr->lsyy += y * y;
+
+	return temp;
+}
+
+/*
+ * Solves the normal equations for polynomial coefficients by Gaussian
+ * elimination with partial pivoting and computes the residual sum of
+ * squares, returns non-zero if the system is singular.
+ */
+static int least_squares(const double *st, const double *sty, double syy,
+                         unsigned int cnt, double *coef, double *ssr)
+{
+	double a[COEFS][COEFS + 1], tmp;
+	unsigned int i, j, k, p;
+
+	for (i = 0; i < cnt; i++) {
+		for (j = 0; j < cnt; j++)
+			a[i][j] = st[i + j];
+
+		a[i][cnt] = sty[i];
+	}
+
+	for (i = 0; i < cnt; i++) {
+		p = i;
+
+		for (j = i + 1; j < cnt; j++) {
+			if (fabs(a[j][i]) > fabs(a[p][i]))
+				p = j;
+		}
+
+		if (!(fabs(a[p][i]) > 0))
+			return 1;
+
+		for (k = 0; k <= cnt; k++) {
+			tmp = a[i][k];
+			a[i][k] = a[p][k];
+			a[p][k] = tmp;
+		}
+
+		for (j = i + 1; j < cnt; j++) {
+			tmp = a[j][i] / a[i][i];
+
+			for (k = i; k <= cnt; k++)
+				a[j][k] -= tmp * a[i][k];
+		}
+	}
+
+	for (i = cnt; i-- > 0;) {
+		tmp = a[i][cnt];
+
+		for (k = i + 1; k < cnt; k++)
+			tmp -= a[i][k] * coef[k];
+
+		coef[i] = tmp / a[i][i];
+	}
+
+	*ssr = syy;
+
+	for (i = 0; i < cnt; i++)
+		*ssr -= coef[i] * sty[i];
+
+	/* Cancellation for an exact fit */
+	if (*ssr < 0)
+		*ssr = 0;
+
+	return 0;
+}
+
+int elec_heatrun_fit(const struct elec_heatrun *hr, enum elec_heatrun_fit fit,
+                     struct elec_heatrun_result *res)
+{
+	double coef[COEFS], ssr;
+	unsigned int cnt;
+
+	res->temp = NAN;
+	res->rise = NAN;
+	res->tau = NAN;
+	res->rms = NAN;
+
+	switch (fit) {
+	case ELEC_HEATRUN_LINEAR:
+	case ELEC_HEATRUN_QUADRATIC:
+		cnt = fit == ELEC_HEATRUN_LINEAR ? 2 : 3;
+		res->samples = hr->st[0];
+
+		if (res->samples < cnt || least_squares(hr->st, hr->sty, hr->syy, cnt, coef, &ssr))
+			return 1;
+
+		res->temp = coef[0];
+		res->rise = coef[0] - hr->t_coolant;
+		res->rms = sqrt(ssr / res->samples);
+	break;
+	case ELEC_HEATRUN_EXP:
+		res->samples = hr->lst[0];
+
+		if (res->samples < 2 || least_squares(hr->lst, hr->lsty, hr->lsyy, 2, coef, &ssr))
+			return 1;
+
+		res->rise = exp(coef[0]);
+		res->temp = hr->t_coolant + res->rise;
+		res->tau = coef[1] < 0 ? -1 / coef[1] : NAN;
+		res->rms = sqrt(ssr / res->samples);
+	break;
+	default:
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,142 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Winding temperature from resistance rise as measured in motor and
+ * transformer heat-run tests.
+ *
+ * The resistance grows linearly with temperature, hence a winding that has
+ * cold resistance Rc at temperature Tc has temperature
+ *
+ * Th = Tc + (Rh / Rc - 1) * (1 / tc + Tc - 20)
+ *
+ * at hot resistance Rh, where 1 / tc - 20 is the constant the standards
+ * tabulate, e.g. 234.5 °C for copper in IEC 60034-1, the temperature
+ * coefficients of the material table give slightly different values.
+ *
+ * The hot resistance can be measured only once the machine is stopped and
+ * the winding cools down while it is being measured. The temperature at the
+ * shutdown is extrapolated from a cooling curve fitted to the samples. The
+ * samples are accumulated into least squares sums as they come so that logs
+ * of any length are processed in a single pass without storing them.
+ */
+
+#ifndef ELEC_HEATRUN_H
+#define ELEC_HEATRUN_H
+
+#include <stddef.h>
+#include "libelec.h"
+
+enum elec_heatrun_fit {
+	/* T = a + b * t */
+	ELEC_HEATRUN_LINEAR,
+	/* T = a + b * t + c * t² */
+	ELEC_HEATRUN_QUADRATIC,
+	/* T = Tcoolant + a * e^(-t / tau) fitted as a line to ln(T - Tcoolant) */
+	ELEC_HEATRUN_EXP,
+	ELEC_HEATRUN_FIT_CNT,
+};
+
+extern const char *const elec_heatrun_fit_names[ELEC_HEATRUN_FIT_CNT];
+
+/**
+ * Looks up a fit by name, e.g. "exp".
+ *
+ * @return A fit or -1 if not found.
+ */
+int elec_heatrun_fit_by_name(const char *name);
+
+/**
+ * Computes winding temperature from resistance rise.
+ *
+ * @material A winding material.
+ * @r_cold A cold resistance in Ohms.
+ * @t_cold A cold winding temperature in °C.
+ * @r_hot A hot resistance in Ohms.
+ *
+ * @return A hot temperature in °C or NaN if the material resistance does
+ *         not depend on temperature.
+ */
+double elec_heatrun_temp(const struct elec_material *material, double r_cold,
+                         double t_cold, double r_hot);
+
+/**
+ * A heat-run test, the inputs are filled in by the caller before
+ * elec_heatrun_reset() is called.
+ */
+struct elec_heatrun {
+	const struct elec_material *material;
+	/* cold resistance in Ohms and winding temperature in °C */
+	double r_cold;
+	double t_cold;
+	/* coolant temperature at the end of the test in °C */
+	double t_coolant;
+	/* shutdown time, sample times are in the same units, usually seconds */
+	double t_shutdown;
+	/* only samples up to window after the shutdown are fitted */
+	double window;
+
+	/* least squares sums of t^k, t^k * T and T² */
+	double st[5];
+	double sty[3];
+	double syy;
+	/* the same for the exponential fit where y = ln(T - Tcoolant) */
+	double lst[3];
+	double lsty[2];
+	double lsyy;
+};
+
+/**
+ * Result of a fit extrapolated to the shutdown.
+ */
+struct elec_heatrun_result {
+	/* winding temperature in °C and rise over coolant in K at shutdown */
+	double temp;
+	double rise;
+	/* cooling time constant for the exponential fit, NaN otherwise */
+	double tau;
+	/*
+	 * RMS of the fit residuals in K, for the exponential fit relative to
+	 * the temperature rise.
+	 */
+	double rms;
+	size_t samples;
+};
+
+/**
+ * Clears the fit sums.
+ */
+void elec_heatrun_reset(struct elec_heatrun *hr);
+
+/**
+ * Computes the winding temperature of a sample and adds it to the fit if it
+ * was taken between the shutdown and the end of the window.
+ *
+ * @hr A heat-run test.
+ * @time A sample time.
+ * @r_hot A resistance in Ohms.
+ *
+ * @return A winding temperature in °C.
+ */
+double elec_heatrun_sample(struct elec_heatrun *hr, double time, double r_hot);
+
+/**
+ * Fits the samples and extrapolates to the shutdown.
+ *
+ * @hr A heat-run test.
+ * @fit A fit type.
+ * @res A result.
+ *
+ * @return Zero on success, non-zero if there is not enough samples for the
+ *         fit, the exponential fit needs samples above the coolant
+ *         temperature.
+ */
+int elec_heatrun_fit(const struct elec_heatrun *hr, enum elec_heatrun_fit fit,
+                     struct elec_heatrun_result *res);
+
+#endif /* ELEC_HEATRUN_H */
@@ -0,0 +1,176 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include "elec_ident.h"
+
+double elec_ident_resistivity(struct elec_val resistance, struct elec_val length,
+                              struct elec_val cross_section)
+{
+	elec_unit_convert(&resistance, ELEC_UNIT_OHM);
+	elec_unit_convert(&length, ELEC_UNIT_M);
+	elec_unit_convert(&cross_section, ELEC_UNIT_M2);
+
+	return resistance.val * cross_section.val / length.val;
+}
+
+double elec_ident_density(struct elec_val mass, struct elec_val length,
+                          struct elec_val cross_section)
+{
+	elec_unit_convert(&mass, ELEC_UNIT_kG);
+	elec_unit_convert(&length, ELEC_UNIT_M);
+	elec_unit_convert(&cross_section, ELEC_UNIT_M2);
+
+	return mass.val / (length.val * cross_section.val);
+}
+
+static int cmp_ro(const void *p1, const void *p2)
+{
+	const struct elec_ident_entry *a = p1, *b = p2;
+
+	if (a->log_ro != b->log_ro)
+		return a->log_ro < b->log_ro ? -1 : 1;
+
+	return 0;
+}
+
+int elec_ident_index_init(struct elec_ident_index *idx,
+                          struct elec_material *materials, size_t cnt)
+{
+	size_t i;
+
+	idx->cnt = 0;
+	idx->tc_max = 0;
+	idx->entries = NULL;
+
+	if (!cnt)
+		return 0;
+
+	idx->entries = malloc(cnt * sizeof(*idx->entries));
+	if (!idx->entries)
+		return 1;
+
+	for (i = 0; i < cnt; i++) {
+		struct elec_ident_entry *e = &idx->entries[idx->cnt];
+
+		if (!(materials[i].ro > 0) || !(materials[i].density > 0))
+			continue;
+
+		e->log_ro = log(materials[i].ro);
+		e->log_density = log(materials[i].density);
+		/* unknown temperature coefficient */
+		e->tc = isnan(materials[i].tc) ? 0 : materials[i].tc;
+		e->material = &materials[i];
+
+		if (fabs(e->tc) > idx->tc_max)
+			idx->tc_max = fabs(e->tc);
+
+		idx->cnt++;
+	}
+
+	qsort(idx->entries, idx->cnt, sizeof(*idx->entries), cmp_ro);
+
+	return 0;
+}
+
+void elec_ident_index_exit(struct elec_ident_index *idx)
+{
+	free(idx->entries);
+	idx->entries = NULL;
+	idx->cnt = 0;
+}
+
+static size_t lower_bound(const struct elec_ident_index *idx, double log_ro)
+{
+	size_t lo = 0, hi = idx->cnt;
+
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+
+		if (idx->entries[mid].log_ro < log_ro)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
+static size_t insert_match(struct elec_ident_match *matches, size_t cnt, size_t max,
+                           struct elec_material *material, double dist)
+{
+	size_t i;
+
+	if (cnt == max) {
+		if (!max || dist >= matches[max - 1].dist)
+			return cnt;
+		cnt--;
+	}
+
+	for (i = cnt; i > 0 && matches[i - 1].dist > dist; i--)
+		matches[i] = matches[i - 1];
+
+	matches[i].material = material;
+	matches[i].dist = dist;
+
+	return cnt + 1;
+}
+
+size_t elec_ident_lookup(const struct elec_ident_index *idx,
+                         const struct elec_ident_query *query,
+                         struct elec_ident_match *matches, size_t max)
+{
+	double s_ro = log1p(query->ro_tol), s_density = log1p(query->density_tol);
+	double dt = query->temp - ELEC_TEMP_REF, log_ro, log_density, widen, hi, sum = 0;
+	int use_density = !isnan(query->density);
+	size_t i, ret = 0;
+
+	if (!(query->ro > 0) || !(s_ro > 0))
+		return 0;
+
+	if (use_density && (!(query->density > 0) || !(s_density > 0)))
+		return 0;
+
+	log_ro = log(query->ro);
+	log_density = use_density ? log(query->density) : 0;
+
+	/* Resistivity at the sample temperature can shift at most by this */
+	if (idx->tc_max * fabs(dt) < 1)
+		widen = -log1p(-idx->tc_max * fabs(dt));
+	else
+		widen = INFINITY;
+
+	hi = log_ro + ELEC_IDENT_DIST_MAX * s_ro + widen;
+
+	for (i = lower_bound(idx, log_ro - ELEC_IDENT_DIST_MAX * s_ro - widen);
+	     i < idx->cnt && idx->entries[i].log_ro <= hi; i++) {
+		const struct elec_ident_entry *e = &idx->entries[i];
+		double d2, err;
+
+		err = (log_ro - e->log_ro - log1p(e->tc * dt)) / s_ro;
+		d2 = err * err;
+
+		if (use_density) {
+			err = (log_density - e->log_density) / s_density;
+			d2 += err * err;
+		}
+
+		if (!(d2 <= ELEC_IDENT_DIST_MAX * ELEC_IDENT_DIST_MAX))
+			continue;
+
+		/* Materials further away contribute less than exp(-8) */
+		sum += exp(-d2 / 2);
+		ret = insert_match(matches, ret, max, e->material, sqrt(d2));
+	}
+
+	for (i = 0; i < ret; i++)
+		matches[i].confidence = exp(-matches[i].dist * matches[i].dist / 2) / sum;
+
+	return ret;
+}
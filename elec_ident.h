@@ -0,0 +1,128 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Material identification from measured samples.
+ *
+ * Resistivity and density of a sample are estimated from its resistance,
+ * mass and dimensions and matched against the material table. Both are
+ * compared in logarithmic scale, i.e. by relative error, and the distance is
+ * measured in multiples of the measurement uncertainty.
+ *
+ * The index is sorted by resistivity only, a lookup bisects to the
+ * resistivity window and checks the density of the materials within it. The
+ * density is not indexed as it is optional and the window holds a handful of
+ * the few tens of materials in the table, a second sorted dimension would
+ * not make the lookup any faster.
+ */
+
+#ifndef ELEC_IDENT_H
+#define ELEC_IDENT_H
+
+#include <stddef.h>
+#include "libelec.h"
+
+/**
+ * Calculates resistivity from a sample resistance, inverse of
+ * elec_resistance_block().
+ *
+ * @resistance A sample resistance.
+ * @length A sample length.
+ * @cross_section A sample cross section.
+ *
+ * @return A resistivity in Ohm m.
+ */
+double elec_ident_resistivity(struct elec_val resistance, struct elec_val length,
+                              struct elec_val cross_section);
+
+/**
+ * Calculates density from a sample mass, inverse of elec_mass_block().
+ *
+ * @mass A sample mass.
+ * @length A sample length.
+ * @cross_section A sample cross section.
+ *
+ * @return A density in kg/m³.
+ */
+double elec_ident_density(struct elec_val mass, struct elec_val length,
+                          struct elec_val cross_section);
+
+struct elec_ident_entry {
+	double log_ro;
+	double log_density;
+	double tc;
+	struct elec_material *material;
+};
+
+/**
+ * Materials sorted by resistivity.
+ */
+struct elec_ident_index {
+	size_t cnt;
+	/* largest temperature coefficient, widens the search window */
+	double tc_max;
+	struct elec_ident_entry *entries;
+};
+
+/**
+ * Builds an index of materials.
+ *
+ * @return Zero on success, non-zero on allocation failure.
+ */
+int elec_ident_index_init(struct elec_ident_index *idx,
+                          struct elec_material *materials, size_t cnt);
+
+void elec_ident_index_exit(struct elec_ident_index *idx);
+
+struct elec_ident_query {
+	/* estimated resistivity in Ohm m */
+	double ro;
+	/* estimated density in kg/m³, NAN if sample was not weighted */
+	double density;
+	/* sample temperature in °C */
+	double temp;
+	/* relative standard uncertainty of the estimates e.g. 0.02 */
+	double ro_tol;
+	double density_tol;
+};
+
+struct elec_ident_match {
+	struct elec_material *material;
+	/* distance in multiples of the standard uncertainty */
+	double dist;
+	/*
+	 * probability of the match among the materials within
+	 * ELEC_IDENT_DIST_MAX, the materials further away are not counted
+	 */
+	double confidence;
+};
+
+/*
+ * Materials further than this are not matched at all.
+ */
+#define ELEC_IDENT_DIST_MAX 4
+
+/**
+ * Looks up materials closest to the estimated resistivity and density.
+ *
+ * The confidence assumes normal distribution of the measurement errors and
+ * that all materials are equally likely, i.e. materials with the same
+ * properties share the confidence.
+ *
+ * @idx A material index.
+ * @query Estimated properties of the sample.
+ * @matches An output array sorted by distance.
+ * @max Size of the output array.
+ *
+ * @return Number of matches, zero if no material is close enough.
+ */
+size_t elec_ident_lookup(const struct elec_ident_index *idx,
+                         const struct elec_ident_query *query,
+                         struct elec_ident_match *matches, size_t max);
+
+#endif /* ELEC_IDENT_H */
@@ -0,0 +1,300 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include "elec_ring.h"
+#include "elec_live.h"
+
+#define READ_SIZE 65536
+#define BATCH 256
+
+struct elec_live {
+	int fd;
+	pthread_t thread;
+	struct elec_ring ring;
+
+	atomic_size_t dropped;
+	atomic_size_t errors;
+	atomic_int eof;
+
+	/* line split over read() boundary */
+	size_t carry;
+	char buf[2 * READ_SIZE + 1];
+};
+
+static int open_socket(const char *path)
+{
+	struct sockaddr_un addr = {.sun_family = AF_UNIX};
+	int fd;
+
+	if (strlen(path) >= sizeof(addr.sun_path)) {
+		errno = ENAMETOOLONG;
+		return -1;
+	}
+
+	strcpy(addr.sun_path, path);
+
+	fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (fd < 0)
+		return -1;
+
+	if (connect(fd, (struct sockaddr *)&addr, sizeof(addr))) {
+		close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+static int open_source(const char *path)
+{
+	struct stat st;
+
+	if (!strcmp(path, "-"))
+		return dup(STDIN_FILENO);
+
+	if (!stat(path, &st) && S_ISSOCK(st.st_mode))
+		return open_socket(path);
+
+	return open(path, O_RDONLY | O_CLOEXEC | O_NOCTTY);
+}
+
+static int parse_sep(char c)
+{
+	return c == ' ' || c == '\t' || c == ',' || c == ';';
+}
+
+int elec_live_parse(const char *str, size_t len, struct elec_sample *sample)
+{
+	char buf[ELEC_LIVE_LINE_MAX + 1], *line = buf, *end;
+
+	/* strtod() skips newlines, the line has to end where it ends */
+	if (len > ELEC_LIVE_LINE_MAX)
+		return -1;
+
+	memcpy(buf, str, len);
+	buf[len] = 0;
+
+	while (parse_sep(*line))
+		line++;
+
+	if (!*line || *line == '#' || *line == '\r')
+		return 1;
+
+	sample->u = strtod(line, &end);
+	if (end == line || !parse_sep(*end))
+		return -1;
+
+	line = end;
+	while (parse_sep(*line))
+		line++;
+
+	sample->i = strtod(line, &end);
+	if (end == line)
+		return -1;
+
+	while (parse_sep(*end) || *end == '\r')
+		end++;
+
+	return *end ? -1 : 0;
+}
+
+static void push(struct elec_live *live, struct elec_sample *samples, size_t cnt)
+{
+	size_t pushed = elec_ring_push(&live->ring, samples, cnt);
+
+	if (pushed < cnt)
+		atomic_fetch_add_explicit(&live->dropped, cnt - pushed, memory_order_relaxed);
+}
+
+/*
+ * Parses all complete lines in the buffer and moves the incomplete one to
+ * the start.
+ */
+static void parse_buf(struct elec_live *live, size_t len)
+{
+	struct elec_sample samples[BATCH];
+	char *line = live->buf, *end = live->buf + len, *nl;
+	size_t cnt = 0, errors = 0;
+
+	while ((nl = memchr(line, '\n', end - line))) {
+		switch (elec_live_parse(line, nl - line, &samples[cnt])) {
+		case 0:
+			if (++cnt == BATCH) {
+				push(live, samples, cnt);
+				cnt = 0;
+			}
+		break;
+		case -1:
+			errors++;
+		break;
+		}
+
+		line = nl + 1;
+	}
+
+	push(live, samples, cnt);
+
+	if (errors)
+		atomic_fetch_add_explicit(&live->errors, errors, memory_order_relaxed);
+
+	live->carry = end - line;
+
+	/* Overlong line, throw it away */
+	if (live->carry > READ_SIZE) {
+		atomic_fetch_add_explicit(&live->errors, 1, memory_order_relaxed);
+		live->carry = 0;
+	}
+
+	memmove(live->buf, line, live->carry);
+}
+
+static void *reader(void *arg)
+{
+	struct elec_live *live = arg;
+	ssize_t ret;
+
+	for (;;) {
+		ret = read(live->fd, live->buf + live->carry, READ_SIZE);
+
+		if (ret < 0 && errno == EINTR)
+			continue;
+
+		if (ret <= 0)
+			break;
+
+		parse_buf(live, live->carry + ret);
+	}
+
+	atomic_store(&live->eof, 1);
+
+	return NULL;
+}
+
+struct elec_live *elec_live_open(const char *path, size_t ring_size)
+{
+	struct elec_live *live = malloc(sizeof(*live));
+	int err;
+
+	if (!live)
+		return NULL;
+
+	memset(live, 0, offsetof(struct elec_live, buf));
+
+	live->fd = open_source(path);
+	if (live->fd < 0)
+		goto err0;
+
+	if (elec_ring_init(&live->ring, ring_size ? ring_size : ELEC_LIVE_RING_SIZE))
+		goto err1;
+
+	atomic_init(&live->dropped, 0);
+	atomic_init(&live->errors, 0);
+	atomic_init(&live->eof, 0);
+
+	err = pthread_create(&live->thread, NULL, reader, live);
+	if (err) {
+		errno = err;
+		goto err2;
+	}
+
+	return live;
+err2:
+	elec_ring_exit(&live->ring);
+err1:
+	err = errno;
+	close(live->fd);
+	errno = err;
+err0:
+	free(live);
+	return NULL;
+}
+
+void elec_live_close(struct elec_live *live)
+{
+	if (!atomic_load(&live->eof))
+		pthread_cancel(live->thread);
+
+	pthread_join(live->thread, NULL);
+
+	close(live->fd);
+	elec_ring_exit(&live->ring);
+	free(live);
+}
+
+static void stat_init(struct elec_decimated *s)
+{
+	s->min = INFINITY;
+	s->max = -INFINITY;
+	s->mean = 0;
+}
+
+static inline void stat_add(struct elec_decimated *s, double val)
+{
+	s->min = val < s->min ? val : s->min;
+	s->max = val > s->max ? val : s->max;
+	s->mean += val;
+}
+
+static void stat_finish(struct elec_decimated *s, size_t cnt)
+{
+	if (!cnt) {
+		s->min = s->max = s->mean = NAN;
+		return;
+	}
+
+	s->mean /= cnt;
+}
+
+void elec_live_frame(struct elec_live *live, struct elec_live_frame *frame)
+{
+	struct elec_sample samples[BATCH];
+	size_t i, cnt, avail;
+
+	frame->cnt = 0;
+
+	stat_init(&frame->u);
+	stat_init(&frame->i);
+	stat_init(&frame->r);
+	stat_init(&frame->p);
+
+	frame->eof = atomic_load(&live->eof);
+
+	/* Only what was there when we started, a fast producer would keep us here forever */
+	avail = atomic_load_explicit(&live->ring.head, memory_order_acquire) -
+	               atomic_load_explicit(&live->ring.tail, memory_order_relaxed);
+
+	while (avail && (cnt = elec_ring_pop(&live->ring, samples, avail < BATCH ? avail : BATCH))) {
+		for (i = 0; i < cnt; i++) {
+			stat_add(&frame->u, samples[i].u);
+			stat_add(&frame->i, samples[i].i);
+			stat_add(&frame->r, samples[i].u / samples[i].i);
+			stat_add(&frame->p, samples[i].u * samples[i].i);
+		}
+
+		frame->cnt += cnt;
+		avail -= cnt;
+	}
+
+	stat_finish(&frame->u, frame->cnt);
+	stat_finish(&frame->i, frame->cnt);
+	stat_finish(&frame->r, frame->cnt);
+	stat_finish(&frame->p, frame->cnt);
+
+	frame->dropped = atomic_load_explicit(&live->dropped, memory_order_relaxed);
+	frame->errors = atomic_load_explicit(&live->errors, memory_order_relaxed);
+}
@@ -0,0 +1,86 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Live stream of voltage and current samples.
+ *
+ * The samples are read as text lines "U I" in volts and amperes, the values
+ * may be separated by whitespace, comma or semicolon and lines starting with
+ * '#' are ignored. The source can be a pipe, FIFO, pty, character device,
+ * regular file, UNIX socket or "-" for stdin.
+ *
+ * Samples are parsed in a reader thread and passed to the consumer through
+ * a lock-free ring buffer. The consumer periodically collects everything
+ * that arrived since the last call into a frame, so that arbitrary sample
+ * rate is decimated to the display rate.
+ */
+
+#ifndef ELEC_LIVE_H
+#define ELEC_LIVE_H
+
+#include <stddef.h>
+#include "elec_decimate.h"
+#include "elec_ring.h"
+
+#define ELEC_LIVE_RING_SIZE (1 << 20)
+
+struct elec_live;
+
+struct elec_live_frame {
+	/* number of samples in the frame */
+	size_t cnt;
+	/* totals since the stream was opened */
+	size_t dropped;
+	size_t errors;
+	/* the reader has reached end of the stream */
+	int eof;
+
+	struct elec_decimated u;
+	struct elec_decimated i;
+	/* per sample R = U/I and P = U*I */
+	struct elec_decimated r;
+	struct elec_decimated p;
+};
+
+/**
+ * Opens a stream and starts the reader thread.
+ *
+ * @path A path to the source or "-" for stdin.
+ * @ring_size A size of the ring buffer in samples, 0 for ELEC_LIVE_RING_SIZE.
+ *
+ * @return A stream or NULL on failure with errno set.
+ */
+struct elec_live *elec_live_open(const char *path, size_t ring_size);
+
+/**
+ * Stops the reader thread and closes the stream.
+ */
+void elec_live_close(struct elec_live *live);
+
+/**
+ * Collects all samples received since the last call.
+ *
+ * If no samples were received the cnt is zero and all the statistics are NAN.
+ */
+void elec_live_frame(struct elec_live *live, struct elec_live_frame *frame);
+
+/* Longest sample line elec_live_parse() accepts */
+#define ELEC_LIVE_LINE_MAX 256
+
+/**
+ * Parses a single sample line.
+ *
+ * @line A line of text, does not have to be null terminated.
+ * @len A line length without the newline.
+ * @sample An output sample.
+ *
+ * @return Zero on success, 1 for empty and comment lines, -1 on invalid line.
+ */
+int elec_live_parse(const char *line, size_t len, struct elec_sample *sample);
+
+#endif /* ELEC_LIVE_H */
@@ -0,0 +1,103 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "elec_par.h"
+
+unsigned int elec_par_threads(void)
+{
+	static unsigned int threads;
+	const char *env;
+	long cpus;
+
+	if (threads)
+		return threads;
+
+	env = getenv("ELEC_THREADS");
+	if (env && atoi(env) > 0) {
+		threads = atoi(env);
+	} else {
+		cpus = sysconf(_SC_NPROCESSORS_ONLN);
+		threads = cpus > 0 ? cpus : 1;
+	}
+
+	if (threads > ELEC_PAR_MAX_THREADS)
+		threads = ELEC_PAR_MAX_THREADS;
+
+	return threads;
+}
+
+struct par_range {
+	pthread_t thread;
+	void (*fn)(void *priv, size_t from, size_t to);
+	void *priv;
+	size_t from;
+	size_t to;
+};
+
+static void *par_worker(void *arg)
+{
+	struct par_range *r = arg;
+
+	r->fn(r->priv, r->from, r->to);
+
+	return NULL;
+}
+
+int elec_par_for(size_t cnt, unsigned int threads,
+                 void (*fn)(void *priv, size_t from, size_t to), void *priv)
+{
+	struct par_range ranges[ELEC_PAR_MAX_THREADS];
+	unsigned int i, started = 0;
+	int ret = 0;
+
+	if (!cnt)
+		return 0;
+
+	if (!threads)
+		threads = elec_par_threads();
+
+	if (threads > ELEC_PAR_MAX_THREADS)
+		threads = ELEC_PAR_MAX_THREADS;
+
+	if (threads > cnt)
+		threads = cnt;
+
+	if (threads <= 1) {
+		fn(priv, 0, cnt);
+		return 0;
+	}
+
+	for (i = 0; i < threads; i++) {
+		ranges[i].fn = fn;
+		ranges[i].priv = priv;
+		ranges[i].from = cnt * i / threads;
+		ranges[i].to = cnt * (i + 1) / threads;
+	}
+
+	/* The first range is processed by the calling thread */
+	for (i = 1; i < threads; i++) {
+		if (pthread_create(&ranges[i].thread, NULL, par_worker, &ranges[i])) {
+			ret = 1;
+			break;
+		}
+		started++;
+	}
+
+	for (i = started + 1; i < threads; i++)
+		fn(priv, ranges[i].from, ranges[i].to);
+
+	fn(priv, ranges[0].from, ranges[0].to);
+
+	for (i = 1; i <= started; i++)
+		pthread_join(ranges[i].thread, NULL);
+
+	return ret;
+}
@@ -0,0 +1,40 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#ifndef ELEC_PAR_H
+#define ELEC_PAR_H
+
+#include <stddef.h>
+
+/* Upper bound for the number of threads */
+#define ELEC_PAR_MAX_THREADS 256
+
+/**
+ * Returns number of threads to be used for parallel work.
+ *
+ * Defaults to number of online CPUs, can be overriden by the ELEC_THREADS
+ * environment variable.
+ */
+unsigned int elec_par_threads(void);
+
+/**
+ * Splits [0, cnt) into at most threads ranges and runs fn on each of them in
+ * a separate thread. Returns once all ranges are done.
+ *
+ * @cnt A number of items.
+ * @threads A maximal number of threads, 0 means elec_par_threads().
+ * @fn A callback called for each range.
+ * @priv A pointer passed down to the callback.
+ *
+ * @return Zero on success, non-zero if thread could not be created, in that
+ *         case all the work is still done but in the calling thread.
+ */
+int elec_par_for(size_t cnt, unsigned int threads,
+                 void (*fn)(void *priv, size_t from, size_t to), void *priv);
+
+#endif /* ELEC_PAR_H */
@@ -0,0 +1,141 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#include <errno.h>
+#include <math.h>
+#include <stdlib.h>
+#include "elec_pareto.h"
+
+struct point {
+	double a;
+	double b;
+	double c;
+	size_t idx;
+	/* rank of b */
+	size_t rank;
+};
+
+static int cmp_abc(const void *p1, const void *p2)
+{
+	const struct point *x = p1, *y = p2;
+
+	if (x->a != y->a)
+		return x->a < y->a ? -1 : 1;
+
+	if (x->b != y->b)
+		return x->b < y->b ? -1 : 1;
+
+	if (x->c != y->c)
+		return x->c < y->c ? -1 : 1;
+
+	return 0;
+}
+
+static int cmp_b(const void *p1, const void *p2)
+{
+	const struct point *const *x = p1, *const *y = p2;
+
+	if ((*x)->b != (*y)->b)
+		return (*x)->b < (*y)->b ? -1 : 1;
+
+	return 0;
+}
+
+/* Fenwick tree of prefix minima, indexes are 1 based */
+static double tree_min(const double *tree, size_t i)
+{
+	double ret = INFINITY;
+
+	for (; i; i -= i & -i) {
+		if (tree[i] < ret)
+			ret = tree[i];
+	}
+
+	return ret;
+}
+
+static void tree_set(double *tree, size_t size, size_t i, double val)
+{
+	for (; i <= size; i += i & -i) {
+		if (val < tree[i])
+			tree[i] = val;
+	}
+}
+
+size_t elec_pareto_front(const double *a, const double *b, const double *c,
+                         size_t cnt, size_t *front)
+{
+	struct point *pts, **by_b;
+	size_t i, j, n = 0, ranks = 0, ret = 0;
+	double *tree;
+
+	if (!cnt) {
+		errno = EINVAL;
+		return 0;
+	}
+
+	pts = malloc(cnt * sizeof(*pts));
+	by_b = malloc(cnt * sizeof(*by_b));
+	tree = malloc((cnt + 1) * sizeof(*tree));
+
+	if (!pts || !by_b || !tree) {
+		errno = ENOMEM;
+		goto exit;
+	}
+
+	for (i = 0; i < cnt; i++) {
+		double cv = c ? c[i] : 0;
+
+		if (isnan(a[i]) || isnan(b[i]) || isnan(cv))
+			continue;
+
+		pts[n] = (struct point) {.a = a[i], .b = b[i], .c = cv, .idx = i};
+		by_b[n] = &pts[n];
+		n++;
+	}
+
+	/* Ranks of the second objective, equal values share a rank */
+	qsort(by_b, n, sizeof(*by_b), cmp_b);
+
+	for (i = 0; i < n; i++) {
+		if (!i || by_b[i]->b != by_b[i - 1]->b)
+			ranks++;
+
+		by_b[i]->rank = ranks;
+	}
+
+	qsort(pts, n, sizeof(*pts), cmp_abc);
+
+	for (i = 0; i <= ranks; i++)
+		tree[i] = INFINITY;
+
+	/*
+	 * Any point that dominates p sorts before p, so p is dominated iff an
+	 * earlier point has b and c not worse. Identical points are processed
+	 * as a group so that they do not dominate each other.
+	 */
+	for (i = 0; i < n; i = j) {
+		int dominated = tree_min(tree, pts[i].rank) <= pts[i].c;
+
+		for (j = i; j < n && !cmp_abc(&pts[i], &pts[j]); j++) {
+			if (!dominated)
+				front[ret++] = pts[j].idx;
+		}
+
+		tree_set(tree, ranks, pts[i].rank, pts[i].c);
+	}
+
+	if (!ret)
+		errno = EINVAL;
+exit:
+	free(pts);
+	free(by_b);
+	free(tree);
+
+	return ret;
+}
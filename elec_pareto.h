@@ -0,0 +1,44 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Pareto front of three objectives that are minimized, e.g. resistance,
+ * mass and cost of a conductor.
+ *
+ * A point is in the front if there is no other point that is at least as
+ * good in all objectives and better in at least one. The front is computed
+ * in O(n log n) by a sweep over points sorted by the first objective, with
+ * a Fenwick tree of prefix minima of the third objective indexed by the rank
+ * of the second one.
+ */
+
+#ifndef ELEC_PARETO_H
+#define ELEC_PARETO_H
+
+#include <stddef.h>
+
+/**
+ * Computes the Pareto front.
+ *
+ * Points with NaN in any of the objectives are never in the front.
+ * Identical points are either all in the front or none of them.
+ *
+ * @a The first objective.
+ * @b The second objective.
+ * @c The third objective, may be NULL for two objectives.
+ * @cnt Number of points.
+ * @front An output array of at least cnt indexes, the front is sorted by
+ *        the first objective.
+ *
+ * @return Number of points in the front, or 0 with errno set on failure, if
+ *         there are no points or all points contain NaN.
+ */
+size_t elec_pareto_front(const double *a, const double *b, const double *c,
+                         size_t cnt, size_t *front);
+
+#endif /* ELEC_PARETO_H */
@@ -0,0 +1,150 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef __SSE2__
+# include <emmintrin.h>
+#endif
+#include "elec_parse.h"
+
+#define MANTISSA_DIGITS 19
+/* Exactly representable powers of ten */
+#define EXP_MAX 22
+
+static const double pow10_tbl[EXP_MAX + 1] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+static inline int is_digit(char c)
+{
+	return (unsigned char)(c - '0') < 10;
+}
+
+double elec_parse_double(const char *str, const char **end)
+{
+	const char *p = str;
+	uint64_t m = 0;
+	int neg = 0, digits = 0, any = 0, exp = 0, truncated = 0;
+	double ret;
+	char *e;
+
+	while (*p == ' ' || *p == '\t')
+		p++;
+
+	if (*p == '-' || *p == '+')
+		neg = *p++ == '-';
+
+	for (; is_digit(*p); p++) {
+		any = 1;
+
+		if (digits < MANTISSA_DIGITS) {
+			m = 10 * m + (*p - '0');
+			digits += m > 0;
+		} else {
+			truncated |= *p != '0';
+			exp++;
+		}
+	}
+
+	if (*p == '.') {
+		for (p++; is_digit(*p); p++) {
+			any = 1;
+
+			if (digits < MANTISSA_DIGITS) {
+				m = 10 * m + (*p - '0');
+				digits += m > 0;
+				exp--;
+			} else {
+				truncated |= *p != '0';
+			}
+		}
+	}
+
+	/* inf, nan, hex floats */
+	if (!any)
+		goto slow;
+
+	if ((*p == 'e' || *p == 'E') &&
+	    (is_digit(p[1]) || ((p[1] == '-' || p[1] == '+') && is_digit(p[2])))) {
+		int eneg = 0, eval = 0;
+
+		p++;
+
+		if (*p == '-' || *p == '+')
+			eneg = *p++ == '-';
+
+		for (; is_digit(*p); p++) {
+			if (eval < 100000)
+				eval = 10 * eval + (*p - '0');
+		}
+
+		exp += eneg ? -eval : eval;
+	}
+
+	if (truncated || m > (1ull << 53) || exp < -EXP_MAX || exp > EXP_MAX)
+		goto slow;
+
+	ret = m;
+
+	if (exp < 0)
+		ret /= pow10_tbl[-exp];
+	else
+		ret *= pow10_tbl[exp];
+
+	if (end)
+		*end = p;
+
+	return neg ? -ret : ret;
+slow:
+	p = str + strspn(str, " \t");
+
+	/* strtod() would skip newlines and parse the next line */
+	if (isspace((unsigned char)*p)) {
+		if (end)
+			*end = str;
+
+		return 0;
+	}
+
+	ret = strtod(p, &e);
+
+	if (end)
+		*end = e == p ? str : e;
+
+	return ret;
+}
+
+const char *elec_parse_scan(const char *str, const char *end, char delim)
+{
+#ifdef __SSE2__
+	__m128i d = _mm_set1_epi8(delim);
+	__m128i nl = _mm_set1_epi8('\n');
+
+	while (end - str >= 16) {
+		__m128i v = _mm_loadu_si128((const __m128i *)str);
+		int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, d),
+		                                          _mm_cmpeq_epi8(v, nl)));
+
+		if (mask)
+			return str + __builtin_ctz(mask);
+
+		str += 16;
+	}
+#endif
+
+	for (; str < end; str++) {
+		if (*str == delim || *str == '\n')
+			return str;
+	}
+
+	return end;
+}
@@ -0,0 +1,51 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Fast parsing of numbers and delimited text in memory buffers.
+ *
+ * Numbers with up to 19 significant digits and decimal exponent within
+ * +-22, which covers practically all measured and tabulated values, are
+ * converted exactly with a single floating point multiplication or
+ * division. Everything else is passed to strtod().
+ */
+
+#ifndef ELEC_PARSE_H
+#define ELEC_PARSE_H
+
+#include <stddef.h>
+
+/**
+ * Parses a decimal number, leading spaces and tabs are skipped.
+ *
+ * The buffer has to be terminated by a character that is not part of a
+ * number, e.g. newline or null byte.
+ *
+ * @str A string.
+ * @end Set to the first character after the number, or str if there is no
+ *      number. Number is never looked for past a newline, an empty field
+ *      is not a number.
+ *
+ * @return The parsed value.
+ */
+double elec_parse_double(const char *str, const char **end);
+
+/**
+ * Finds the first delimiter or a newline.
+ *
+ * The buffer is scanned 16 bytes at a time with SSE2 when available.
+ *
+ * @str Start of the scan.
+ * @end End of the buffer.
+ * @delim A delimiter, e.g. ','.
+ *
+ * @return Pointer to the delimiter or newline, or end if there is none.
+ */
+const char *elec_parse_scan(const char *str, const char *end, char delim);
+
+#endif /* ELEC_PARSE_H */
@@ -0,0 +1,84 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#include <math.h>
+#include "elec_pcb.h"
+
+#define MIL 25.4e-6
+#define MIL2 (MIL * MIL)
+
+/* IPC-2221 coefficients */
+#define IPC2221_K_EXT 0.048
+#define IPC2221_K_INT 0.024
+#define IPC2221_DT_EXP 0.44
+#define IPC2221_A_EXP 0.725
+
+double elec_pcb_resistance(const struct elec_material *material,
+                           const struct elec_pcb_trace *trace, double temp)
+{
+	double r = material->ro * trace->length / (trace->width * trace->thickness);
+
+	return elec_resistance_temp(material, r, temp);
+}
+
+/* IPC-2152 chart fit, area in mil² = a * I^b */
+static void ipc2152_coefs(double temp_rise, double *a, double *b)
+{
+	*a = 117.555 * pow(temp_rise, -0.913) + 1.15;
+	*b = 0.84 * pow(temp_rise, -0.018) + 1.159;
+}
+
+static double ipc2221_k(const struct elec_pcb_trace *trace)
+{
+	return trace->internal ? IPC2221_K_INT : IPC2221_K_EXT;
+}
+
+double elec_pcb_current(enum elec_pcb_std std, const struct elec_pcb_trace *trace,
+                        double temp_rise)
+{
+	double area = trace->width * trace->thickness / MIL2;
+	double a, b;
+
+	if (!(area > 0) || !(temp_rise > 0))
+		return NAN;
+
+	switch (std) {
+	case ELEC_PCB_IPC2221:
+		return ipc2221_k(trace) * pow(temp_rise, IPC2221_DT_EXP) *
+		       pow(area, IPC2221_A_EXP);
+	case ELEC_PCB_IPC2152:
+		ipc2152_coefs(temp_rise, &a, &b);
+		return pow(area / a, 1 / b);
+	}
+
+	return NAN;
+}
+
+double elec_pcb_width(enum elec_pcb_std std, const struct elec_pcb_trace *trace,
+                      double current, double temp_rise)
+{
+	double area, a, b;
+
+	if (!(current >= 0) || !(temp_rise > 0) || !(trace->thickness > 0))
+		return NAN;
+
+	switch (std) {
+	case ELEC_PCB_IPC2221:
+		area = pow(current / (ipc2221_k(trace) * pow(temp_rise, IPC2221_DT_EXP)),
+		           1 / IPC2221_A_EXP);
+	break;
+	case ELEC_PCB_IPC2152:
+		ipc2152_coefs(temp_rise, &a, &b);
+		area = a * pow(current, b);
+	break;
+	default:
+		return NAN;
+	}
+
+	return area * MIL2 / trace->thickness;
+}
@@ -0,0 +1,89 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * PCB trace resistance and current capacity.
+ *
+ * The current capacity is computed either from IPC-2221:
+ *
+ * I = k * dT^0.44 * A^0.725
+ *
+ * with A in mil² and k = 0.048 for external and 0.024 for internal layers,
+ * or from a curve fit of the IPC-2152 universal chart:
+ *
+ * A = (117.555 * dT^-0.913 + 1.15) * I^(0.84 * dT^-0.018 + 1.159)
+ *
+ * The chart is for a trace on a 1.6 mm FR-4 board without copper planes,
+ * which is conservative for both internal and external layers, hence the
+ * layer is ignored.
+ *
+ * Both are solved for the current or for the area in closed form.
+ */
+
+#ifndef ELEC_PCB_H
+#define ELEC_PCB_H
+
+#include "libelec.h"
+
+/* Copper thickness per oz/ft² of copper weight in m (1.37 mil) */
+#define ELEC_PCB_OZ 34.798e-6
+
+enum elec_pcb_std {
+	ELEC_PCB_IPC2221,
+	ELEC_PCB_IPC2152,
+};
+
+/**
+ * A trace, all dimensions are in meters.
+ */
+struct elec_pcb_trace {
+	double width;
+	double thickness;
+	double length;
+	/* set for traces on internal layers */
+	int internal;
+};
+
+/**
+ * Computes trace resistance at a temperature.
+ *
+ * @material A trace material, usually copper.
+ * @trace A trace.
+ * @temp A trace temperature in °C.
+ *
+ * @return Resistance in Ohms.
+ */
+double elec_pcb_resistance(const struct elec_material *material,
+                           const struct elec_pcb_trace *trace, double temp);
+
+/**
+ * Computes the current that heats a trace by temp_rise.
+ *
+ * @std A standard to compute the current from.
+ * @trace A trace, the length is not used.
+ * @temp_rise A temperature rise in °C.
+ *
+ * @return A current in A or NaN for invalid input.
+ */
+double elec_pcb_current(enum elec_pcb_std std, const struct elec_pcb_trace *trace,
+                        double temp_rise);
+
+/**
+ * Computes the minimal trace width for a current.
+ *
+ * @std A standard to compute the width from.
+ * @trace A trace with the thickness and internal set.
+ * @current A current in A.
+ * @temp_rise A temperature rise in °C.
+ *
+ * @return A width in m or NaN for invalid input.
+ */
+double elec_pcb_width(enum elec_pcb_std std, const struct elec_pcb_trace *trace,
+                      double current, double temp_rise);
+
+#endif /* ELEC_PCB_H */
@@ -0,0 +1,434 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "elec_batch.h"
+#include "elec_parse.h"
+#include "elec_project.h"
+
+static int totals_alloc(struct elec_project_totals *t)
+{
+	t->mat_length = calloc(2 * elec_material_cnt, sizeof(double));
+	if (!t->mat_length)
+		return 1;
+
+	t->mat_mass = t->mat_length + elec_material_cnt;
+
+	return 0;
+}
+
+static void totals_reset(struct elec_project_totals *t)
+{
+	double *mat_length = t->mat_length;
+	double *mat_mass = t->mat_mass;
+
+	memset(mat_length, 0, 2 * elec_material_cnt * sizeof(double));
+
+	*t = (struct elec_project_totals) {
+		.mat_length = mat_length,
+		.mat_mass = mat_mass,
+	};
+}
+
+int elec_project_init(struct elec_project *prj)
+{
+	memset(prj, 0, sizeof(*prj));
+
+	return totals_alloc(&prj->totals);
+}
+
+void elec_project_exit(struct elec_project *prj)
+{
+	size_t i;
+
+	for (i = 0; i < prj->blocks_size; i++)
+		free(prj->blocks[i].mat_length);
+
+	free(prj->blocks);
+	free(prj->totals.mat_length);
+	free(prj->lines);
+	free(prj->text);
+}
+
+static const char *skip_space(const char *p)
+{
+	while (*p == ' ' || *p == '\t' || *p == '\r')
+		p++;
+
+	return p;
+}
+
+/*
+ * Parses a possibly quoted text field and the comma after it, returns
+ * pointer after the comma or NULL.
+ */
+static const char *parse_field(const char *p, const char *end,
+                               const char **field, size_t *field_len)
+{
+	const char *q;
+
+	p = skip_space(p);
+
+	if (*p == '"') {
+		*field = ++p;
+		q = memchr(p, '"', end - p);
+		if (!q)
+			return NULL;
+
+		*field_len = q - p;
+		p = skip_space(q + 1);
+	} else {
+		*field = p;
+		p = elec_parse_scan(p, end, ',');
+		*field_len = p - *field;
+	}
+
+	if (p >= end || *p != ',')
+		return NULL;
+
+	return p + 1;
+}
+
+static int material_lookup(const char *name, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < elec_material_cnt; i++) {
+		if (!strncmp(elec_material[i].name, name, len) && !elec_material[i].name[len])
+			return i;
+	}
+
+	return -1;
+}
+
+static enum elec_project_state parse_line(struct elec_project_line *l,
+                                          const char *line, const char *end)
+{
+	const char *p = skip_space(line), *name, *mat_name, *num;
+	size_t name_len, mat_len;
+	int mat;
+
+	if (p >= end || *p == '#' || *p == '\n')
+		return ELEC_PROJECT_SKIP;
+
+	p = parse_field(p, end, &name, &name_len);
+	if (!p)
+		return ELEC_PROJECT_INVALID;
+
+	p = parse_field(p, end, &mat_name, &mat_len);
+	if (!p)
+		return ELEC_PROJECT_INVALID;
+
+	mat = material_lookup(mat_name, mat_len);
+	if (mat < 0)
+		return ELEC_PROJECT_INVALID;
+
+	num = p;
+	l->length = elec_parse_double(num, &p);
+	p = skip_space(p);
+	if (p == num || *p++ != ',')
+		return ELEC_PROJECT_INVALID;
+
+	num = p;
+	l->area = elec_parse_double(num, &p) * 1e-6;
+	p = skip_space(p);
+	if (p == num || *p++ != ',')
+		return ELEC_PROJECT_INVALID;
+
+	num = p;
+	l->current = elec_parse_double(num, &p);
+	if (p == num)
+		return ELEC_PROJECT_INVALID;
+
+	p = skip_space(p);
+	if (p < end && *p != '\n')
+		return ELEC_PROJECT_INVALID;
+
+	if (!(l->length >= 0) || !(l->area > 0) || !(l->current >= 0) ||
+	    isinf(l->length) || isinf(l->area) || isinf(l->current))
+		return ELEC_PROJECT_INVALID;
+
+	if (name_len >= ELEC_PROJECT_NAME_MAX)
+		name_len = ELEC_PROJECT_NAME_MAX - 1;
+
+	memcpy(l->name, name, name_len);
+	l->name[name_len] = 0;
+	l->material = mat;
+
+	return ELEC_PROJECT_RUN;
+}
+
+static void compute_line(struct elec_project_line *l)
+{
+	struct elec_material *mat = &elec_material[l->material];
+
+	elec_resistance_batch(mat, &l->length, &l->area, &l->resistance, 1);
+	elec_mass_batch(mat, &l->length, &l->area, &l->mass, 1);
+
+	l->drop = l->current * l->resistance;
+	l->loss = l->current * l->current * l->resistance;
+}
+
+static void block_sum(struct elec_project *prj, size_t b)
+{
+	struct elec_project_totals *t = &prj->blocks[b];
+	size_t i, from = b * ELEC_PROJECT_BLOCK;
+	size_t to = from + ELEC_PROJECT_BLOCK;
+
+	if (to > prj->lines_cnt)
+		to = prj->lines_cnt;
+
+	totals_reset(t);
+
+	for (i = from; i < to; i++) {
+		const struct elec_project_line *l = &prj->lines[i];
+
+		switch (l->state) {
+		case ELEC_PROJECT_SKIP:
+		break;
+		case ELEC_PROJECT_INVALID:
+			/* Header line */
+			if (i)
+				t->invalid++;
+		break;
+		case ELEC_PROJECT_RUN:
+			if (!t->runs || l->drop > t->drop_max) {
+				t->drop_max = l->drop;
+				t->drop_max_line = i;
+			}
+
+			t->runs++;
+			t->length += l->length;
+			t->mass += l->mass;
+			t->loss += l->loss;
+			t->mat_length[l->material] += l->length;
+			t->mat_mass[l->material] += l->mass;
+		break;
+		}
+	}
+}
+
+static void totals_sum(struct elec_project *prj, size_t blocks_cnt)
+{
+	struct elec_project_totals *t = &prj->totals;
+	size_t b, m;
+
+	totals_reset(t);
+
+	for (b = 0; b < blocks_cnt; b++) {
+		const struct elec_project_totals *bt = &prj->blocks[b];
+
+		if (!bt->runs && !bt->invalid)
+			continue;
+
+		if (bt->runs && (!t->runs || bt->drop_max > t->drop_max)) {
+			t->drop_max = bt->drop_max;
+			t->drop_max_line = bt->drop_max_line;
+		}
+
+		t->runs += bt->runs;
+		t->invalid += bt->invalid;
+		t->length += bt->length;
+		t->mass += bt->mass;
+		t->loss += bt->loss;
+
+		for (m = 0; m < elec_material_cnt; m++) {
+			t->mat_length[m] += bt->mat_length[m];
+			t->mat_mass[m] += bt->mat_mass[m];
+		}
+	}
+}
+
+static int text_set(struct elec_project *prj, const char *text, size_t len)
+{
+	/* Null terminated so that the last line can be parsed in place */
+	if (prj->text_size < len + 1) {
+		size_t size = len + 1 + len / 4;
+		char *tmp = realloc(prj->text, size);
+
+		if (!tmp)
+			return 1;
+
+		prj->text = tmp;
+		prj->text_size = size;
+	}
+
+	memcpy(prj->text, text, len);
+	prj->text[len] = 0;
+	prj->text_len = len;
+
+	return 0;
+}
+
+static int lines_reserve(struct elec_project *prj, size_t cnt)
+{
+	size_t size = prj->lines_size ? prj->lines_size : 1024;
+	struct elec_project_line *tmp;
+
+	if (cnt <= prj->lines_size)
+		return 0;
+
+	while (size < cnt)
+		size *= 2;
+
+	tmp = realloc(prj->lines, size * sizeof(*tmp));
+	if (!tmp)
+		return 1;
+
+	prj->lines = tmp;
+	prj->lines_size = size;
+
+	return 0;
+}
+
+static int blocks_reserve(struct elec_project *prj, size_t cnt)
+{
+	struct elec_project_totals *tmp;
+
+	if (cnt <= prj->blocks_size)
+		return 0;
+
+	tmp = realloc(prj->blocks, cnt * sizeof(*tmp));
+	if (!tmp)
+		return 1;
+
+	prj->blocks = tmp;
+
+	for (; prj->blocks_size < cnt; prj->blocks_size++) {
+		if (totals_alloc(&prj->blocks[prj->blocks_size]))
+			return 1;
+	}
+
+	return 0;
+}
+
+static size_t count_lines(const char *text, size_t len)
+{
+	const char *p = text, *end = text + len;
+	size_t cnt = 0;
+
+	while ((p = memchr(p, '\n', end - p))) {
+		p++;
+		cnt++;
+	}
+
+	/* Last line without a newline */
+	if (len && text[len - 1] != '\n')
+		cnt++;
+
+	return cnt;
+}
+
+static void project_clear(struct elec_project *prj)
+{
+	prj->text_len = 0;
+	prj->lines_cnt = 0;
+	totals_reset(&prj->totals);
+}
+
+int elec_project_update(struct elec_project *prj, const char *text, size_t len,
+                        struct elec_project_change *change)
+{
+	size_t first = 0, suffix = 0, off = 0;
+	size_t old_end = prj->text_len, new_end = len;
+	size_t removed, added, i, pos, blocks_cnt, dirty_from, dirty_to;
+
+	/* Common leading lines, the text after them has the same offset */
+	while (first < prj->lines_cnt) {
+		size_t l = prj->lines[first].len;
+
+		if (off + l > len || prj->text[off + l - 1] != '\n' ||
+		    memcmp(prj->text + off, text + off, l))
+			break;
+
+		off += l;
+		first++;
+	}
+
+	/* Common trailing lines that start at a line boundary in the new text */
+	while (first + suffix < prj->lines_cnt) {
+		size_t l = prj->lines[prj->lines_cnt - 1 - suffix].len;
+
+		if (new_end < off + l)
+			break;
+
+		if (new_end - l > off && text[new_end - l - 1] != '\n')
+			break;
+
+		if (memcmp(prj->text + old_end - l, text + new_end - l, l))
+			break;
+
+		old_end -= l;
+		new_end -= l;
+		suffix++;
+	}
+
+	removed = prj->lines_cnt - first - suffix;
+	added = count_lines(text + off, new_end - off);
+
+	if (text_set(prj, text, len) ||
+	    lines_reserve(prj, prj->lines_cnt - removed + added)) {
+		project_clear(prj);
+		return 1;
+	}
+
+	if (added != removed) {
+		memmove(prj->lines + first + added, prj->lines + first + removed,
+		        suffix * sizeof(*prj->lines));
+	}
+
+	prj->lines_cnt = prj->lines_cnt - removed + added;
+
+	for (i = first, pos = off; i < first + added; i++) {
+		struct elec_project_line *l = &prj->lines[i];
+		const char *line = prj->text + pos;
+		const char *nl = memchr(line, '\n', new_end - pos);
+		const char *line_end = nl ? nl : prj->text + new_end;
+
+		l->state = parse_line(l, line, line_end);
+		l->len = line_end - line + !!nl;
+
+		if (l->state == ELEC_PROJECT_RUN)
+			compute_line(l);
+
+		pos += l->len;
+	}
+
+	blocks_cnt = (prj->lines_cnt + ELEC_PROJECT_BLOCK - 1) / ELEC_PROJECT_BLOCK;
+
+	if (blocks_reserve(prj, blocks_cnt)) {
+		project_clear(prj);
+		return 1;
+	}
+
+	/* Inserted or removed lines shift all blocks after them */
+	dirty_from = first / ELEC_PROJECT_BLOCK;
+
+	if (added != removed)
+		dirty_to = blocks_cnt;
+	else if (added)
+		dirty_to = (first + added - 1) / ELEC_PROJECT_BLOCK + 1;
+	else
+		dirty_to = dirty_from;
+
+	for (i = dirty_from; i < dirty_to; i++)
+		block_sum(prj, i);
+
+	totals_sum(prj, blocks_cnt);
+
+	if (change) {
+		change->first = first;
+		change->removed = removed;
+		change->added = added;
+		change->blocks = dirty_to > dirty_from ? dirty_to - dirty_from : 0;
+	}
+
+	return 0;
+}
@@ -0,0 +1,124 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Cable project, a text file with one named cable run per line:
+ *
+ * name,material,length_m,area_mm2,current_a
+ *
+ * Empty lines, lines starting with '#' and an invalid first line, i.e. a
+ * header, are skipped.
+ *
+ * The project keeps a copy of the text it was built from. When the file
+ * changes the common leading and trailing lines are kept and only the lines
+ * in between are parsed and computed again. Totals are summed in blocks of
+ * ELEC_PROJECT_BLOCK lines and only blocks with changed lines are summed
+ * again, hence the totals do not depend on the order of the edits and are
+ * exactly the same as for a project loaded from scratch.
+ */
+
+#ifndef ELEC_PROJECT_H
+#define ELEC_PROJECT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "libelec.h"
+
+#define ELEC_PROJECT_NAME_MAX 64
+#define ELEC_PROJECT_BLOCK 1024
+
+enum elec_project_state {
+	ELEC_PROJECT_SKIP,
+	ELEC_PROJECT_RUN,
+	ELEC_PROJECT_INVALID,
+};
+
+struct elec_project_line {
+	/* line length including the newline */
+	size_t len;
+	enum elec_project_state state;
+
+	char name[ELEC_PROJECT_NAME_MAX];
+	uint16_t material;
+	/* in m, m² and A */
+	double length;
+	double area;
+	double current;
+
+	/* in Ω, V, W and kg */
+	double resistance;
+	double drop;
+	double loss;
+	double mass;
+};
+
+struct elec_project_totals {
+	size_t runs;
+	size_t invalid;
+	double length;
+	double mass;
+	double loss;
+	double drop_max;
+	/* line with the largest voltage drop */
+	size_t drop_max_line;
+	/* length and mass per material indexed by elec_material */
+	double *mat_length;
+	double *mat_mass;
+};
+
+struct elec_project {
+	char *text;
+	size_t text_len;
+	size_t text_size;
+
+	struct elec_project_line *lines;
+	size_t lines_cnt;
+	size_t lines_size;
+
+	struct elec_project_totals *blocks;
+	size_t blocks_size;
+
+	struct elec_project_totals totals;
+};
+
+/**
+ * Lines changed by the last update, the lines [first, first + added) replaced
+ * removed lines at the same position.
+ */
+struct elec_project_change {
+	size_t first;
+	size_t removed;
+	size_t added;
+	/* number of blocks summed again */
+	size_t blocks;
+};
+
+/**
+ * Initializes an empty project.
+ *
+ * @return Zero on success, non-zero on allocation failure.
+ */
+int elec_project_init(struct elec_project *prj);
+
+void elec_project_exit(struct elec_project *prj);
+
+/**
+ * Updates a project to a new text and recomputes changed lines and totals.
+ *
+ * @prj A project.
+ * @text The whole project text.
+ * @len The text length.
+ * @change Set to the changed lines, may be NULL.
+ *
+ * @return Zero on success, non-zero on allocation failure in which case the
+ *         project is empty.
+ */
+int elec_project_update(struct elec_project *prj, const char *text, size_t len,
+                        struct elec_project_change *change);
+
+#endif /* ELEC_PROJECT_H */
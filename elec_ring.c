@@ -0,0 +1,95 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "elec_ring.h"
+
+int elec_ring_init(struct elec_ring *ring, size_t size)
+{
+	size_t cap = 1;
+
+	while (cap < size)
+		cap <<= 1;
+
+	ring->buf = malloc(cap * sizeof(*ring->buf));
+	if (!ring->buf)
+		return 1;
+
+	ring->mask = cap - 1;
+	atomic_init(&ring->head, 0);
+	atomic_init(&ring->tail, 0);
+
+	return 0;
+}
+
+void elec_ring_exit(struct elec_ring *ring)
+{
+	free(ring->buf);
+	ring->buf = NULL;
+}
+
+/*
+ * Copies cnt samples between the ring at position pos and a linear buffer,
+ * wrapping around the end of the ring.
+ */
+static void ring_copy(struct elec_ring *ring, size_t pos, struct elec_sample *samples,
+                      size_t cnt, int to_ring)
+{
+	size_t off = pos & ring->mask;
+	size_t first = ring->mask + 1 - off;
+
+	if (first > cnt)
+		first = cnt;
+
+	if (to_ring) {
+		memcpy(ring->buf + off, samples, first * sizeof(*samples));
+		memcpy(ring->buf, samples + first, (cnt - first) * sizeof(*samples));
+	} else {
+		memcpy(samples, ring->buf + off, first * sizeof(*samples));
+		memcpy(samples + first, ring->buf, (cnt - first) * sizeof(*samples));
+	}
+}
+
+size_t elec_ring_push(struct elec_ring *ring, const struct elec_sample *samples, size_t cnt)
+{
+	size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+	size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+	size_t space = ring->mask + 1 - (head - tail);
+
+	if (cnt > space)
+		cnt = space;
+
+	if (!cnt)
+		return 0;
+
+	ring_copy(ring, head, (struct elec_sample *)samples, cnt, 1);
+
+	atomic_store_explicit(&ring->head, head + cnt, memory_order_release);
+
+	return cnt;
+}
+
+size_t elec_ring_pop(struct elec_ring *ring, struct elec_sample *samples, size_t cnt)
+{
+	size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+	size_t avail = head - tail;
+
+	if (cnt > avail)
+		cnt = avail;
+
+	if (!cnt)
+		return 0;
+
+	ring_copy(ring, tail, samples, cnt, 0);
+
+	atomic_store_explicit(&ring->tail, tail + cnt, memory_order_release);
+
+	return cnt;
+}
@@ -0,0 +1,63 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Lock-free single producer single consumer ring buffer of U/I samples.
+ *
+ * Exactly one thread may push and exactly one thread may pop. The head is
+ * written only by the producer and the tail only by the consumer, they are
+ * kept on separate cache lines so that the threads do not fight over them.
+ */
+
+#ifndef ELEC_RING_H
+#define ELEC_RING_H
+
+#include <stddef.h>
+#include <stdatomic.h>
+
+struct elec_sample {
+	/* voltage in V */
+	double u;
+	/* current in A */
+	double i;
+};
+
+struct elec_ring {
+	_Alignas(64) atomic_size_t head;
+	_Alignas(64) atomic_size_t tail;
+	_Alignas(64) size_t mask;
+	struct elec_sample *buf;
+};
+
+/**
+ * Allocates the ring buffer.
+ *
+ * @ring A ring buffer.
+ * @size A minimal number of samples, rounded up to a power of two.
+ *
+ * @return Zero on success, non-zero on allocation failure.
+ */
+int elec_ring_init(struct elec_ring *ring, size_t size);
+
+void elec_ring_exit(struct elec_ring *ring);
+
+/**
+ * Pushes up to cnt samples, called only from the producer thread.
+ *
+ * @return Number of samples pushed, less than cnt if the ring is full.
+ */
+size_t elec_ring_push(struct elec_ring *ring, const struct elec_sample *samples, size_t cnt);
+
+/**
+ * Pops up to cnt samples, called only from the consumer thread.
+ *
+ * @return Number of samples popped, zero if the ring is empty.
+ */
+size_t elec_ring_pop(struct elec_ring *ring, struct elec_sample *samples, size_t cnt);
+
+#endif /* ELEC_RING_H */
@@ -0,0 +1,332 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#include <math.h>
+#include <string.h>
+#include "elec_stats.h"
+
+#define GAMMA ((1 + ELEC_SKETCH_ACCURACY) / (1 - ELEC_SKETCH_ACCURACY))
+
+/* Block size for elec_stats_add_batch() */
+#define BLOCK 256
+
+#define INV_LOG_GAMMA (1 / log(GAMMA))
+
+static void store_init(struct elec_sketch_store *s)
+{
+	s->offset = INT32_MIN;
+	s->cnt = 0;
+	memset(s->bins, 0, sizeof(s->bins));
+}
+
+void elec_stats_init(struct elec_stats *stats)
+{
+	stats->n = 0;
+	stats->mean = 0;
+	stats->m2 = 0;
+	stats->min = INFINITY;
+	stats->max = -INFINITY;
+	stats->invalid = 0;
+	stats->zeros = 0;
+
+	store_init(&stats->pos);
+	store_init(&stats->neg);
+}
+
+static inline int32_t bucket_idx(double absval)
+{
+	return ceil(log(absval) * INV_LOG_GAMMA);
+}
+
+static inline double bucket_val(int32_t idx)
+{
+	return 2 * pow(GAMMA, idx) / (GAMMA + 1);
+}
+
+/*
+ * Moves the window to start at offset, the bins that fall out at the bottom
+ * are collapsed into the lowest bin. The bins that would fall out at the top
+ * must be empty.
+ */
+static void store_move(struct elec_sketch_store *s, int32_t offset)
+{
+	int32_t shift = offset - s->offset;
+	uint64_t collapsed = 0;
+	int32_t i;
+
+	if (shift < 0) {
+		memmove(s->bins - shift, s->bins, (ELEC_SKETCH_BINS + shift) * sizeof(s->bins[0]));
+		memset(s->bins, 0, -shift * sizeof(s->bins[0]));
+		s->offset = offset;
+		return;
+	}
+
+	if (shift >= ELEC_SKETCH_BINS) {
+		s->bins[0] = s->cnt;
+		memset(s->bins + 1, 0, (ELEC_SKETCH_BINS - 1) * sizeof(s->bins[0]));
+		s->offset = offset;
+		return;
+	}
+
+	for (i = 0; i <= shift; i++)
+		collapsed += s->bins[i];
+
+	memmove(s->bins, s->bins + shift, (ELEC_SKETCH_BINS - shift) * sizeof(s->bins[0]));
+	memset(s->bins + ELEC_SKETCH_BINS - shift, 0, shift * sizeof(s->bins[0]));
+
+	s->bins[0] = collapsed;
+	s->offset = offset;
+}
+
+/*
+ * Moves the window up so that idx fits.
+ */
+static void store_shift(struct elec_sketch_store *s, int32_t idx)
+{
+	store_move(s, idx - ELEC_SKETCH_BINS + 1);
+}
+
+static inline void store_add(struct elec_sketch_store *s, int32_t idx, uint64_t cnt)
+{
+	/* First value, place it in the upper quarter of the window */
+	if (s->offset == INT32_MIN)
+		s->offset = idx - 3 * ELEC_SKETCH_BINS / 4;
+
+	if (idx >= s->offset + ELEC_SKETCH_BINS)
+		store_shift(s, idx);
+
+	if (idx < s->offset)
+		idx = s->offset;
+
+	s->bins[idx - s->offset] += cnt;
+	s->cnt += cnt;
+}
+
+static inline void sketch_add(struct elec_stats *stats, double val)
+{
+	if (val > 0)
+		store_add(&stats->pos, bucket_idx(val), 1);
+	else if (val < 0)
+		store_add(&stats->neg, bucket_idx(-val), 1);
+	else
+		stats->zeros++;
+}
+
+void elec_stats_add(struct elec_stats *stats, double val)
+{
+	double delta;
+
+	if (!isfinite(val)) {
+		stats->invalid++;
+		return;
+	}
+
+	stats->n++;
+	delta = val - stats->mean;
+	stats->mean += delta / stats->n;
+	stats->m2 += delta * (val - stats->mean);
+
+	if (val < stats->min)
+		stats->min = val;
+
+	if (val > stats->max)
+		stats->max = val;
+
+	sketch_add(stats, val);
+}
+
+/*
+ * Chan et al. pairwise update of the moments.
+ */
+static void moments_merge(struct elec_stats *dst, uint64_t n, double mean, double m2,
+                          double min, double max)
+{
+	uint64_t total = dst->n + n;
+	double delta = mean - dst->mean;
+
+	dst->m2 += m2 + delta * delta * ((double)dst->n * n / total);
+	dst->mean += delta * n / total;
+	dst->n = total;
+
+	if (min < dst->min)
+		dst->min = min;
+
+	if (max > dst->max)
+		dst->max = max;
+}
+
+/*
+ * Moments of a block are computed in two passes over the block and merged
+ * in, which avoids a division per value and is more accurate than Welford
+ * for the long running sum.
+ */
+void elec_stats_add_batch(struct elec_stats *stats, const double *vals, size_t cnt)
+{
+	size_t i, j, n;
+
+	for (i = 0; i < cnt; i += n) {
+		double sum = 0, mean, m2 = 0, min = INFINITY, max = -INFINITY;
+		size_t valid = 0;
+
+		n = cnt - i < BLOCK ? cnt - i : BLOCK;
+
+		for (j = 0; j < n; j++) {
+			double v = vals[i + j];
+
+			if (!isfinite(v))
+				continue;
+
+			sum += v;
+			valid++;
+			min = v < min ? v : min;
+			max = v > max ? v : max;
+			sketch_add(stats, v);
+		}
+
+		stats->invalid += n - valid;
+
+		if (!valid)
+			continue;
+
+		mean = sum / valid;
+
+		for (j = 0; j < n; j++) {
+			double d = vals[i + j] - mean;
+
+			if (isfinite(vals[i + j]))
+				m2 += d * d;
+		}
+
+		moments_merge(stats, valid, mean, m2, min, max);
+	}
+}
+
+/*
+ * Bucket indexes of the lowest and highest non-empty bins.
+ */
+static void store_range(const struct elec_sketch_store *s, int32_t *lo, int32_t *hi)
+{
+	int32_t i = 0, j = ELEC_SKETCH_BINS - 1;
+
+	while (!s->bins[i])
+		i++;
+
+	while (!s->bins[j])
+		j--;
+
+	*lo = s->offset + i;
+	*hi = s->offset + j;
+}
+
+static void store_merge(struct elec_sketch_store *dst, const struct elec_sketch_store *src)
+{
+	int32_t i, lo, hi, src_lo, src_hi, offset;
+
+	if (!src->cnt)
+		return;
+
+	if (!dst->cnt) {
+		*dst = *src;
+		return;
+	}
+
+	store_range(dst, &lo, &hi);
+	store_range(src, &src_lo, &src_hi);
+
+	if (src_lo < lo)
+		lo = src_lo;
+
+	if (src_hi > hi)
+		hi = src_hi;
+
+	/*
+	 * Cover both ranges keeping the current offset if possible, if they do
+	 * not fit the window the lowest bins are collapsed.
+	 */
+	offset = dst->offset < lo ? dst->offset : lo;
+	if (offset < hi - ELEC_SKETCH_BINS + 1)
+		offset = hi - ELEC_SKETCH_BINS + 1;
+
+	store_move(dst, offset);
+
+	for (i = 0; i < ELEC_SKETCH_BINS; i++) {
+		if (src->bins[i])
+			store_add(dst, src->offset + i, src->bins[i]);
+	}
+}
+
+void elec_stats_merge(struct elec_stats *dst, const struct elec_stats *src)
+{
+	dst->invalid += src->invalid;
+
+	if (!src->n)
+		return;
+
+	moments_merge(dst, src->n, src->mean, src->m2, src->min, src->max);
+
+	dst->zeros += src->zeros;
+	store_merge(&dst->pos, &src->pos);
+	store_merge(&dst->neg, &src->neg);
+}
+
+double elec_stats_variance(const struct elec_stats *stats)
+{
+	if (stats->n < 2)
+		return NAN;
+
+	return stats->m2 / (stats->n - 1);
+}
+
+double elec_stats_quantile(const struct elec_stats *stats, double q)
+{
+	uint64_t rank, seen = 0;
+	int32_t i;
+	double val;
+
+	if (!stats->n)
+		return NAN;
+
+	if (q <= 0)
+		return stats->min;
+
+	if (q >= 1)
+		return stats->max;
+
+	rank = q * (stats->n - 1);
+
+	/* Negative values from the most negative, i.e. largest bucket */
+	for (i = ELEC_SKETCH_BINS - 1; stats->neg.cnt && i >= 0; i--) {
+		seen += stats->neg.bins[i];
+		if (seen > rank) {
+			val = -bucket_val(stats->neg.offset + i);
+			goto clamp;
+		}
+	}
+
+	seen += stats->zeros;
+	if (seen > rank)
+		return 0;
+
+	for (i = 0; i < ELEC_SKETCH_BINS; i++) {
+		seen += stats->pos.bins[i];
+		if (seen > rank) {
+			val = bucket_val(stats->pos.offset + i);
+			goto clamp;
+		}
+	}
+
+	return stats->max;
+clamp:
+	if (val < stats->min)
+		return stats->min;
+
+	if (val > stats->max)
+		return stats->max;
+
+	return val;
+}
@@ -0,0 +1,82 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Streaming statistics with fixed memory per stream.
+ *
+ * Mean and variance are computed with the Welford algorithm, quantiles are
+ * estimated with a logarithmic bucket sketch (DDSketch). A value is counted
+ * in bucket ceil(log_gamma(|x|)) so that any quantile estimate is within
+ * ELEC_SKETCH_ACCURACY relative error of a value from the input. The bucket
+ * window covers about 17 decades, values further below the largest ones
+ * are collapsed into the lowest bucket.
+ *
+ * Both the moments and the sketch can be merged, so that each thread can
+ * process part of the input and the results are combined at the end.
+ */
+
+#ifndef ELEC_STATS_H
+#define ELEC_STATS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define ELEC_SKETCH_ACCURACY 0.01
+#define ELEC_SKETCH_BINS 2048
+
+struct elec_sketch_store {
+	/* bucket index of bins[0] */
+	int32_t offset;
+	uint64_t cnt;
+	uint64_t bins[ELEC_SKETCH_BINS];
+};
+
+struct elec_stats {
+	uint64_t n;
+	double mean;
+	/* sum of squared differences from the mean */
+	double m2;
+	double min;
+	double max;
+	/* NaN and infinite values, not included in the statistics */
+	uint64_t invalid;
+
+	uint64_t zeros;
+	struct elec_sketch_store pos;
+	struct elec_sketch_store neg;
+};
+
+void elec_stats_init(struct elec_stats *stats);
+
+/**
+ * Adds a value to the statistics.
+ */
+void elec_stats_add(struct elec_stats *stats, double val);
+
+/**
+ * Adds an array of values, faster than calling elec_stats_add() in a loop.
+ */
+void elec_stats_add_batch(struct elec_stats *stats, const double *vals, size_t cnt);
+
+/**
+ * Merges src into dst, the result is the same as if all values were added
+ * to dst, up to rounding errors.
+ */
+void elec_stats_merge(struct elec_stats *dst, const struct elec_stats *src);
+
+/**
+ * Returns sample variance, NAN for less than two values.
+ */
+double elec_stats_variance(const struct elec_stats *stats);
+
+/**
+ * Returns estimate of a quantile q from [0, 1], NAN if there are no values.
+ */
+double elec_stats_quantile(const struct elec_stats *stats, double q);
+
+#endif /* ELEC_STATS_H */
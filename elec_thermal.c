@@ -0,0 +1,136 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#include <math.h>
+#include <string.h>
+#include "elec_thermal.h"
+#include "elec_par.h"
+
+#define BLOCK 256
+
+/* Way above melting point of any conductor, iteration diverged */
+#define TEMP_LIMIT 10000
+
+int elec_self_heating(const struct elec_material *material, double r_ref,
+                      double current, double rth, double t_ambient,
+                      struct elec_self_heating *res)
+{
+	double k = rth * current * current;
+	double temp = t_ambient, prev;
+	unsigned int i;
+
+	res->converged = 0;
+
+	for (i = 1; i <= ELEC_THERMAL_MAX_ITERS; i++) {
+		prev = temp;
+		temp = t_ambient + k * elec_resistance_temp(material, r_ref, temp);
+
+		if (fabs(temp - prev) <= ELEC_THERMAL_TOL) {
+			res->converged = 1;
+			break;
+		}
+
+		if (!(temp < TEMP_LIMIT))
+			break;
+	}
+
+	res->iters = i > ELEC_THERMAL_MAX_ITERS ? ELEC_THERMAL_MAX_ITERS : i;
+	res->temp = temp;
+	res->resistance = elec_resistance_temp(material, r_ref, temp);
+	res->power = current * current * res->resistance;
+
+	return !res->converged;
+}
+
+struct heating_batch {
+	const struct elec_self_heating_arr *in;
+	double *temp;
+	unsigned int *iters;
+	unsigned char *converged;
+	size_t failed;
+};
+
+static size_t solve_block(const struct elec_self_heating_arr *in, size_t off, size_t cnt,
+                          double *restrict temp, unsigned int *restrict iters,
+                          unsigned char *restrict done)
+{
+	double k[BLOCK], a[BLOCK], b[BLOCK];
+	unsigned int it, i, active = cnt;
+	size_t failed = 0;
+
+	/* T = Ta + k * R20 * (1 + tc * (T - 20)) = a + b * T */
+	for (i = 0; i < cnt; i++) {
+		double tc = in->tc[off + i];
+
+		k[i] = in->rth[off + i] * in->current[off + i] * in->current[off + i] * in->r_ref[off + i];
+		a[i] = in->t_ambient[off + i] + k[i] * (1 - tc * ELEC_TEMP_REF);
+		b[i] = k[i] * tc;
+		temp[i] = in->t_ambient[off + i];
+		iters[i] = 0;
+		done[i] = 0;
+	}
+
+	for (it = 1; it <= ELEC_THERMAL_MAX_ITERS && active; it++) {
+		active = 0;
+
+		for (i = 0; i < cnt; i++) {
+			double t = a[i] + b[i] * temp[i];
+			unsigned char conv = fabs(t - temp[i]) <= ELEC_THERMAL_TOL;
+			unsigned char diverged = !(t < TEMP_LIMIT);
+
+			temp[i] = done[i] ? temp[i] : t;
+			iters[i] = done[i] ? iters[i] : it;
+			done[i] |= conv | (diverged << 1);
+			active += !done[i];
+		}
+	}
+
+	for (i = 0; i < cnt; i++) {
+		done[i] = done[i] == 1;
+		failed += !done[i];
+	}
+
+	return failed;
+}
+
+static void heating_range(void *priv, size_t from, size_t to)
+{
+	struct heating_batch *batch = priv;
+	unsigned int iters[BLOCK];
+	unsigned char done[BLOCK];
+	size_t i, failed = 0;
+
+	for (i = from * BLOCK; i < to * BLOCK && i < batch->in->cnt; i += BLOCK) {
+		size_t cnt = batch->in->cnt - i < BLOCK ? batch->in->cnt - i : BLOCK;
+
+		failed += solve_block(batch->in, i, cnt, batch->temp + i, iters, done);
+
+		if (batch->iters)
+			memcpy(batch->iters + i, iters, cnt * sizeof(*iters));
+
+		if (batch->converged)
+			memcpy(batch->converged + i, done, cnt);
+	}
+
+	__atomic_add_fetch(&batch->failed, failed, __ATOMIC_RELAXED);
+}
+
+size_t elec_self_heating_batch(const struct elec_self_heating_arr *in, double *temp,
+                               unsigned int *iters, unsigned char *converged)
+{
+	struct heating_batch batch = {
+		.in = in,
+		.temp = temp,
+		.iters = iters,
+		.converged = converged,
+	};
+
+	elec_par_for((in->cnt + BLOCK - 1) / BLOCK, 0, heating_range, &batch);
+
+	return batch.failed;
+}
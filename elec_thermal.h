@@ -0,0 +1,89 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Steady state temperature of a conductor heated by its own I²R losses.
+ *
+ * The conductor is modeled with a single thermal resistance to ambient, the
+ * resistance rises with temperature which rises losses which are iterated as
+ * a fixed point:
+ *
+ * T = Ta + Rth * I² * R(T)
+ *
+ * The iteration converges with rate Rth * I² * R20 * tc, once that reaches
+ * one there is no steady state and the conductor overheats.
+ */
+
+#ifndef ELEC_THERMAL_H
+#define ELEC_THERMAL_H
+
+#include <stddef.h>
+#include "libelec.h"
+
+#define ELEC_THERMAL_TOL 1e-6
+#define ELEC_THERMAL_MAX_ITERS 1000
+
+struct elec_self_heating {
+	/* steady state temperature in °C */
+	double temp;
+	/* resistance at temp in Ohms */
+	double resistance;
+	/* losses in W */
+	double power;
+	unsigned int iters;
+	/* zero if the iteration diverged */
+	int converged;
+};
+
+/**
+ * Solves conductor self heating.
+ *
+ * @material A material description.
+ * @r_ref A resistance at ELEC_TEMP_REF in Ohms.
+ * @current A current in A.
+ * @rth A thermal resistance to ambient in K/W.
+ * @t_ambient An ambient temperature in °C.
+ * @res A solution.
+ *
+ * @return Zero if converged, non-zero otherwise.
+ */
+int elec_self_heating(const struct elec_material *material, double r_ref,
+                      double current, double rth, double t_ambient,
+                      struct elec_self_heating *res);
+
+/**
+ * Inputs for elec_self_heating_batch(), structure of arrays each of cnt
+ * elements, tc is the material temperature coefficient.
+ */
+struct elec_self_heating_arr {
+	const double *r_ref;
+	const double *tc;
+	const double *current;
+	const double *rth;
+	const double *t_ambient;
+	size_t cnt;
+};
+
+/**
+ * Solves self heating for many conductors at once.
+ *
+ * The conductors are iterated in blocks with a per element convergence mask
+ * so that the inner loop is branch free, each block is iterated until all
+ * its elements converged. Blocks are distributed among threads.
+ *
+ * @in Input arrays.
+ * @temp Output temperatures in °C.
+ * @iters Output number of iterations, may be NULL.
+ * @converged Output convergence mask, may be NULL.
+ *
+ * @return Number of elements that did not converge.
+ */
+size_t elec_self_heating_batch(const struct elec_self_heating_arr *in, double *temp,
+                               unsigned int *iters, unsigned char *converged);
+
+#endif /* ELEC_THERMAL_H */
@@ -0,0 +1,106 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#include <limits.h>
+#include <math.h>
+#include "elec_winding.h"
+
+/* Tolerance for a build that fills the window exactly */
+#define BUILD_EPS 1e-9
+
+static int bobbin_valid(const struct elec_bobbin *bobbin)
+{
+	return bobbin->width > 0 && bobbin->height > 0 && bobbin->core_width > 0 &&
+	       bobbin->core_depth >= 0 && bobbin->layer_insulation >= 0;
+}
+
+static int wire_valid(const struct elec_winding *winding)
+{
+	return winding->diameter > 0 && winding->outer_diameter >= winding->diameter &&
+	       isfinite(winding->outer_diameter);
+}
+
+static unsigned int turns_per_layer(const struct elec_bobbin *bobbin,
+                                    const struct elec_winding *winding)
+{
+	double tpl = floor(bobbin->width / winding->outer_diameter * (1 + BUILD_EPS));
+
+	return tpl > UINT_MAX ? UINT_MAX : tpl;
+}
+
+static double core_perimeter(const struct elec_bobbin *bobbin)
+{
+	if (bobbin->core_depth > 0)
+		return 2 * (bobbin->core_width + bobbin->core_depth);
+
+	return M_PI * bobbin->core_width;
+}
+
+int elec_winding_calc(const struct elec_bobbin *bobbin, struct elec_material *material,
+                      struct elec_winding *winding)
+{
+	struct elec_winding *w = winding;
+	double od = w->outer_diameter, t = bobbin->layer_insulation;
+	double first_turn, pitch, full, rest;
+	struct elec_val length, area;
+
+	if (!bobbin_valid(bobbin) || !wire_valid(w) || !w->turns)
+		return 1;
+
+	w->turns_per_layer = turns_per_layer(bobbin, w);
+	if (!w->turns_per_layer)
+		return 1;
+
+	w->layers = (w->turns - 1) / w->turns_per_layer + 1;
+	w->build = w->layers * od + (w->layers - 1) * t;
+	w->fits = w->build <= bobbin->height * (1 + BUILD_EPS);
+
+	/* Turn length in the first layer and the increment per layer */
+	first_turn = core_perimeter(bobbin) + M_PI * od;
+	pitch = 2 * M_PI * (od + t);
+
+	full = w->turns / w->turns_per_layer;
+	rest = w->turns % w->turns_per_layer;
+
+	w->length = w->turns_per_layer * (full * first_turn + pitch * full * (full - 1) / 2) +
+	            rest * (first_turn + pitch * full);
+
+	area = (struct elec_val) {
+		.type = ELEC_UNIT_LENGTH,
+		.unit = ELEC_UNIT_M,
+		.val = w->diameter,
+	};
+	elec_circle_area(&area, ELEC_UNIT_M2);
+
+	length = (struct elec_val) {
+		.type = ELEC_UNIT_LENGTH,
+		.unit = ELEC_UNIT_M,
+		.val = w->length,
+	};
+
+	w->area = area.val;
+	w->fill = w->turns * w->area / (bobbin->width * bobbin->height);
+	w->resistance = elec_resistance_block(material, length, area).val;
+	w->mass = elec_mass_block(material, length, area).val;
+
+	return 0;
+}
+
+unsigned int elec_winding_turns_max(const struct elec_bobbin *bobbin,
+                                    const struct elec_winding *winding)
+{
+	double t = bobbin->layer_insulation, layers, turns;
+
+	if (!bobbin_valid(bobbin) || !wire_valid(winding))
+		return 0;
+
+	layers = floor((bobbin->height + t) / (winding->outer_diameter + t) * (1 + BUILD_EPS));
+	turns = layers * turns_per_layer(bobbin, winding);
+
+	return turns > UINT_MAX ? UINT_MAX : turns;
+}
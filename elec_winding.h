@@ -0,0 +1,95 @@
+//SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Layer wound coils on a bobbin.
+ *
+ * Turns are wound side by side in layers across the bobbin width, each layer
+ * adds the insulated wire diameter plus the interlayer insulation to the
+ * winding build. A turn in layer k encloses the core at distance
+ * r = k * (d + t) + d / 2 from its surface, where d is the diameter over the
+ * insulation and t the interlayer insulation, hence its length is the core
+ * perimeter plus 2 * pi * r, which is exact for a round core and assumes
+ * corners rounded with radius r for a rectangular one. The wire length is
+ * computed in closed form so that the calculation does not depend on the
+ * number of layers.
+ */
+
+#ifndef ELEC_WINDING_H
+#define ELEC_WINDING_H
+
+#include "libelec.h"
+
+/**
+ * Bobbin dimensions, all in meters.
+ */
+struct elec_bobbin {
+	/* winding window width along the bobbin axis */
+	double width;
+	/* winding window height, i.e. maximal build */
+	double height;
+	/* core size, core_depth is zero for a round core of core_width diameter */
+	double core_width;
+	double core_depth;
+	/* insulation between layers */
+	double layer_insulation;
+};
+
+struct elec_winding {
+	/* number of turns */
+	unsigned int turns;
+	/* bare wire diameter in m */
+	double diameter;
+	/* diameter over the insulation in m, at least the bare diameter */
+	double outer_diameter;
+
+	/* results */
+	unsigned int turns_per_layer;
+	unsigned int layers;
+	/* winding build in m */
+	double build;
+	/* wire length in m */
+	double length;
+	/* wire cross section in m² */
+	double area;
+	/* copper area to winding window area ratio */
+	double fill;
+	/* in Ohm */
+	double resistance;
+	/* in kg */
+	double mass;
+	/* set if the build fits into the window height */
+	int fits;
+};
+
+/**
+ * Computes the winding layout, wire length, resistance, mass and fill.
+ *
+ * @bobbin A bobbin.
+ * @material A wire material.
+ * @winding A winding with turns, diameter and outer_diameter set, the rest
+ *          is filled in.
+ *
+ * @return Zero on success, non-zero if the bobbin or wire dimensions are
+ *         invalid or if not even a single turn fits the bobbin width.
+ */
+int elec_winding_calc(const struct elec_bobbin *bobbin, struct elec_material *material,
+                      struct elec_winding *winding);
+
+/**
+ * Finds the largest number of turns that fits into the window.
+ *
+ * @bobbin A bobbin.
+ * @winding A winding with diameter and outer_diameter set.
+ *
+ * @return Number of turns, zero if none fits.
+ */
+unsigned int elec_winding_turns_max(const struct elec_bobbin *bobbin,
+                                    const struct elec_winding *winding);
+
+#endif /* ELEC_WINDING_H */
@@ -6,11 +6,18 @@
 
  */
 
+#include <math.h>
 #include <string.h>
 #include <widgets/gp_widgets.h>
 
 #include "libelec.h"
+#include "elec_fmt.h"
+#include "elec_geometry.h"
 #include "ohm_law.h"
+#include "divider.h"
+#include "fuse.h"
+#include "bode.h"
+#include "wire_plot.h"
 
 gp_app_info app_info = {
 	.name = "elecalc",
@@ -36,6 +43,14 @@ static struct resistance_ui {
 
 	gp_widget *material;
 
+	gp_widget *geometry;
+	gp_widget *geom_a;
+	gp_widget *geom_b;
+	gp_widget *geom_c;
+	gp_widget *geom_a_label;
+	gp_widget *geom_b_label;
+	gp_widget *geom_c_label;
+
 	gp_widget *resistance;
 
 	gp_widget *material_name;
@@ -97,6 +112,63 @@ static struct elec_val get_resistance_val(struct resistance_ui *ui)
 	};
 }
 
+static double get_geom_dim(struct resistance_ui *ui, gp_widget *tbox)
+{
+	struct elec_val dim = {
+		.val = atof(gp_widget_tbox_text(tbox)),
+		.unit = gp_widget_choice_sel_get(ui->unit_diameter),
+		.type = ELEC_UNIT_LENGTH,
+	};
+
+	elec_unit_convert(&dim, ELEC_UNIT_M);
+
+	return dim.val;
+}
+
+static void get_geometry(struct resistance_ui *ui, struct elec_geometry *g)
+{
+	g->type = gp_widget_choice_sel_get(ui->geometry);
+
+	switch (g->type) {
+	case ELEC_GEOMETRY_RECT:
+		g->rect.width = get_geom_dim(ui, ui->geom_a);
+		g->rect.height = get_geom_dim(ui, ui->geom_b);
+		g->rect.radius = get_geom_dim(ui, ui->geom_c);
+	break;
+	case ELEC_GEOMETRY_TUBE:
+		g->tube.diameter = get_geom_dim(ui, ui->geom_a);
+		g->tube.wall = get_geom_dim(ui, ui->geom_b);
+	break;
+	case ELEC_GEOMETRY_STRANDED:
+		g->stranded.strands = atoi(gp_widget_tbox_text(ui->geom_a));
+		g->stranded.diameter = get_geom_dim(ui, ui->geom_b);
+		g->stranded.lay_factor = 1;
+
+		if (!gp_widget_tbox_is_empty(ui->geom_c))
+			g->stranded.lay_factor = atof(gp_widget_tbox_text(ui->geom_c));
+	break;
+	default:
+		g->type = ELEC_GEOMETRY_ROUND;
+		g->round.diameter = get_diameter_val(ui).val;
+	break;
+	}
+}
+
+/*
+ * Sets a result label to a value rounded to six digits as %g would.
+ */
+static void label_val(gp_widget *label, double val, const char *unit)
+{
+	char buf[ELEC_FMT_MAX];
+
+	elec_fmt_digits(val, 6, buf);
+
+	if (unit)
+		gp_widget_label_printf(label, "%s %s", buf, unit);
+	else
+		gp_widget_label_set(label, buf);
+}
+
 static int recalc_resistance(gp_widget_event *ev)
 {
 	struct resistance_ui *ui = ev->self->priv;
@@ -104,47 +176,59 @@ static int recalc_resistance(gp_widget_event *ev)
 	if (ev->type != GP_WIDGET_EVENT_WIDGET)
 		return 0;
 
-	if (gp_widget_tbox_is_empty(ui->length))
-		return 0;
-
 	size_t material = gp_widget_choice_sel_get(ui->material);
 
 	struct elec_val area = get_area_val(ui);
+
+	fuse_update(&elec_material[material], area);
+
+	if (gp_widget_tbox_is_empty(ui->length))
+		return 0;
+
 	struct elec_val length = get_length_val(ui);
+	struct elec_val strands = length;
+	struct elec_geometry geometry;
 	struct elec_val res;
+	double lay_factor;
+	char buf[ELEC_FMT_MAX];
+
+	/* Strands are longer than the cable by the lay factor */
+	get_geometry(ui, &geometry);
+	lay_factor = elec_geometry_lay_factor(&geometry);
+	strands.val *= lay_factor;
 
-	res = elec_resistance_block(&elec_material[material], length, area);
+	res = elec_resistance_block(&elec_material[material], strands, area);
 
-	gp_widget_tbox_printf(ui->resistance, "%g", res.val);
+	elec_fmt_shortest(res.val, buf);
+	gp_widget_tbox_set(ui->resistance, buf);
+
+	wire_plot_update(&elec_material[material], length, area, lay_factor);
 
 	if (ui->res_resistance) {
 		elec_unit_autoscale(&res);
-		gp_widget_label_printf(ui->res_resistance, "%g %s",
-		                       res.val, elec_unit_name(&res));
+		label_val(ui->res_resistance, res.val, elec_unit_name(&res));
 	}
 
 	if (ui->res_mass) {
 		struct elec_val mass;
 
-		mass = elec_mass_block(&elec_material[material], length, area);
+		mass = elec_mass_block(&elec_material[material], strands, area);
 
 		elec_unit_autoscale(&mass);
 
-		gp_widget_label_printf(ui->res_mass, "%g %s", mass.val, elec_unit_name(&mass));
+		label_val(ui->res_mass, mass.val, elec_unit_name(&mass));
 	}
 
 	if (ui->res_area) {
 		elec_unit_autoscale(&area);
-		gp_widget_label_printf(ui->res_area, "%g %s",
-		                       area.val, elec_unit_name(&area));
+		label_val(ui->res_area, area.val, elec_unit_name(&area));
 	}
 
 	if (ui->res_diameter) {
 		struct elec_val diameter = get_diameter_val(ui);
 		elec_unit_autoscale(&diameter);
 
-		gp_widget_label_printf(ui->res_diameter, "%g %s",
-		                       diameter.val, elec_unit_name(&diameter));
+		label_val(ui->res_diameter, diameter.val, elec_unit_name(&diameter));
 	}
 
 	return 0;
@@ -156,13 +240,18 @@ static void recalc_length(struct resistance_ui *ui)
 	size_t unit_length = gp_widget_choice_sel_get(ui->unit_length);
 	struct elec_val area = get_area_val(ui);
 	struct elec_val resistance = get_resistance_val(ui);
+	struct elec_geometry geometry;
 	struct elec_val length;
 
 	length = elec_length_block(&elec_material[material], resistance, area);
 
+	/* The resistance is given by the strands, the cable is shorter */
+	get_geometry(ui, &geometry);
+	length.val /= elec_geometry_lay_factor(&geometry);
+
 	if (ui->length) {
 		elec_unit_convert(&length, unit_length);
-		gp_widget_label_printf(ui->length, "%g", length.val);
+		label_val(ui->length, length.val, NULL);
 	}
 }
 
@@ -170,20 +259,79 @@ static void recalc_diameter(struct resistance_ui *ui)
 {
 	size_t unit_diameter = gp_widget_choice_sel_get(ui->unit_diameter);
 	struct elec_val value = get_area_val(ui);
+	char buf[ELEC_FMT_MAX];
 
 	elec_circle_diameter(&value, unit_diameter);
 
-	gp_widget_tbox_printf(ui->diameter, "%g", value.val);
+	elec_fmt_shortest(value.val, buf);
+	gp_widget_tbox_set(ui->diameter, buf);
 }
 
 static void recalc_area(struct resistance_ui *ui)
 {
 	struct elec_val value = get_diameter_val(ui);
 	size_t unit_area = gp_widget_choice_sel_get(ui->unit_area);
+	char buf[ELEC_FMT_MAX];
 
 	elec_circle_area(&value, unit_area);
 
-	gp_widget_tbox_printf(ui->area, "%g", value.val);
+	elec_fmt_shortest(value.val, buf);
+	gp_widget_tbox_set(ui->area, buf);
+}
+
+static void recalc_geometry(struct resistance_ui *ui)
+{
+	struct elec_geometry geometry;
+	struct elec_val area = {.type = ELEC_UNIT_AREA, .unit = ELEC_UNIT_M2};
+	char buf[ELEC_FMT_MAX];
+
+	get_geometry(ui, &geometry);
+
+	if (geometry.type == ELEC_GEOMETRY_ROUND)
+		return;
+
+	area.val = elec_geometry_area(&geometry);
+	if (isnan(area.val))
+		return;
+
+	elec_unit_convert(&area, gp_widget_choice_sel_get(ui->unit_area));
+
+	elec_fmt_shortest(area.val, buf);
+	gp_widget_tbox_set(ui->area, buf);
+
+	/* Diameter of a round wire with the same cross section */
+	recalc_diameter(ui);
+}
+
+static void update_geometry_labels(struct resistance_ui *ui)
+{
+	static const char *const labels[ELEC_GEOMETRY_CNT][3] = {
+		[ELEC_GEOMETRY_ROUND] = {"-", "-", "-"},
+		[ELEC_GEOMETRY_RECT] = {"w", "h", "r"},
+		[ELEC_GEOMETRY_TUBE] = {"D", "t", "-"},
+		[ELEC_GEOMETRY_STRANDED] = {"n", "d", "lay"},
+	};
+	size_t type = gp_widget_choice_sel_get(ui->geometry);
+
+	if (type >= ELEC_GEOMETRY_CNT)
+		return;
+
+	gp_widget_label_set(ui->geom_a_label, labels[type][0]);
+	gp_widget_label_set(ui->geom_b_label, labels[type][1]);
+	gp_widget_label_set(ui->geom_c_label, labels[type][2]);
+}
+
+static int geometry_callback(gp_widget_event *ev)
+{
+	struct resistance_ui *ui = ev->self->priv;
+
+	if (ev->type != GP_WIDGET_EVENT_WIDGET)
+		return 0;
+
+	update_geometry_labels(ui);
+	recalc_geometry(ui);
+
+	return recalc_resistance(ev);
 }
 
 static int tbox_number_callback(gp_widget_event *ev)
@@ -206,12 +354,23 @@ static int tbox_number_callback(gp_widget_event *ev)
 		return 0;
 	break;
 	case GP_WIDGET_TBOX_EDIT:
+		/* Area or diameter typed in describes a round wire */
+		if ((ev->self == ui->diameter || ev->self == ui->area) &&
+		    gp_widget_choice_sel_get(ui->geometry) != ELEC_GEOMETRY_ROUND) {
+			gp_widget_choice_sel_set(ui->geometry, ELEC_GEOMETRY_ROUND);
+			update_geometry_labels(ui);
+		}
+
 		if (ev->self == ui->diameter)
 			recalc_area(ui);
 
 		if (ev->self == ui->area)
 			recalc_diameter(ui);
 
+		if (ev->self == ui->geom_a || ev->self == ui->geom_b ||
+		    ev->self == ui->geom_c)
+			recalc_geometry(ui);
+
 		if (ev->self != ui->resistance)
 			recalc_resistance(ev);
 		else
@@ -229,9 +388,9 @@ static void update_material_info(gp_widget *self, struct resistance_ui *ui)
 
 	gp_widget_label_set(ui->material_name, res->name);
 	gp_widget_label_set(ui->material_comp, res->composition);
-	gp_widget_label_printf(ui->material_r, "%g \u03a9\u00b7m", res->ro);
-	gp_widget_label_printf(ui->material_tc, "%g \u03a9 1/K", res->tc);
-	gp_widget_label_printf(ui->material_density, "%g kg/m\u00b3 ", res->density);
+	label_val(ui->material_r, res->ro, "\u03a9\u00b7m");
+	label_val(ui->material_tc, res->tc, "\u03a9 1/K");
+	label_val(ui->material_density, res->density, "kg/m\u00b3");
 }
 
 int material_callback(gp_widget_event *ev)
@@ -315,12 +474,36 @@ const gp_widget_choice_desc units_power_desc = {
 	}
 };
 
+const gp_widget_choice_desc units_capacitance_desc = {
+	.ops = &gp_widget_choice_arr_ops,
+	.arr = &(gp_widget_choice_arr) {
+		.ptr = elec_units_capacitance,
+		.memb_cnt = ELEC_UNIT_CAPACITANCE_CNT,
+		.memb_size = sizeof(struct elec_units),
+		.memb_off = offsetof(struct elec_units, name),
+	}
+};
+
+const gp_widget_choice_desc units_inductance_desc = {
+	.ops = &gp_widget_choice_arr_ops,
+	.arr = &(gp_widget_choice_arr) {
+		.ptr = elec_units_inductance,
+		.memb_cnt = ELEC_UNIT_INDUCTANCE_CNT,
+		.memb_size = sizeof(struct elec_units),
+		.memb_off = offsetof(struct elec_units, name),
+	}
+};
+
 int main(int argc, char *argv[])
 {
 	gp_htable *uids;
 	gp_widget *layout = gp_app_layout_load("elecalc", &uids);
 
 	ohm_law_init(uids);
+	divider_init(uids);
+	fuse_init(uids);
+	bode_init(uids);
+	wire_plot_init(uids);
 
 	resistance_ui.resistance = gp_widget_by_uid(uids, "resistance", GP_WIDGET_TBOX);
 	resistance_ui.length = gp_widget_by_uid(uids, "length", GP_WIDGET_TBOX);
@@ -332,6 +515,19 @@ int main(int argc, char *argv[])
 	gp_widget_on_event_set(resistance_ui.diameter, tbox_number_callback, &resistance_ui);
 	gp_widget_on_event_set(resistance_ui.area, tbox_number_callback, &resistance_ui);
 
+	resistance_ui.geometry = gp_widget_by_cuid(uids, "geometry", GP_WIDGET_CLASS_CHOICE);
+	resistance_ui.geom_a = gp_widget_by_uid(uids, "geom_a", GP_WIDGET_TBOX);
+	resistance_ui.geom_b = gp_widget_by_uid(uids, "geom_b", GP_WIDGET_TBOX);
+	resistance_ui.geom_c = gp_widget_by_uid(uids, "geom_c", GP_WIDGET_TBOX);
+	resistance_ui.geom_a_label = gp_widget_by_uid(uids, "geom_a_label", GP_WIDGET_LABEL);
+	resistance_ui.geom_b_label = gp_widget_by_uid(uids, "geom_b_label", GP_WIDGET_LABEL);
+	resistance_ui.geom_c_label = gp_widget_by_uid(uids, "geom_c_label", GP_WIDGET_LABEL);
+
+	gp_widget_on_event_set(resistance_ui.geometry, geometry_callback, &resistance_ui);
+	gp_widget_on_event_set(resistance_ui.geom_a, tbox_number_callback, &resistance_ui);
+	gp_widget_on_event_set(resistance_ui.geom_b, tbox_number_callback, &resistance_ui);
+	gp_widget_on_event_set(resistance_ui.geom_c, tbox_number_callback, &resistance_ui);
+
 	resistance_ui.unit_length = gp_widget_by_cuid(uids, "unit_length", GP_WIDGET_CLASS_CHOICE);
 	resistance_ui.unit_area = gp_widget_by_cuid(uids, "unit_area", GP_WIDGET_CLASS_CHOICE);
 	resistance_ui.unit_diameter = gp_widget_by_cuid(uids, "unit_diameter", GP_WIDGET_CLASS_CHOICE);
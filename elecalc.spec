@@ -31,6 +31,8 @@ DESTDIR="$RPM_BUILD_ROOT" make install
 %files -n elecalc
 %defattr(-,root,root)
 %{_bindir}/elecalc
+%{_bindir}/elecalc-batch
+%{_bindir}/elecalcd
 %{_sysconfdir}/gp_apps/
 %{_sysconfdir}/gp_apps/elecalc/
 %{_sysconfdir}/gp_apps/elecalc/*
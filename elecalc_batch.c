@@ -0,0 +1,300 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Command line tool for bulk calculations with libelec.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "libelec.h"
+#include "batch.h"
+
+static struct batch_cmd {
+	const char *name;
+	const char *desc;
+	int (*main)(int argc, char *argv[]);
+} cmds[] = {
+	{"table", "generates material x size x length tables", batch_table},
+	{"eseries", "snaps values to E-series and finds resistor pairs", batch_eseries},
+	{"acsweep", "AC resistance over a frequency sweep", batch_ac},
+	{"fusing", "fusing current and I\u00b2t withstand table", batch_fuse},
+	{"selfheat", "steady state temperature of loaded conductors", batch_selfheat},
+	{"livegen", "generates a live U/I sample stream", batch_livegen},
+	{"live", "prints statistics of a live U/I sample stream", batch_live},
+	{"stats", "streaming statistics of U/I sample logs", batch_stats},
+	{"energy", "I\u00b2R energy losses over a load profile", batch_energy},
+	{"colcat", "prints columnar result files as CSV", batch_colcat},
+	{"wires", "resistance and mass of a CSV wire list", batch_wires},
+	{"pareto", "Pareto optimal material and size for cable runs", batch_pareto},
+	{"ident", "material identification of wire samples", batch_ident},
+	{"project", "cable project runs and totals with watch mode", batch_project},
+	{"geometry", "busbar, tube and stranded conductor resistance and mass", batch_geometry},
+	{"winding", "coil winding wire size and turns search", batch_winding},
+	{"pcb", "PCB trace resistance and current capacity", batch_pcb},
+	{"approx", "compares approximate math mode against exact", batch_approx},
+	{"heatrun", "winding temperature from resistance rise", batch_heatrun},
+	{"kernels", "benchmarks batch kernel instruction set variants", batch_kernels},
+#ifdef ELEC_FIXED
+	{"fixedbench", "fixed point versus floating point benchmark", batch_fixed},
+#endif
+	{}
+};
+
+double batch_time(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+void batch_report(const char *what, size_t items, size_t bytes, double secs)
+{
+	if (secs <= 0)
+		secs = 1e-9;
+
+	fprintf(stderr, "%zu %s in %.3f s, %.3g %s/s",
+	        items, what, secs, items / secs, what);
+
+	if (bytes)
+		fprintf(stderr, ", %.1f MB/s", bytes / secs / 1e6);
+
+	fprintf(stderr, "\n");
+}
+
+char *batch_load(const char *path, size_t *len, int *mapped, int text)
+{
+	int fd = STDIN_FILENO;
+	size_t size = 0, alloc = 0;
+	struct stat st;
+	char *buf = NULL, *tmp;
+	ssize_t ret;
+	int err;
+
+	*mapped = 0;
+
+	if (path && strcmp(path, "-")) {
+		fd = open(path, O_RDONLY);
+		if (fd < 0)
+			return NULL;
+	}
+
+	if (!fstat(fd, &st) && S_ISREG(st.st_mode) && st.st_size > 0) {
+		buf = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+		if (buf != MAP_FAILED && (!text || buf[st.st_size - 1] == '\n')) {
+			madvise(buf, st.st_size, MADV_SEQUENTIAL);
+			*mapped = 1;
+			*len = st.st_size;
+			goto exit;
+		}
+
+		if (buf != MAP_FAILED)
+			munmap(buf, st.st_size);
+
+		buf = NULL;
+	}
+
+	for (;;) {
+		if (size + 1 >= alloc) {
+			alloc = alloc ? 2 * alloc : 1 << 20;
+			tmp = realloc(buf, alloc);
+			if (!tmp) {
+				err = ENOMEM;
+				goto err;
+			}
+			buf = tmp;
+		}
+
+		ret = read(fd, buf + size, alloc - size - 1);
+		if (ret < 0 && errno == EINTR)
+			continue;
+
+		if (ret < 0) {
+			err = errno;
+			goto err;
+		}
+
+		if (!ret)
+			break;
+
+		size += ret;
+	}
+
+	buf[size] = 0;
+	*len = size;
+exit:
+	if (fd != STDIN_FILENO)
+		close(fd);
+
+	return buf;
+err:
+	free(buf);
+	buf = NULL;
+
+	if (fd != STDIN_FILENO)
+		close(fd);
+
+	errno = err;
+	return NULL;
+}
+
+void batch_unload(char *buf, size_t len, int mapped)
+{
+	if (mapped)
+		munmap(buf, len);
+	else
+		free(buf);
+}
+
+size_t batch_line_start(const char *buf, size_t len, size_t pos)
+{
+	const char *nl;
+
+	if (!pos)
+		return 0;
+
+	nl = memchr(buf + pos - 1, '\n', len - pos + 1);
+
+	return nl ? (size_t)(nl - buf) + 1 : len;
+}
+
+struct batch_size *batch_sizes(const char *which, size_t *cnt)
+{
+	int metric = !strcmp(which, "all") || !strcmp(which, "metric");
+	int awg = !strcmp(which, "all") || !strcmp(which, "awg");
+	struct batch_size *sizes;
+	size_t i, n = 0;
+
+	if (!metric && !awg)
+		return NULL;
+
+	sizes = malloc((ELEC_STD_AREA_CNT + ELEC_AWG_MAX - ELEC_AWG_MIN + 1) * sizeof(*sizes));
+	if (!sizes)
+		return NULL;
+
+	for (i = 0; metric && i < ELEC_STD_AREA_CNT; i++) {
+		struct elec_val area = {
+			.type = ELEC_UNIT_AREA,
+			.val = elec_std_area_mm2[i],
+			.unit = ELEC_UNIT_MM2,
+		};
+
+		elec_unit_convert(&area, ELEC_UNIT_M2);
+
+		sizes[n].area = area.val;
+		sizes[n].mm2 = elec_std_area_mm2[i];
+		sizes[n++].awg = BATCH_METRIC;
+	}
+
+	for (i = 0; awg && i <= ELEC_AWG_MAX - ELEC_AWG_MIN; i++) {
+		struct elec_val area = {
+			.type = ELEC_UNIT_AREA,
+			.val = ELEC_AWG_MIN + (int)i,
+			.unit = ELEC_UNIT_AWG,
+		};
+
+		elec_unit_convert(&area, ELEC_UNIT_M2);
+
+		sizes[n].area = area.val;
+		sizes[n].mm2 = area.val * 1e6;
+		sizes[n++].awg = ELEC_AWG_MIN + (int)i;
+	}
+
+	*cnt = n;
+
+	return sizes;
+}
+
+const char *batch_size_csv(const struct batch_size *size, char *buf, size_t buf_len)
+{
+	if (size->awg == BATCH_METRIC)
+		snprintf(buf, buf_len, "%g,mm2", size->mm2);
+	else if (size->awg > 0)
+		snprintf(buf, buf_len, "%i,AWG", size->awg);
+	else
+		snprintf(buf, buf_len, "%i/0,AWG", 1 - size->awg);
+
+	return buf;
+}
+
+unsigned int batch_csv_split(char *line, char **fields, unsigned int max)
+{
+	unsigned int cnt = 0;
+	char *p = line;
+
+	while (cnt < max) {
+		if (*p == '"') {
+			fields[cnt++] = ++p;
+
+			while (*p && *p != '"')
+				p++;
+
+			if (*p)
+				*p++ = 0;
+		} else {
+			fields[cnt++] = p;
+		}
+
+		while (*p && *p != ',' && *p != '\n' && *p != '\r')
+			p++;
+
+		if (*p != ',') {
+			*p = 0;
+			break;
+		}
+
+		*p++ = 0;
+	}
+
+	return cnt;
+}
+
+static void usage(const char *name)
+{
+	struct batch_cmd *i;
+
+	printf("usage: %s command [options]\n\ncommands:\n", name);
+
+	for (i = cmds; i->name; i++)
+		printf("  %-12s %s\n", i->name, i->desc);
+
+	printf("\nUse '%s command -h' for command options\n", name);
+}
+
+int main(int argc, char *argv[])
+{
+	struct batch_cmd *i;
+
+	if (argc < 2) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	for (i = cmds; i->name; i++) {
+		if (!strcmp(i->name, argv[1]))
+			return i->main(argc - 1, argv + 1);
+	}
+
+	if (strcmp(argv[1], "-h") && strcmp(argv[1], "--help"))
+		fprintf(stderr, "Invalid command '%s'\n\n", argv[1]);
+
+	usage(argv[0]);
+
+	return 1;
+}
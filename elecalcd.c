@@ -0,0 +1,444 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Calculation daemon answering libelec requests on a UNIX socket.
+ *
+ * The daemon is a single threaded poll() loop. Everything that arrived from
+ * all clients in one iteration is parsed into a queue, executed as one
+ * batch and answered in order. Each client uses either JSON lines or binary
+ * records, decided by the first byte it sends.
+ */
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#include "elec_stats.h"
+#include "elecalcd_req.h"
+
+#define MAX_CLIENTS 256
+#define BUF_SIZE 65536
+#define LINE_MAX_LEN 4096
+
+enum proto {
+	PROTO_UNKNOWN,
+	PROTO_JSON,
+	PROTO_BIN,
+};
+
+struct client {
+	int fd;
+	enum proto proto;
+	size_t in_len;
+	char in[BUF_SIZE];
+	size_t out_len;
+	size_t out_size;
+	char *out;
+	/* a response could not be queued, the client is closed */
+	int failed;
+};
+
+static struct daemon {
+	int listen_fd;
+	const char *path;
+
+	size_t clients_cnt;
+	struct client *clients[MAX_CLIENTS];
+
+	size_t queue_cnt;
+	size_t queue_size;
+	struct elecd_req *queue;
+
+	/* latency from receiving a request to queueing its response in s */
+	struct elec_stats latency;
+	uint64_t batches;
+} d;
+
+static volatile sig_atomic_t stop;
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void sig_stop(int sig)
+{
+	(void)sig;
+	stop = 1;
+}
+
+static int listen_socket(const char *path)
+{
+	struct sockaddr_un addr = {.sun_family = AF_UNIX};
+	int fd;
+
+	if (strlen(path) >= sizeof(addr.sun_path)) {
+		fprintf(stderr, "Socket path too long\n");
+		return -1;
+	}
+
+	strcpy(addr.sun_path, path);
+	unlink(path);
+
+	fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (fd < 0)
+		goto err;
+
+	if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)))
+		goto err;
+
+	/* Local users only */
+	chmod(path, 0600);
+
+	if (listen(fd, 64))
+		goto err;
+
+	return fd;
+err:
+	fprintf(stderr, "Failed to listen on '%s': %s\n", path, strerror(errno));
+	if (fd >= 0)
+		close(fd);
+	return -1;
+}
+
+static void client_accept(void)
+{
+	struct client *c;
+	int fd;
+
+	while ((fd = accept4(d.listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+		if (d.clients_cnt >= MAX_CLIENTS || !(c = calloc(1, sizeof(*c)))) {
+			close(fd);
+			continue;
+		}
+
+		c->fd = fd;
+		d.clients[d.clients_cnt++] = c;
+	}
+}
+
+static void client_close(size_t idx)
+{
+	struct client *c = d.clients[idx];
+
+	close(c->fd);
+	free(c->out);
+	free(c);
+
+	d.clients[idx] = d.clients[--d.clients_cnt];
+}
+
+static struct elecd_req *queue_add(void)
+{
+	if (d.queue_cnt >= d.queue_size) {
+		size_t size = d.queue_size ? 2 * d.queue_size : 1024;
+		struct elecd_req *tmp = realloc(d.queue, size * sizeof(*tmp));
+
+		if (!tmp)
+			return NULL;
+
+		d.queue = tmp;
+		d.queue_size = size;
+	}
+
+	return &d.queue[d.queue_cnt++];
+}
+
+static int out_reserve(struct client *c, size_t len)
+{
+	if (c->out_len + len > c->out_size) {
+		size_t size = c->out_size ? c->out_size : BUF_SIZE;
+		char *tmp;
+
+		while (size < c->out_len + len)
+			size *= 2;
+
+		tmp = realloc(c->out, size);
+		if (!tmp)
+			return 1;
+
+		c->out = tmp;
+		c->out_size = size;
+	}
+
+	return 0;
+}
+
+/*
+ * Parses all complete requests in the client input buffer into the queue.
+ */
+static void client_parse(struct client *c, int client, double t)
+{
+	size_t pos = 0;
+
+	if (c->proto == PROTO_UNKNOWN && c->in_len)
+		c->proto = (uint8_t)c->in[0] == ELECD_BIN_MAGIC ? PROTO_BIN : PROTO_JSON;
+
+	for (;;) {
+		struct elecd_req *req;
+
+		if (c->proto == PROTO_BIN) {
+			struct elecd_bin_req bin;
+
+			if (c->in_len - pos < sizeof(bin))
+				break;
+
+			memcpy(&bin, c->in + pos, sizeof(bin));
+			pos += sizeof(bin);
+
+			if (!(req = queue_add()))
+				break;
+
+			elecd_parse_bin(&bin, req);
+		} else {
+			char *line = c->in + pos;
+			char *nl = memchr(line, '\n', c->in_len - pos);
+
+			if (!nl)
+				break;
+
+			*nl = 0;
+			pos += nl - line + 1;
+
+			if (!(req = queue_add()))
+				break;
+
+			elecd_parse_json(line, req);
+		}
+
+		req->client = client;
+		req->t_recv = t;
+	}
+
+	memmove(c->in, c->in + pos, c->in_len - pos);
+	c->in_len -= pos;
+}
+
+static int client_read(struct client *c, int client)
+{
+	ssize_t ret;
+
+	ret = read(c->fd, c->in + c->in_len, sizeof(c->in) - c->in_len);
+
+	if (ret < 0 && (errno == EAGAIN || errno == EINTR))
+		return 0;
+
+	if (ret <= 0)
+		return 1;
+
+	c->in_len += ret;
+
+	client_parse(c, client, now());
+
+	/* Line that does not fit the buffer */
+	if (c->in_len == sizeof(c->in))
+		return 1;
+
+	return 0;
+}
+
+static int client_flush(struct client *c)
+{
+	ssize_t ret;
+
+	while (c->out_len) {
+		ret = write(c->fd, c->out, c->out_len);
+
+		if (ret < 0 && errno == EINTR)
+			continue;
+
+		if (ret < 0 && errno == EAGAIN)
+			return 0;
+
+		if (ret <= 0)
+			return 1;
+
+		memmove(c->out, c->out + ret, c->out_len - ret);
+		c->out_len -= ret;
+	}
+
+	return 0;
+}
+
+static int stats_res(const struct elecd_req *req, char *buf, size_t len)
+{
+	const struct elec_stats *l = &d.latency;
+
+	return snprintf(buf, len,
+	                "{\"id\":%s,\"requests\":%llu,\"batches\":%llu,\"mean_batch\":%.3g,"
+	                "\"mean_us\":%.3g,\"p50_us\":%.3g,\"p95_us\":%.3g,\"p99_us\":%.3g,"
+	                "\"max_us\":%.3g}\n",
+	                req->id[0] ? req->id : "null",
+	                (unsigned long long)l->n, (unsigned long long)d.batches,
+	                d.batches ? (double)l->n / d.batches : 0,
+	                l->n ? 1e6 * l->mean : 0,
+	                l->n ? 1e6 * elec_stats_quantile(l, 0.5) : 0,
+	                l->n ? 1e6 * elec_stats_quantile(l, 0.95) : 0,
+	                l->n ? 1e6 * elec_stats_quantile(l, 0.99) : 0,
+	                l->n ? 1e6 * l->max : 0);
+}
+
+static void respond(void)
+{
+	size_t i;
+	double t;
+
+	elecd_execute(d.queue, d.queue_cnt);
+
+	/* Counts the batch the stats request is answered in */
+	if (d.queue_cnt)
+		d.batches++;
+
+	t = now();
+
+	for (i = 0; i < d.queue_cnt; i++) {
+		struct elecd_req *req = &d.queue[i];
+		struct client *c = d.clients[req->client];
+
+		if (c->failed)
+			continue;
+
+		if (req->binary) {
+			struct elecd_bin_res res;
+
+			if (out_reserve(c, sizeof(res))) {
+				c->failed = 1;
+				continue;
+			}
+
+			elecd_bin_res(req, &res);
+			memcpy(c->out + c->out_len, &res, sizeof(res));
+			c->out_len += sizeof(res);
+		} else {
+			if (out_reserve(c, LINE_MAX_LEN)) {
+				c->failed = 1;
+				continue;
+			}
+
+			if (req->op == ELECD_OP_STATS && !req->err)
+				c->out_len += stats_res(req, c->out + c->out_len, LINE_MAX_LEN);
+			else
+				c->out_len += elecd_json_res(req, c->out + c->out_len, LINE_MAX_LEN);
+		}
+
+		elec_stats_add(&d.latency, t - req->t_recv);
+	}
+
+	d.queue_cnt = 0;
+}
+
+static void loop(void)
+{
+	struct pollfd fds[MAX_CLIENTS + 1];
+	size_t i;
+
+	while (!stop) {
+		fds[0] = (struct pollfd) {.fd = d.listen_fd, .events = POLLIN};
+
+		for (i = 0; i < d.clients_cnt; i++) {
+			fds[i + 1] = (struct pollfd) {
+				.fd = d.clients[i]->fd,
+				.events = POLLIN | (d.clients[i]->out_len ? POLLOUT : 0),
+			};
+		}
+
+		if (poll(fds, d.clients_cnt + 1, -1) < 0) {
+			if (errno == EINTR)
+				continue;
+			break;
+		}
+
+		/* Read everything first so that the requests are batched */
+		for (i = 0; i < d.clients_cnt; i++) {
+			if (fds[i + 1].revents & (POLLIN | POLLHUP | POLLERR)) {
+				if (client_read(d.clients[i], i))
+					fds[i + 1].fd = -1;
+			}
+		}
+
+		respond();
+
+		/* Close from the end, client_close() moves the last client */
+		for (i = d.clients_cnt; i-- > 0;) {
+			if (fds[i + 1].fd < 0 || d.clients[i]->failed ||
+			    client_flush(d.clients[i]))
+				client_close(i);
+		}
+
+		if (fds[0].revents & POLLIN)
+			client_accept();
+	}
+}
+
+static void usage(const char *name)
+{
+	printf("usage: %s [-s socket]\n\n"
+	       "Answers libelec calculation requests on a UNIX socket.\n\n"
+	       "  -s socket  socket path (default $XDG_RUNTIME_DIR/elecalcd.sock)\n",
+	       name);
+}
+
+int main(int argc, char *argv[])
+{
+	const char *runtime = getenv("XDG_RUNTIME_DIR");
+	char path[256];
+	int opt;
+
+	snprintf(path, sizeof(path), "%s/elecalcd.sock", runtime ? runtime : "/tmp");
+	d.path = path;
+
+	while ((opt = getopt(argc, argv, "hs:")) != -1) {
+		switch (opt) {
+		case 's':
+			d.path = optarg;
+		break;
+		case 'h':
+			usage(argv[0]);
+			return 0;
+		default:
+			usage(argv[0]);
+			return 1;
+		}
+	}
+
+	elec_stats_init(&d.latency);
+
+	d.listen_fd = listen_socket(d.path);
+	if (d.listen_fd < 0)
+		return 1;
+
+	signal(SIGPIPE, SIG_IGN);
+	signal(SIGINT, sig_stop);
+	signal(SIGTERM, sig_stop);
+
+	loop();
+
+	while (d.clients_cnt)
+		client_close(d.clients_cnt - 1);
+
+	close(d.listen_fd);
+	unlink(d.path);
+	free(d.queue);
+
+	return 0;
+}
@@ -0,0 +1,524 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "elec_batch.h"
+#include "elec_fmt.h"
+#include "elecalcd_req.h"
+
+static const struct unit_type {
+	const char *name;
+	enum elec_unit type;
+	const struct elec_units *units;
+	size_t cnt;
+} unit_types[] = {
+	{"length", ELEC_UNIT_LENGTH, elec_units_length, ELEC_UNIT_LENGTH_CNT},
+	{"area", ELEC_UNIT_AREA, elec_units_area, ELEC_UNIT_AREA_CNT},
+	{"mass", ELEC_UNIT_MASS, elec_units_mass, ELEC_UNIT_MASS_CNT},
+	{"resistance", ELEC_UNIT_RESISTANCE, elec_units_resistance, ELEC_UNIT_RESISTANCE_CNT},
+	{"voltage", ELEC_UNIT_VOLTAGE, elec_units_voltage, ELEC_UNIT_VOLTAGE_CNT},
+	{"current", ELEC_UNIT_CURRENT, elec_units_current, ELEC_UNIT_CURRENT_CNT},
+	{"power", ELEC_UNIT_POWER, elec_units_power, ELEC_UNIT_POWER_CNT},
+	{"capacitance", ELEC_UNIT_CAPACITANCE, elec_units_capacitance, ELEC_UNIT_CAPACITANCE_CNT},
+	{"inductance", ELEC_UNIT_INDUCTANCE, elec_units_inductance, ELEC_UNIT_INDUCTANCE_CNT},
+	{}
+};
+
+static const char *const op_names[] = {
+	[ELECD_OP_RESISTANCE] = "resistance",
+	[ELECD_OP_MASS] = "mass",
+	[ELECD_OP_LENGTH] = "length",
+	[ELECD_OP_OHM] = "ohm",
+	[ELECD_OP_CONVERT] = "convert",
+	[ELECD_OP_STATS] = "stats",
+};
+
+#define JSON_MAX_KEYS 16
+
+struct json_kv {
+	const char *key;
+	const char *str;
+	double num;
+};
+
+struct json_obj {
+	unsigned int cnt;
+	struct json_kv kv[JSON_MAX_KEYS];
+};
+
+static char *skip_ws(char *s)
+{
+	while (isspace((unsigned char)*s))
+		s++;
+
+	return s;
+}
+
+/*
+ * Parses a string in place, escapes other than \" and \\ are not supported.
+ */
+static char *json_str(char *s, const char **str)
+{
+	char *out = s;
+
+	*str = s;
+
+	for (;;) {
+		switch (*s) {
+		case 0:
+			return NULL;
+		case '"':
+			*out = 0;
+			return s + 1;
+		case '\\':
+			if (s[1] != '"' && s[1] != '\\')
+				return NULL;
+			s++;
+		/* fallthrough */
+		default:
+			*out++ = *s++;
+		}
+	}
+}
+
+/*
+ * Writes a string id back as a quoted JSON string, long ids are truncated
+ * but never in the middle of an escape sequence or an UTF-8 character.
+ */
+static void json_id(char *buf, size_t size, const char *str)
+{
+	size_t len = 0, esc;
+	char tmp[8];
+
+	buf[len++] = '"';
+
+	for (; *str; str++) {
+		unsigned char c = *str;
+
+		if (c == '"' || c == '\\')
+			esc = snprintf(tmp, sizeof(tmp), "\\%c", c);
+		else if (c < 0x20)
+			esc = snprintf(tmp, sizeof(tmp), "\\u%04x", c);
+		else
+			esc = snprintf(tmp, sizeof(tmp), "%c", c);
+
+		/* Room for the closing quote and null byte */
+		if (len + esc + 2 > size)
+			break;
+
+		memcpy(buf + len, tmp, esc);
+		len += esc;
+	}
+
+	/* Drop a truncated UTF-8 sequence */
+	if (*str) {
+		size_t lead = len;
+
+		while (lead > 1 && ((unsigned char)buf[lead - 1] & 0xc0) == 0x80)
+			lead--;
+
+		if (lead > 1 && ((unsigned char)buf[lead - 1] & 0x80))
+			len = lead - 1;
+	}
+
+	buf[len++] = '"';
+	buf[len] = 0;
+}
+
+/*
+ * Parses a flat object with string and number values.
+ */
+static int json_parse(char *s, struct json_obj *obj)
+{
+	struct json_kv *kv;
+	char *end;
+
+	obj->cnt = 0;
+
+	s = skip_ws(s);
+	if (*s++ != '{')
+		return 1;
+
+	s = skip_ws(s);
+	if (*s == '}')
+		return 0;
+
+	for (;;) {
+		if (obj->cnt >= JSON_MAX_KEYS)
+			return 1;
+
+		kv = &obj->kv[obj->cnt++];
+		kv->str = NULL;
+
+		if (*s++ != '"' || !(s = json_str(s, &kv->key)))
+			return 1;
+
+		s = skip_ws(s);
+		if (*s++ != ':')
+			return 1;
+
+		s = skip_ws(s);
+		if (*s == '"') {
+			if (!(s = json_str(s + 1, &kv->str)))
+				return 1;
+		} else {
+			kv->num = strtod(s, &end);
+			if (end == s)
+				return 1;
+			s = end;
+		}
+
+		s = skip_ws(s);
+		if (*s == '}')
+			return 0;
+
+		if (*s++ != ',')
+			return 1;
+
+		s = skip_ws(s);
+	}
+}
+
+static const struct json_kv *json_get(const struct json_obj *obj, const char *key)
+{
+	unsigned int i;
+
+	for (i = 0; i < obj->cnt; i++) {
+		if (!strcmp(obj->kv[i].key, key))
+			return &obj->kv[i];
+	}
+
+	return NULL;
+}
+
+static int json_num(const struct json_obj *obj, const char *key, double *val)
+{
+	const struct json_kv *kv = json_get(obj, key);
+
+	if (!kv || kv->str)
+		return 1;
+
+	*val = kv->num;
+
+	return 0;
+}
+
+static const char *json_strval(const struct json_obj *obj, const char *key)
+{
+	const struct json_kv *kv = json_get(obj, key);
+
+	return kv ? kv->str : NULL;
+}
+
+static enum elecd_op op_by_name(const char *name)
+{
+	size_t i;
+
+	for (i = 0; name && i < sizeof(op_names) / sizeof(*op_names); i++) {
+		if (op_names[i] && !strcmp(op_names[i], name))
+			return i;
+	}
+
+	return ELECD_OP_INVALID;
+}
+
+static int unit_by_name(const struct unit_type *t, const char *name, elec_unit *unit)
+{
+	size_t i;
+
+	for (i = 0; name && i < t->cnt; i++) {
+		if (!strcmp(t->units[i].name, name)) {
+			*unit = i;
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+static void parse_ohm(const struct json_obj *obj, struct elecd_req *req)
+{
+	struct elec_ohm_law *ol = &req->ohm;
+	int set = 0;
+
+	ol->u = (struct elec_val){.unit = ELEC_UNIT_UNDEF};
+	ol->i = (struct elec_val){.unit = ELEC_UNIT_UNDEF};
+	ol->r = (struct elec_val){.unit = ELEC_UNIT_UNDEF};
+	ol->p = (struct elec_val){.unit = ELEC_UNIT_UNDEF};
+
+	if (!json_num(obj, "u", &ol->u.val)) {
+		ol->u.unit = ELEC_UNIT_V;
+		set++;
+	}
+
+	if (!json_num(obj, "i", &ol->i.val)) {
+		ol->i.unit = ELEC_UNIT_A;
+		set++;
+	}
+
+	if (!json_num(obj, "r", &ol->r.val)) {
+		ol->r.unit = ELEC_UNIT_OHM;
+		set++;
+	}
+
+	if (!json_num(obj, "p", &ol->p.val)) {
+		ol->p.unit = ELEC_UNIT_W;
+		set++;
+	}
+
+	if (set != 2)
+		req->err = "exactly two of u, i, r, p required";
+}
+
+static void parse_convert(const struct json_obj *obj, struct elecd_req *req)
+{
+	const char *type = json_strval(obj, "type");
+	const struct unit_type *t;
+	elec_unit from;
+
+	for (t = unit_types; t->name; t++) {
+		if (type && !strcmp(t->name, type))
+			break;
+	}
+
+	if (!t->name) {
+		req->err = "invalid unit type";
+		return;
+	}
+
+	if (unit_by_name(t, json_strval(obj, "from"), &from) ||
+	    unit_by_name(t, json_strval(obj, "to"), &req->conv_to)) {
+		req->err = "invalid unit";
+		return;
+	}
+
+	req->conv = (struct elec_val) {.type = t->type, .unit = from};
+
+	if (json_num(obj, "value", &req->conv.val))
+		req->err = "missing value";
+}
+
+void elecd_parse_json(char *line, struct elecd_req *req)
+{
+	struct json_obj obj;
+	const struct json_kv *id;
+	const char *material;
+
+	req->binary = 0;
+	req->err = NULL;
+	req->id[0] = 0;
+	req->op = ELECD_OP_INVALID;
+
+	if (json_parse(line, &obj)) {
+		req->err = "invalid JSON";
+		return;
+	}
+
+	id = json_get(&obj, "id");
+	if (id && id->str)
+		json_id(req->id, sizeof(req->id), id->str);
+	else if (id)
+		elec_fmt_shortest(id->num, req->id);
+
+	req->op = op_by_name(json_strval(&obj, "op"));
+
+	switch (req->op) {
+	case ELECD_OP_RESISTANCE:
+	case ELECD_OP_MASS:
+	case ELECD_OP_LENGTH:
+		material = json_strval(&obj, "material");
+		req->material = material ? elec_material_by_name(material) : NULL;
+		if (!req->material) {
+			req->err = "invalid material";
+			return;
+		}
+
+		if (json_num(&obj, req->op == ELECD_OP_LENGTH ? "resistance" : "length", &req->a) ||
+		    json_num(&obj, "area", &req->b))
+			req->err = "missing parameters";
+	break;
+	case ELECD_OP_OHM:
+		parse_ohm(&obj, req);
+	break;
+	case ELECD_OP_CONVERT:
+		parse_convert(&obj, req);
+	break;
+	case ELECD_OP_STATS:
+	break;
+	case ELECD_OP_INVALID:
+		req->err = "invalid op";
+	break;
+	}
+}
+
+void elecd_parse_bin(const struct elecd_bin_req *bin, struct elecd_req *req)
+{
+	req->binary = 1;
+	req->err = NULL;
+	req->bin_id = bin->id;
+	req->op = bin->op;
+	req->a = bin->a;
+	req->b = bin->b;
+
+	switch (req->op) {
+	case ELECD_OP_RESISTANCE:
+	case ELECD_OP_MASS:
+	case ELECD_OP_LENGTH:
+		if (bin->material >= elec_material_cnt) {
+			req->err = "invalid material";
+			return;
+		}
+		req->material = &elec_material[bin->material];
+	break;
+	case ELECD_OP_OHM:
+		req->ohm = (struct elec_ohm_law) {
+			.u = {.val = bin->a, .unit = ELEC_UNIT_V},
+			.i = {.val = bin->b, .unit = ELEC_UNIT_A},
+			.r = {.unit = ELEC_UNIT_UNDEF},
+			.p = {.unit = ELEC_UNIT_UNDEF},
+		};
+	break;
+	default:
+		req->op = ELECD_OP_INVALID;
+		req->err = "invalid op";
+	}
+}
+
+#define GROUP_MAX 1024
+
+/*
+ * Runs the array kernel over all requests with given op and material.
+ */
+static void execute_group(struct elecd_req *reqs, size_t cnt, enum elecd_op op,
+                          const struct elec_material *material)
+{
+	double a[GROUP_MAX], b[GROUP_MAX], res[GROUP_MAX];
+	size_t idx[GROUP_MAX];
+	size_t i, j, n = 0;
+
+	for (i = 0; i <= cnt; i++) {
+		if (i < cnt) {
+			struct elecd_req *req = &reqs[i];
+
+			if (req->op != op || req->material != material || req->err)
+				continue;
+
+			idx[n] = i;
+			a[n] = req->a;
+			b[n++] = req->b;
+
+			if (n < GROUP_MAX)
+				continue;
+		}
+
+		if (op == ELECD_OP_RESISTANCE)
+			elec_resistance_batch(material, a, b, res, n);
+		else
+			elec_mass_batch(material, a, b, res, n);
+
+		for (j = 0; j < n; j++)
+			reqs[idx[j]].res = res[j];
+
+		n = 0;
+	}
+}
+
+void elecd_execute(struct elecd_req *reqs, size_t cnt)
+{
+	unsigned char seen[2][ELEC_RESISTIVITY_CNT] = {};
+	size_t i;
+
+	for (i = 0; i < cnt; i++) {
+		struct elecd_req *req = &reqs[i];
+		size_t m;
+
+		if (req->err)
+			continue;
+
+		switch (req->op) {
+		case ELECD_OP_RESISTANCE:
+		case ELECD_OP_MASS:
+			m = req->material - elec_material;
+			/* The first request of a group computes the whole group */
+			if (!seen[req->op == ELECD_OP_MASS][m]) {
+				seen[req->op == ELECD_OP_MASS][m] = 1;
+				execute_group(reqs + i, cnt - i, req->op, req->material);
+			}
+		break;
+		case ELECD_OP_LENGTH:
+			req->res = req->a * req->b / req->material->ro;
+		break;
+		case ELECD_OP_OHM:
+			elec_ohm_law(&req->ohm);
+		break;
+		case ELECD_OP_CONVERT:
+			elec_unit_convert(&req->conv, req->conv_to);
+		break;
+		default:
+		break;
+		}
+	}
+}
+
+int elecd_json_res(const struct elecd_req *req, char *buf, size_t len)
+{
+	const char *id = req->id[0] ? req->id : "null";
+	char v[4][ELEC_FMT_MAX];
+
+	if (req->err)
+		return snprintf(buf, len, "{\"id\":%s,\"error\":\"%s\"}\n", id, req->err);
+
+	switch (req->op) {
+	case ELECD_OP_RESISTANCE:
+	case ELECD_OP_MASS:
+	case ELECD_OP_LENGTH:
+		elec_fmt_shortest(req->res, v[0]);
+		return snprintf(buf, len, "{\"id\":%s,\"%s\":%s}\n",
+		                id, op_names[req->op], v[0]);
+	case ELECD_OP_OHM:
+		elec_fmt_shortest(req->ohm.u.val, v[0]);
+		elec_fmt_shortest(req->ohm.i.val, v[1]);
+		elec_fmt_shortest(req->ohm.r.val, v[2]);
+		elec_fmt_shortest(req->ohm.p.val, v[3]);
+		return snprintf(buf, len, "{\"id\":%s,\"u\":%s,\"i\":%s,\"r\":%s,\"p\":%s}\n",
+		                id, v[0], v[1], v[2], v[3]);
+	case ELECD_OP_CONVERT:
+		elec_fmt_shortest(req->conv.val, v[0]);
+		return snprintf(buf, len, "{\"id\":%s,\"value\":%s,\"unit\":\"%s\"}\n",
+		                id, v[0], elec_unit_name(&req->conv));
+	default:
+		return snprintf(buf, len, "{\"id\":%s,\"error\":\"invalid op\"}\n", id);
+	}
+}
+
+void elecd_bin_res(const struct elecd_req *req, struct elecd_bin_res *res)
+{
+	*res = (struct elecd_bin_res) {
+		.magic = ELECD_BIN_MAGIC,
+		.status = !!req->err,
+		.id = req->bin_id,
+		.val = NAN,
+		.val2 = NAN,
+	};
+
+	if (req->err)
+		return;
+
+	if (req->op == ELECD_OP_OHM) {
+		res->val = req->ohm.r.val;
+		res->val2 = req->ohm.p.val;
+		return;
+	}
+
+	res->val = req->res;
+}
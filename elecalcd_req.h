@@ -0,0 +1,115 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * elecalcd requests, parsing, batched execution and responses.
+ *
+ * JSON requests are single line flat objects, all values are in base SI
+ * units:
+ *
+ * {"id": 1, "op": "resistance", "material": "copper", "length": 100, "area": 1.5e-6}
+ * {"id": 2, "op": "mass", "material": "copper", "length": 100, "area": 1.5e-6}
+ * {"id": 3, "op": "length", "material": "copper", "resistance": 1, "area": 1.5e-6}
+ * {"id": 4, "op": "ohm", "u": 230, "i": 2}
+ * {"id": 5, "op": "convert", "type": "length", "value": 1, "from": "inch", "to": "mm"}
+ * {"id": 6, "op": "stats"}
+ *
+ * the ohm request takes any two of u, i, r and p. Binary requests are
+ * fixed size records struct elecd_bin_req answered by struct elecd_bin_res.
+ */
+
+#ifndef ELECALCD_REQ_H
+#define ELECALCD_REQ_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "libelec.h"
+
+#define ELECD_BIN_MAGIC 0xec
+
+enum elecd_op {
+	ELECD_OP_INVALID,
+	ELECD_OP_RESISTANCE,
+	ELECD_OP_MASS,
+	ELECD_OP_LENGTH,
+	ELECD_OP_OHM,
+	ELECD_OP_CONVERT,
+	ELECD_OP_STATS,
+};
+
+/*
+ * Binary request, native endian. For resistance and mass a is length and b
+ * area, for length a is resistance and b area, for ohm a is U and b is I.
+ */
+struct elecd_bin_req {
+	uint8_t magic;
+	uint8_t op;
+	uint16_t material;
+	uint32_t id;
+	double a;
+	double b;
+};
+
+/*
+ * Binary response, status is zero on success, for ohm requests val is R and
+ * val2 is P.
+ */
+struct elecd_bin_res {
+	uint8_t magic;
+	uint8_t status;
+	uint16_t reserved;
+	uint32_t id;
+	double val;
+	double val2;
+};
+
+struct elecd_req {
+	int client;
+	int binary;
+	enum elecd_op op;
+	/* JSON id is echoed back as it was sent */
+	char id[32];
+	uint32_t bin_id;
+	double t_recv;
+
+	const struct elec_material *material;
+	double a;
+	double b;
+	struct elec_ohm_law ohm;
+	struct elec_val conv;
+	elec_unit conv_to;
+
+	const char *err;
+	double res;
+};
+
+/*
+ * Parses single JSON line into req, on failure req->err is set.
+ */
+void elecd_parse_json(char *line, struct elecd_req *req);
+
+/*
+ * Parses binary record into req, on failure req->err is set.
+ */
+void elecd_parse_bin(const struct elecd_bin_req *bin, struct elecd_req *req);
+
+/*
+ * Executes all queued requests, resistance and mass requests are grouped by
+ * material and computed with the array kernels. Stats requests are left
+ * for the caller.
+ */
+void elecd_execute(struct elecd_req *reqs, size_t cnt);
+
+/*
+ * Formats a JSON response line without the stats request, returns length.
+ */
+int elecd_json_res(const struct elecd_req *req, char *buf, size_t len);
+
+void elecd_bin_res(const struct elecd_req *req, struct elecd_bin_res *res);
+
+#endif /* ELECALCD_REQ_H */
@@ -0,0 +1,139 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#include <math.h>
+#include <string.h>
+#include <widgets/gp_widgets.h>
+#include "fuse.h"
+#include "elec_fuse.h"
+#include "elec_fmt.h"
+
+static struct fuse_ui {
+	gp_widget *time;
+	gp_widget *ambient;
+	gp_widget *tmax;
+
+	gp_widget *res_material;
+	gp_widget *res_area;
+	gp_widget *res_onderdonk;
+	gp_widget *res_preece;
+	gp_widget *res_i2t;
+
+	struct elec_material *material;
+	struct elec_val area;
+} fuse_ui;
+
+static void label_current(gp_widget *label, double current)
+{
+	char buf[64];
+
+	if (!label)
+		return;
+
+	if (isnan(current)) {
+		gp_widget_label_set(label, "---");
+		return;
+	}
+
+	elec_fmt_si(current, 4, "A", buf, sizeof(buf));
+	gp_widget_label_set(label, buf);
+}
+
+static void recalc_fuse(struct fuse_ui *ui)
+{
+	double time = atof(gp_widget_tbox_text(ui->time));
+	double ambient = atof(gp_widget_tbox_text(ui->ambient));
+	double tmax = ui->material->melting_point;
+	struct elec_val area = ui->area;
+	struct elec_val diameter = ui->area;
+	struct elec_val current;
+	char buf[ELEC_FMT_MAX];
+
+	if (!gp_widget_tbox_is_empty(ui->tmax))
+		tmax = atof(gp_widget_tbox_text(ui->tmax));
+
+	elec_circle_diameter(&diameter, ELEC_UNIT_M);
+
+	if (ui->res_material)
+		gp_widget_label_set(ui->res_material, ui->material->name);
+
+	if (ui->res_area) {
+		elec_unit_autoscale(&area);
+		elec_fmt_digits(area.val, 6, buf);
+		gp_widget_label_printf(ui->res_area, "%s %s", buf, elec_unit_name(&area));
+	}
+
+	elec_unit_convert(&area, ELEC_UNIT_M2);
+
+	if (time > 0) {
+		current = elec_fusing_current_block(ui->material, ui->area, ambient, time);
+		label_current(ui->res_onderdonk, current.val);
+	} else {
+		label_current(ui->res_onderdonk, NAN);
+	}
+
+	label_current(ui->res_preece, elec_fusing_current_preece(ui->material, diameter.val));
+
+	if (ui->res_i2t) {
+		elec_fmt_digits(elec_i2t(ui->material, area.val, ambient, tmax), 6, buf);
+		gp_widget_label_printf(ui->res_i2t, "%s A²s", buf);
+	}
+}
+
+void fuse_update(struct elec_material *material, struct elec_val area)
+{
+	fuse_ui.material = material;
+	fuse_ui.area = area;
+
+	recalc_fuse(&fuse_ui);
+}
+
+static int tbox_number_callback(gp_widget_event *ev)
+{
+	if (ev->type != GP_WIDGET_EVENT_WIDGET)
+		return 0;
+
+	struct fuse_ui *ui = ev->self->priv;
+	const char *text = gp_widget_tbox_text(ev->self);
+	char *end;
+
+	switch (ev->sub_type) {
+	case GP_WIDGET_TBOX_POST_FILTER:
+		if (!strcmp(text, "-"))
+			return 0;
+
+		strtod(text, &end);
+		if (*end)
+			return 1;
+		return 0;
+	break;
+	case GP_WIDGET_TBOX_EDIT:
+		if (ui->material)
+			recalc_fuse(ui);
+	break;
+	}
+
+	return 0;
+}
+
+void fuse_init(gp_htable *uids)
+{
+	fuse_ui.time = gp_widget_by_uid(uids, "fuse_time", GP_WIDGET_TBOX);
+	fuse_ui.ambient = gp_widget_by_uid(uids, "fuse_ambient", GP_WIDGET_TBOX);
+	fuse_ui.tmax = gp_widget_by_uid(uids, "fuse_tmax", GP_WIDGET_TBOX);
+
+	gp_widget_on_event_set(fuse_ui.time, tbox_number_callback, &fuse_ui);
+	gp_widget_on_event_set(fuse_ui.ambient, tbox_number_callback, &fuse_ui);
+	gp_widget_on_event_set(fuse_ui.tmax, tbox_number_callback, &fuse_ui);
+
+	fuse_ui.res_material = gp_widget_by_uid(uids, "fuse_material", GP_WIDGET_LABEL);
+	fuse_ui.res_area = gp_widget_by_uid(uids, "fuse_area", GP_WIDGET_LABEL);
+	fuse_ui.res_onderdonk = gp_widget_by_uid(uids, "fuse_onderdonk", GP_WIDGET_LABEL);
+	fuse_ui.res_preece = gp_widget_by_uid(uids, "fuse_preece", GP_WIDGET_LABEL);
+	fuse_ui.res_i2t = gp_widget_by_uid(uids, "fuse_i2t", GP_WIDGET_LABEL);
+}
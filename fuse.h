@@ -0,0 +1,22 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#ifndef FUSE_H
+#define FUSE_H
+
+#include <utils/gp_types.h>
+#include "libelec.h"
+
+void fuse_init(gp_htable *uids);
+
+/*
+ * Sets material and conductor cross section from the wire resistance tab.
+ */
+void fuse_update(struct elec_material *material, struct elec_val area);
+
+#endif /* FUSE_H */
@@ -9,38 +9,46 @@
 #include <math.h>
 #include <string.h>
 #include "libelec.h"
+#include "elec_approx.h"
 
 struct elec_material elec_material[ELEC_RESISTIVITY_CNT] = {
-	{"silver",          1.59e-8, 3.80e-3, 10490, "Ag"},
-	{"copper",          1.68e-8, 4.04e-3,  8960, "Cu"},
-	{"annealed copper", 1.72e-8, 3.93e-3,  8930, "Cu annealed"},
-	{"gold",            2.44e-8, 3.40e-3, 19300, "Au"},
-	{"aluminium",       2.65e-8, 3.90e-3,  2700, "Al"},
-	{"brass (5% Zn)",   3.00e-8,       0,  8860, "95% Cu 5% Zn"},
-	{"zinc",            5.90e-8, 3.70e-3,  7140, "Zn"},
-	{"brass (30% Zn)",  5.99e-8, 1.50e-3,  8550, "70% Cu 30% Zn"},
-	{"nickel",          6.99e-8, 6.00e-3,  8908, "Ni"},
-	{"iron",            9.70e-8, 5.00e-3,  7874, "Fe"},
-	{"platinum",        10.6e-8, 3.90e-3, 21450, "Pt"},
-	{"tin",             10.9e-8, 4.50e-3,  7265, "Sn"},
+	{"silver",          1.59e-8, 3.80e-3, 10490,  235,  961.8, "Ag"},
+	{"copper",          1.68e-8, 4.04e-3,  8960,  385, 1084.6, "Cu"},
+	{"annealed copper", 1.72e-8, 3.93e-3,  8930,  385, 1084.6, "Cu annealed"},
+	{"gold",            2.44e-8, 3.40e-3, 19300,  129,   1064, "Au"},
+	{"aluminium",       2.65e-8, 3.90e-3,  2700,  897,  660.3, "Al"},
+	{"brass (5% Zn)",   3.00e-8,       0,  8860,  380,   1050, "95% Cu 5% Zn"},
+	{"zinc",            5.90e-8, 3.70e-3,  7140,  388,  419.5, "Zn"},
+	{"brass (30% Zn)",  5.99e-8, 1.50e-3,  8550,  375,    915, "70% Cu 30% Zn"},
+	{"nickel",          6.99e-8, 6.00e-3,  8908,  444,   1455, "Ni"},
+	{"iron",            9.70e-8, 5.00e-3,  7874,  449,   1538, "Fe"},
+	{"platinum",        10.6e-8, 3.90e-3, 21450,  133,   1768, "Pt"},
+	{"tin",             10.9e-8, 4.50e-3,  7265,  228,  231.9, "Sn"},
 	//https://ntrs.nasa.gov/api/citations/20090032058/downloads/20090032058.pdf
-	{"phosphor bronze", 11.2e-8, 0.92e-3,  8860, "94.8% Cu 5% Sn 0.2% P"},
-	{"carbon steel",    14.3e-8,       0,  7870, "~0.1% C ~0.45%Mn ~99%Fe"},
-	{"lead",            22.0e-8, 3.90e-3, 11340, "Pb"},
-	{"titanium",        42.0e-8, 3.80e-3,  4506, "Ti"},
-	{"manganin",        43.0e-8, 0.002e-3, 8400, "86% Cu 12%Mn 2%Ni"},
-	{"constantan",      49.0e-8, 0.008e-3, 8885, "55% Cu 45% Ni"},
-
-	{"stainless steel 201/202",    70.0e-8, 0.94e-3, 7800, "71-68% Fe 18-17% Cr 9-7%Mn 5% Ni"},
-	{"stainless steel 301/303, A1", 73.0e-8, 0.94e-3, 7900, "74-73% Fe 18% Cr 9-8% Ni"},
-	{"stainless steel 304, A2",     73.0e-8, 0.94e-3, 7900, "73-70% Fe 19-18% Cr 11-9% Ni"},
-	{"stainless steel 316, A4",     75.0e-8, 0.94e-3, 8000, "70-65% Fe 18-17% Cr 14-11% Ni 3-2% Mo"},
-
-	{"mercury",           98.0e-8, 0.90e-3, 13534, "Hg"},
-	{"nichrome (20% Cr)", 110e-8, 0.40e-3,  8310, "80% Ni 20% Cr"},
+	{"phosphor bronze", 11.2e-8, 0.92e-3,  8860,  380,    950, "94.8% Cu 5% Sn 0.2% P"},
+	{"carbon steel",    14.3e-8,       0,  7870,  486,   1450, "~0.1% C ~0.45%Mn ~99%Fe"},
+	{"lead",            22.0e-8, 3.90e-3, 11340,  129,  327.5, "Pb"},
+	{"titanium",        42.0e-8, 3.80e-3,  4506,  523,   1668, "Ti"},
+	{"manganin",        43.0e-8, 0.002e-3, 8400,  410,    960, "86% Cu 12%Mn 2%Ni"},
+	{"constantan",      49.0e-8, 0.008e-3, 8885,  390,   1225, "55% Cu 45% Ni"},
+
+	{"stainless steel 201/202",    70.0e-8, 0.94e-3, 7800,  500,   1400, "71-68% Fe 18-17% Cr 9-7%Mn 5% Ni"},
+	{"stainless steel 301/303, A1", 73.0e-8, 0.94e-3, 7900,  500,   1400, "74-73% Fe 18% Cr 9-8% Ni"},
+	{"stainless steel 304, A2",     73.0e-8, 0.94e-3, 7900,  500,   1400, "73-70% Fe 19-18% Cr 11-9% Ni"},
+	{"stainless steel 316, A4",     75.0e-8, 0.94e-3, 8000,  500,   1375, "70-65% Fe 18-17% Cr 14-11% Ni 3-2% Mo"},
+
+	{"mercury",           98.0e-8, 0.90e-3, 13534,  140,  -38.8, "Hg"},
+	{"nichrome (20% Cr)", 110e-8, 0.40e-3,  8310,  450,   1400, "80% Ni 20% Cr"},
 	// Small impurities cause high change in resistance and TCR
-	{"bismuth",           129e-8,  NAN,  9780, "Bi"},
-	{"manganese",         144e-8,  0.01e-3,  7210, "Mn"},
+	{"bismuth",           129e-8,  NAN,  9780,  122,  271.4, "Bi"},
+	{"manganese",         144e-8,  0.01e-3,  7210,  479,   1246, "Mn"},
+};
+
+size_t elec_material_cnt = ELEC_RESISTIVITY_CNT;
+
+const double elec_std_area_mm2[ELEC_STD_AREA_CNT] = {
+	0.5, 0.75, 1, 1.5, 2.5, 4, 6, 10, 16, 25, 35, 50, 70, 95, 120, 150,
+	185, 240, 300, 400, 500, 630, 800, 1000,
 };
 
 const struct elec_units elec_units_area[ELEC_UNIT_AREA_CNT] = {
@@ -100,23 +108,50 @@ const struct elec_units elec_units_power[ELEC_UNIT_POWER_CNT] = {
 	{"hp", 746}
 };
 
+const struct elec_units elec_units_capacitance[ELEC_UNIT_CAPACITANCE_CNT] = {
+	{"F", 1},
+	{"mF", 0.001},
+	{"\u00b5F", 0.000001},
+	{"nF", 0.000000001},
+	{"pF", 0.000000000001}
+};
+
+const struct elec_units elec_units_inductance[ELEC_UNIT_INDUCTANCE_CNT] = {
+	{"H", 1},
+	{"mH", 0.001},
+	{"\u00b5H", 0.000001},
+	{"nH", 0.000000001}
+};
+
 struct elec_material *elec_material_by_name(const char *name)
 {
-	struct elec_material *i;
+	size_t i;
 
-	for (i = elec_material; i->name; i++) {
-		if (!strcmp(i->name, name))
-			return i;
+	for (i = 0; i < elec_material_cnt; i++) {
+		if (!strcmp(elec_material[i].name, name))
+			return &elec_material[i];
 	}
 
 	return NULL;
 }
 
+/*
+ * AWG constants for the approximate mode, AWG 36 is 0.000127 m in diameter
+ * and the area grows by 92^(2/39) per gauge, log2(92) = 6.523561956057013.
+ */
+#define AWG36_AREA (M_PI * 0.000127 * 0.000127 / 4)
+#define AWG_LOG2_STEP (2 * 6.523561956057013 / 39)
+
 static double area_convert_to_m2(double area, size_t units_area)
 {
 	/* AWG */
 	if (isnan(elec_units_area[units_area].mul)) {
-		double d = 0.000127 * pow(92, (36-area)/39);
+		double d;
+
+		if (elec_approx())
+			return AWG36_AREA * elec_approx_exp2((36 - area) * AWG_LOG2_STEP);
+
+		d = 0.000127 * pow(92, (36-area)/39);
 
 		return M_PI * d * d / 4;
 	}
@@ -130,7 +165,12 @@ static double elec_area_convert(double area, size_t from_units_area, size_t to_u
 
 	/* AWG */
 	if (isnan(elec_units_area[to_units_area].mul)) {
-		double d = sqrt(area * 4 / M_PI);
+		double d;
+
+		if (elec_approx())
+			return 36 - elec_approx_log2(area / AWG36_AREA) / AWG_LOG2_STEP;
+
+		d = sqrt(area * 4 / M_PI);
 
 		return -39 * log(d/0.000127) / log(92) + 36;
 	}
@@ -178,6 +218,12 @@ void elec_unit_convert(struct elec_val *value, elec_unit unit_to)
 	case ELEC_UNIT_POWER:
 		unit_convert(value, elec_units_power, unit_to);
 	break;
+	case ELEC_UNIT_CAPACITANCE:
+		unit_convert(value, elec_units_capacitance, unit_to);
+	break;
+	case ELEC_UNIT_INDUCTANCE:
+		unit_convert(value, elec_units_inductance, unit_to);
+	break;
 	}
 }
 
@@ -262,6 +308,43 @@ static void resistance_autoscale(struct elec_val *value)
 	elec_unit_convert(value, convert_to);
 }
 
+static void capacitance_autoscale(struct elec_val *value)
+{
+	elec_unit_convert(value, ELEC_UNIT_F);
+	elec_unit convert_to = ELEC_UNIT_F;
+
+	if (value->val < 1)
+		convert_to = ELEC_UNIT_mF;
+
+	if (value->val < 0.001)
+		convert_to = ELEC_UNIT_uF;
+
+	if (value->val < 0.000001)
+		convert_to = ELEC_UNIT_nF;
+
+	if (value->val < 0.000000001)
+		convert_to = ELEC_UNIT_pF;
+
+	elec_unit_convert(value, convert_to);
+}
+
+static void inductance_autoscale(struct elec_val *value)
+{
+	elec_unit_convert(value, ELEC_UNIT_H);
+	elec_unit convert_to = ELEC_UNIT_H;
+
+	if (value->val < 1)
+		convert_to = ELEC_UNIT_mH;
+
+	if (value->val < 0.001)
+		convert_to = ELEC_UNIT_uH;
+
+	if (value->val < 0.000001)
+		convert_to = ELEC_UNIT_nH;
+
+	elec_unit_convert(value, convert_to);
+}
+
 void elec_unit_autoscale(struct elec_val *value)
 {
 	switch (value->type) {
@@ -279,6 +362,12 @@ void elec_unit_autoscale(struct elec_val *value)
 	case ELEC_UNIT_RESISTANCE:
 		resistance_autoscale(value);
 	break;
+	case ELEC_UNIT_CAPACITANCE:
+		capacitance_autoscale(value);
+	break;
+	case ELEC_UNIT_INDUCTANCE:
+		inductance_autoscale(value);
+	break;
 	}
 }
 
@@ -293,6 +382,16 @@ const char *elec_unit_name(const struct elec_val *value)
 		return elec_units_mass[value->unit].name;
 	case ELEC_UNIT_RESISTANCE:
 		return elec_units_resistance[value->unit].name;
+	case ELEC_UNIT_VOLTAGE:
+		return elec_units_voltage[value->unit].name;
+	case ELEC_UNIT_CURRENT:
+		return elec_units_current[value->unit].name;
+	case ELEC_UNIT_POWER:
+		return elec_units_power[value->unit].name;
+	case ELEC_UNIT_CAPACITANCE:
+		return elec_units_capacitance[value->unit].name;
+	case ELEC_UNIT_INDUCTANCE:
+		return elec_units_inductance[value->unit].name;
 	default:
 		return "invalid unit";
 	}
@@ -325,6 +424,11 @@ struct elec_val elec_resistance_block(struct elec_material *material,
 	};
 }
 
+double elec_resistance_temp(const struct elec_material *material, double r_ref, double temp)
+{
+	return r_ref * (1 + material->tc * (temp - ELEC_TEMP_REF));
+}
+
 struct elec_val elec_length_block(struct elec_material *material,
                                   struct elec_val resistance,
                                   struct elec_val cross_section)
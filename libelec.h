@@ -9,6 +9,8 @@
 #ifndef LIBELEC_H
 #define LIBELEC_H
 
+#include <stddef.h>
+
 struct elec_material {
 	const char *name;
 
@@ -19,6 +21,12 @@ struct elec_material {
 	/* kg/m3 */
 	double density;
 
+	/* specific heat capacity J/(kg K) */
+	double heat_capacity;
+
+	/* melting point (solidus for alloys) in °C */
+	double melting_point;
+
 	/* chemical conposition */
 	const char *composition;
 };
@@ -110,6 +118,27 @@ enum elec_unit_power {
 
 extern const struct elec_units elec_units_power[ELEC_UNIT_POWER_CNT];
 
+enum elec_unit_capacitance {
+	ELEC_UNIT_F,
+	ELEC_UNIT_mF,
+	ELEC_UNIT_uF,
+	ELEC_UNIT_nF,
+	ELEC_UNIT_pF,
+	ELEC_UNIT_CAPACITANCE_CNT,
+};
+
+extern const struct elec_units elec_units_capacitance[ELEC_UNIT_CAPACITANCE_CNT];
+
+enum elec_unit_inductance {
+	ELEC_UNIT_H,
+	ELEC_UNIT_mH,
+	ELEC_UNIT_uH,
+	ELEC_UNIT_nH,
+	ELEC_UNIT_INDUCTANCE_CNT,
+};
+
+extern const struct elec_units elec_units_inductance[ELEC_UNIT_INDUCTANCE_CNT];
+
 enum elec_unit {
 	ELEC_UNIT_UNDEF,
 	ELEC_UNIT_LENGTH,
@@ -119,6 +148,8 @@ enum elec_unit {
 	ELEC_UNIT_VOLTAGE,
 	ELEC_UNIT_CURRENT,
 	ELEC_UNIT_POWER,
+	ELEC_UNIT_CAPACITANCE,
+	ELEC_UNIT_INDUCTANCE,
 };
 
 struct elec_val {
@@ -132,6 +163,19 @@ extern size_t elec_material_cnt;
 
 struct elec_material *elec_material_by_name(const char *name);
 
+/*
+ * Standard conductor cross sections in mm² as in IEC 60228.
+ */
+#define ELEC_STD_AREA_CNT 24
+
+extern const double elec_std_area_mm2[ELEC_STD_AREA_CNT];
+
+/*
+ * Range of AWG sizes, 0000 AWG is -3.
+ */
+#define ELEC_AWG_MIN -3
+#define ELEC_AWG_MAX 40
+
 /**
  * Coverts value into an SI unit and scales the value to the closest commonly
  * used SI prefix.
@@ -172,6 +216,23 @@ void elec_circle_area(struct elec_val *value, elec_unit unit_to);
 struct elec_val elec_resistance_block(struct elec_material *material,
                                       struct elec_val length, struct elec_val cross_section);
 
+/*
+ * Temperature the resistivities in the material table are given for in °C.
+ */
+#define ELEC_TEMP_REF 20
+
+/**
+ * Corrects resistance for a temperature using material temperature
+ * coefficient.
+ *
+ * @material A material description.
+ * @r_ref A resistance at ELEC_TEMP_REF.
+ * @temp A temperature in °C.
+ *
+ * @return A resistance at temp.
+ */
+double elec_resistance_temp(const struct elec_material *material, double r_ref, double temp);
+
 /**
  * Calculates length of a material based on resistance, material and cross section.
  *
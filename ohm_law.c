@@ -6,10 +6,16 @@
 
  */
 
+#include <errno.h>
 #include <string.h>
 #include <widgets/gp_widgets.h>
 #include "ohm_law.h"
 #include "libelec.h"
+#include "elec_fmt.h"
+#include "elec_live.h"
+
+/* Live mode display refresh period in ms */
+#define LIVE_PERIOD 50
 
 static struct ohm_law_ui {
 	gp_widget *r;
@@ -20,6 +26,11 @@ static struct ohm_law_ui {
 	gp_widget *u_unit;
 	gp_widget *i_unit;
 	gp_widget *p_unit;
+
+	gp_widget *live;
+	gp_widget *live_src;
+	gp_widget *live_stats;
+	struct elec_live *stream;
 } ohm_law_ui;
 
 static struct elec_val get_r_val(struct ohm_law_ui *ui)
@@ -61,33 +72,41 @@ static struct elec_val get_p_val(struct ohm_law_ui *ui)
 static void update_r(struct elec_ohm_law ol, struct ohm_law_ui *ui)
 {
 	size_t r_unit = gp_widget_choice_sel_get(ui->r_unit);
+	char buf[ELEC_FMT_MAX];
 
 	elec_unit_convert(&ol.r, r_unit);
-	gp_widget_tbox_printf(ui->r, "%g", ol.r.val);
+	elec_fmt_shortest(ol.r.val, buf);
+	gp_widget_tbox_set(ui->r, buf);
 }
 
 static void update_u(struct elec_ohm_law ol, struct ohm_law_ui *ui)
 {
 	size_t u_unit = gp_widget_choice_sel_get(ui->u_unit);
+	char buf[ELEC_FMT_MAX];
 
 	elec_unit_convert(&ol.u, u_unit);
-	gp_widget_tbox_printf(ui->u, "%g", ol.u.val);
+	elec_fmt_shortest(ol.u.val, buf);
+	gp_widget_tbox_set(ui->u, buf);
 }
 
 static void update_i(struct elec_ohm_law ol, struct ohm_law_ui *ui)
 {
 	size_t i_unit = gp_widget_choice_sel_get(ui->i_unit);
+	char buf[ELEC_FMT_MAX];
 
 	elec_unit_convert(&ol.i, i_unit);
-	gp_widget_tbox_printf(ui->i, "%g", ol.i.val);
+	elec_fmt_shortest(ol.i.val, buf);
+	gp_widget_tbox_set(ui->i, buf);
 }
 
 static void update_p(struct elec_ohm_law ol, struct ohm_law_ui *ui)
 {
 	size_t p_unit = gp_widget_choice_sel_get(ui->p_unit);
+	char buf[ELEC_FMT_MAX];
 
 	elec_unit_convert(&ol.p, p_unit);
-	gp_widget_tbox_printf(ui->p, "%g", ol.p.val);
+	elec_fmt_shortest(ol.p.val, buf);
+	gp_widget_tbox_set(ui->p, buf);
 }
 
 static void recalc_r_p(struct ohm_law_ui *ui)
@@ -274,6 +293,114 @@ static int scale_by_unit(gp_widget_event *ev)
 	return 0;
 }
 
+static void live_stop(struct ohm_law_ui *ui)
+{
+	elec_live_close(ui->stream);
+	ui->stream = NULL;
+
+	gp_widget_bool_set(ui->live, 0);
+}
+
+/*
+ * Shows frame mean U and I and the mean of the per sample R and P, the
+ * product of the means is not the power for varying waveforms. The per sample
+ * power statistics are shown in the status line.
+ */
+static uint32_t live_timer_callback(gp_timer *self)
+{
+	struct ohm_law_ui *ui = self->priv;
+	struct elec_live_frame frame;
+	struct elec_ohm_law ol;
+
+	elec_live_frame(ui->stream, &frame);
+
+	if (frame.cnt) {
+		ol.u = (struct elec_val) {
+			.val = frame.u.mean,
+			.unit = ELEC_UNIT_V,
+			.type = ELEC_UNIT_VOLTAGE,
+		};
+		ol.i = (struct elec_val) {
+			.val = frame.i.mean,
+			.unit = ELEC_UNIT_A,
+			.type = ELEC_UNIT_CURRENT,
+		};
+		ol.r = (struct elec_val) {
+			.val = frame.r.mean,
+			.unit = ELEC_UNIT_OHM,
+			.type = ELEC_UNIT_RESISTANCE,
+		};
+		ol.p = (struct elec_val) {
+			.val = frame.p.mean,
+			.unit = ELEC_UNIT_W,
+			.type = ELEC_UNIT_POWER,
+		};
+
+		update_u(ol, ui);
+		update_i(ol, ui);
+		update_r(ol, ui);
+		update_p(ol, ui);
+
+		gp_widget_label_printf(ui->live_stats,
+		                       "%.0f samples/s  P %.4g / %.4g / %.4g W  dropped %zu",
+		                       frame.cnt * 1000.0 / LIVE_PERIOD,
+		                       frame.p.min, frame.p.mean, frame.p.max,
+		                       frame.dropped);
+	}
+
+	if (frame.eof && !frame.cnt) {
+		gp_widget_label_set(ui->live_stats, "End of stream");
+		live_stop(ui);
+		return GP_TIMER_STOP;
+	}
+
+	return self->period;
+}
+
+static gp_timer live_timer = {
+	.expires = LIVE_PERIOD,
+	.period = LIVE_PERIOD,
+	.callback = live_timer_callback,
+	.id = "Ohm law live",
+	.priv = &ohm_law_ui,
+};
+
+static int live_callback(gp_widget_event *ev)
+{
+	struct ohm_law_ui *ui = ev->self->priv;
+	const char *src;
+
+	if (ev->type != GP_WIDGET_EVENT_WIDGET)
+		return 0;
+
+	if (!gp_widget_bool_get(ev->self)) {
+		if (ui->stream) {
+			gp_widgets_timer_rem(&live_timer);
+			live_stop(ui);
+		}
+		return 0;
+	}
+
+	if (ui->stream)
+		return 0;
+
+	src = gp_widget_tbox_text(ui->live_src);
+	if (!src[0])
+		src = "-";
+
+	ui->stream = elec_live_open(src, 0);
+	if (!ui->stream) {
+		gp_widget_label_printf(ui->live_stats, "Failed to open '%s': %s", src, strerror(errno));
+		gp_widget_bool_set(ev->self, 0);
+		return 0;
+	}
+
+	gp_widget_label_printf(ui->live_stats, "Reading '%s'", src);
+	gp_widgets_timer_ins(&live_timer);
+
+	return 0;
+}
+
 void ohm_law_init(gp_htable *uids)
 {
 	ohm_law_ui.r = gp_widget_by_uid(uids, "ohm_r", GP_WIDGET_TBOX);
@@ -295,4 +422,10 @@ void ohm_law_init(gp_htable *uids)
 	gp_widget_on_event_set(ohm_law_ui.u_unit, scale_by_unit, &ohm_law_ui);
 	gp_widget_on_event_set(ohm_law_ui.i_unit, scale_by_unit, &ohm_law_ui);
 	gp_widget_on_event_set(ohm_law_ui.p_unit, scale_by_unit, &ohm_law_ui);
+
+	ohm_law_ui.live_src = gp_widget_by_uid(uids, "ohm_live_src", GP_WIDGET_TBOX);
+	ohm_law_ui.live_stats = gp_widget_by_uid(uids, "ohm_live_stats", GP_WIDGET_LABEL);
+	ohm_law_ui.live = gp_widget_by_cuid(uids, "ohm_live", GP_WIDGET_CLASS_BOOL);
+
+	gp_widget_on_event_set(ohm_law_ui.live, live_callback, &ohm_law_ui);
 }
@@ -0,0 +1,412 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+/*
+ * Resistance and mass plotted against length or temperature.
+ *
+ * The plot is drawn into a backing pixmap one column at a time. Each update
+ * computes curve pixels for all columns and only columns that differ from
+ * what is already drawn are redrawn and flushed to the screen. The axes are
+ * rounded up to 1-2-5 steps and kept while the values fit, so that typical
+ * edits change only part of the plot.
+ */
+
+#include <math.h>
+#include <string.h>
+#include <widgets/gp_widgets.h>
+#include "wire_plot.h"
+#include "elec_batch.h"
+#include "elec_fmt.h"
+
+#define TEMP_MIN -50
+#define TEMP_MAX 250
+
+#define GRID_DIVS 10
+
+enum plot_axis {
+	AXIS_LENGTH,
+	AXIS_TEMP,
+};
+
+struct column {
+	/* pixel rows of the curves, -1 if not drawn */
+	gp_coord r;
+	gp_coord m;
+	int marker;
+};
+
+static struct wire_plot {
+	gp_widget *plot;
+	gp_widget *axis;
+	gp_widget *scale;
+
+	struct elec_material *material;
+	struct elec_val length;
+	struct elec_val area;
+	/* strands are longer than the cable by the lay factor */
+	double lay_factor;
+
+	gp_pixel bg;
+	gp_pixel grid;
+	gp_pixel fg;
+	gp_pixel r_color;
+	gp_pixel m_color;
+
+	/* scales of the plot in the backing pixmap */
+	enum plot_axis drawn_axis;
+	double x_max;
+	double r_max;
+	double m_max;
+
+	size_t cols;
+	double *x;
+	double *area_m2;
+	double *r;
+	double *m;
+	struct column *drawn;
+	struct column *next;
+} wire_plot;
+
+static double nice_ceil(double val)
+{
+	double exp = pow(10, floor(log10(val)));
+	double mant = val / exp;
+
+	if (mant <= 1)
+		return exp;
+
+	if (mant <= 2)
+		return 2 * exp;
+
+	if (mant <= 5)
+		return 5 * exp;
+
+	return 10 * exp;
+}
+
+/*
+ * Keeps the old scale unless the value does not fit or would use less than
+ * a quarter of the plot.
+ */
+static double scale_update(double old, double val)
+{
+	if (!(val > 0) || !isfinite(val))
+		return old;
+
+	if (old > 0 && val <= old && val > old / 4)
+		return old;
+
+	return nice_ceil(val);
+}
+
+static gp_coord val_to_y(double val, double max, gp_size h)
+{
+	if (!isfinite(val) || !(max > 0))
+		return -1;
+
+	if (val < 0)
+		val = 0;
+
+	if (val > max)
+		val = max;
+
+	return (h - 1) - (gp_coord)(val / max * (h - 1) + 0.5);
+}
+
+static int cols_alloc(struct wire_plot *p, size_t cols)
+{
+	double *x;
+	struct column *c;
+
+	if (p->cols == cols)
+		return 0;
+
+	x = realloc(p->x, 4 * cols * sizeof(double));
+	if (!x)
+		goto err;
+
+	p->x = x;
+	p->area_m2 = x + cols;
+	p->r = x + 2 * cols;
+	p->m = x + 3 * cols;
+
+	c = realloc(p->drawn, 2 * cols * sizeof(*c));
+	if (!c)
+		goto err;
+
+	p->drawn = c;
+	p->next = c + cols;
+	p->cols = cols;
+
+	return 0;
+err:
+	p->cols = 0;
+	return 1;
+}
+
+/*
+ * Evaluates the curves for all columns into p->next.
+ */
+static void compute(struct wire_plot *p, gp_size h)
+{
+	enum plot_axis axis = gp_widget_choice_sel_get(p->axis);
+	struct elec_val length = p->length, area = p->area;
+	double r_ref, r_top, m_top, x_pos;
+	size_t i, cols = p->cols;
+
+	elec_unit_convert(&length, ELEC_UNIT_M);
+	elec_unit_convert(&area, ELEC_UNIT_M2);
+
+	r_ref = p->material->ro * length.val * p->lay_factor / area.val;
+
+	if (axis != p->drawn_axis) {
+		p->x_max = 0;
+		p->r_max = 0;
+		p->m_max = 0;
+	}
+
+	if (axis == AXIS_LENGTH) {
+		p->x_max = scale_update(p->x_max, 1.2 * length.val);
+		x_pos = length.val;
+
+		for (i = 0; i < cols; i++) {
+			p->x[i] = p->x_max * i / (cols - 1);
+			p->area_m2[i] = area.val;
+		}
+
+		elec_resistance_batch(p->material, p->x, p->area_m2, p->r, cols);
+		elec_mass_batch(p->material, p->x, p->area_m2, p->m, cols);
+
+		for (i = 0; i < cols; i++) {
+			p->r[i] *= p->lay_factor;
+			p->m[i] *= p->lay_factor;
+		}
+
+		r_top = p->r[cols - 1];
+		m_top = p->m[cols - 1];
+	} else {
+		p->x_max = TEMP_MAX - TEMP_MIN;
+		x_pos = ELEC_TEMP_REF - TEMP_MIN;
+
+		for (i = 0; i < cols; i++)
+			p->x[i] = TEMP_MIN + (double)(TEMP_MAX - TEMP_MIN) * i / (cols - 1);
+
+		elec_resistance_temp_batch(p->material, r_ref, p->x, p->r, cols);
+
+		r_top = p->r[0] > p->r[cols - 1] ? p->r[0] : p->r[cols - 1];
+		m_top = 0;
+	}
+
+	p->r_max = scale_update(p->r_max, r_top);
+	p->m_max = scale_update(p->m_max, m_top);
+
+	for (i = 0; i < cols; i++) {
+		p->next[i].r = val_to_y(p->r[i], p->r_max, h);
+		p->next[i].m = axis == AXIS_LENGTH ? val_to_y(p->m[i], p->m_max, h) : -1;
+		p->next[i].marker = 0;
+	}
+
+	if (p->x_max > 0 && x_pos >= 0 && x_pos <= p->x_max)
+		p->next[(size_t)(x_pos / p->x_max * (cols - 1) + 0.5)].marker = 1;
+}
+
+static void curve_span(gp_pixmap *pixmap, gp_coord x, gp_coord y0, gp_coord y1, gp_pixel color)
+{
+	if (y1 < 0)
+		return;
+
+	if (y0 < 0)
+		y0 = y1;
+
+	gp_vline_xyy(pixmap, x, y0, y1, color);
+}
+
+static void draw_column(struct wire_plot *p, gp_pixmap *pixmap, size_t x)
+{
+	const struct column *c = &p->next[x];
+	const struct column *prev = x ? &p->next[x - 1] : c;
+	gp_size h = pixmap->h;
+	unsigned int i;
+
+	if ((x * GRID_DIVS) % (p->cols - 1) < GRID_DIVS) {
+		gp_vline_xyy(pixmap, x, 0, h - 1, p->grid);
+	} else {
+		gp_vline_xyy(pixmap, x, 0, h - 1, p->bg);
+
+		for (i = 0; i <= GRID_DIVS; i++)
+			gp_putpixel(pixmap, x, (h - 1) * i / GRID_DIVS, p->grid);
+	}
+
+	if (c->marker)
+		gp_vline_xyy(pixmap, x, 0, h - 1, p->fg);
+
+	curve_span(pixmap, x, prev->m, c->m, p->m_color);
+	curve_span(pixmap, x, prev->r, c->r, p->r_color);
+}
+
+static int column_eq(const struct column *a, const struct column *b)
+{
+	return a->r == b->r && a->m == b->m && a->marker == b->marker;
+}
+
+static void update_scale_label(struct wire_plot *p)
+{
+	struct elec_val r_max = {
+		.val = p->r_max,
+		.unit = ELEC_UNIT_OHM,
+		.type = ELEC_UNIT_RESISTANCE,
+	};
+	struct elec_val m_max = {
+		.val = p->m_max,
+		.unit = ELEC_UNIT_kG,
+		.type = ELEC_UNIT_MASS,
+	};
+	struct elec_val x_max = {
+		.val = p->x_max,
+		.unit = ELEC_UNIT_M,
+		.type = ELEC_UNIT_LENGTH,
+	};
+	char r_buf[ELEC_FMT_MAX], m_buf[ELEC_FMT_MAX], x_buf[ELEC_FMT_MAX];
+
+	if (!p->scale)
+		return;
+
+	elec_unit_autoscale(&r_max);
+
+	if (p->drawn_axis == AXIS_TEMP) {
+		elec_fmt_digits(r_max.val, 6, r_buf);
+		gp_widget_label_printf(p->scale, "R 0 - %s %s  T %i - %i °C",
+		                       r_buf, elec_unit_name(&r_max),
+		                       TEMP_MIN, TEMP_MAX);
+		return;
+	}
+
+	elec_unit_autoscale(&m_max);
+	elec_unit_autoscale(&x_max);
+
+	elec_fmt_digits(r_max.val, 6, r_buf);
+	elec_fmt_digits(m_max.val, 6, m_buf);
+	elec_fmt_digits(x_max.val, 6, x_buf);
+
+	gp_widget_label_printf(p->scale, "R 0 - %s %s  m 0 - %s %s  l 0 - %s %s",
+	                       r_buf, elec_unit_name(&r_max),
+	                       m_buf, elec_unit_name(&m_max),
+	                       x_buf, elec_unit_name(&x_max));
+}
+
+/*
+ * Recomputes the curves and redraws changed columns, full redraw is done if
+ * any of the scales has changed.
+ */
+static void replot(struct wire_plot *p, int full)
+{
+	gp_pixmap *pixmap;
+	double x_max = p->x_max, r_max = p->r_max, m_max = p->m_max;
+	gp_coord from = -1, to = -1;
+	size_t x;
+
+	if (!p->plot || !p->axis || !p->material || !p->plot->pixmap->pixmap || p->cols < 2)
+		return;
+
+	pixmap = p->plot->pixmap->pixmap;
+
+	compute(p, pixmap->h);
+
+	if (p->drawn_axis != (enum plot_axis)gp_widget_choice_sel_get(p->axis) ||
+	    x_max != p->x_max || r_max != p->r_max || m_max != p->m_max)
+		full = 1;
+
+	p->drawn_axis = gp_widget_choice_sel_get(p->axis);
+
+	for (x = 0; x < p->cols; x++) {
+		int prev_changed = x && !column_eq(&p->drawn[x - 1], &p->next[x - 1]);
+
+		if (!full && column_eq(&p->drawn[x], &p->next[x]) && !prev_changed)
+			continue;
+
+		draw_column(p, pixmap, x);
+
+		if (from < 0)
+			from = x;
+		to = x;
+	}
+
+	memcpy(p->drawn, p->next, p->cols * sizeof(*p->drawn));
+
+	if (full)
+		update_scale_label(p);
+
+	if (from >= 0)
+		gp_widget_pixmap_redraw(p->plot, from, 0, to - from + 1, pixmap->h);
+}
+
+void wire_plot_update(struct elec_material *material,
+                      struct elec_val length, struct elec_val area,
+                      double lay_factor)
+{
+	wire_plot.material = material;
+	wire_plot.length = length;
+	wire_plot.area = area;
+	wire_plot.lay_factor = lay_factor;
+
+	replot(&wire_plot, 0);
+}
+
+static void resize(struct wire_plot *p, gp_widget_event *ev)
+{
+	gp_widget *self = ev->self;
+
+	gp_pixmap_free(self->pixmap->pixmap);
+	self->pixmap->pixmap = gp_pixmap_alloc(self->w, self->h, ev->ctx->pixel_type);
+
+	if (!self->pixmap->pixmap || cols_alloc(p, self->w))
+		return;
+
+	p->bg = ev->ctx->bg_color;
+	p->fg = ev->ctx->text_color;
+	p->grid = ev->ctx->col_disabled;
+	p->r_color = ev->ctx->hl_color;
+	p->m_color = ev->ctx->warn_color;
+
+	gp_fill(self->pixmap->pixmap, p->bg);
+
+	replot(p, 1);
+}
+
+static int plot_on_event(gp_widget_event *ev)
+{
+	switch (ev->type) {
+	case GP_WIDGET_EVENT_RESIZE:
+		resize(ev->self->priv, ev);
+		return 1;
+	}
+
+	return 0;
+}
+
+static int axis_callback(gp_widget_event *ev)
+{
+	if (ev->type != GP_WIDGET_EVENT_WIDGET)
+		return 0;
+
+	replot(ev->self->priv, 1);
+
+	return 0;
+}
+
+void wire_plot_init(gp_htable *uids)
+{
+	wire_plot.axis = gp_widget_by_cuid(uids, "wire_plot_axis", GP_WIDGET_CLASS_CHOICE);
+	wire_plot.scale = gp_widget_by_uid(uids, "wire_plot_scale", GP_WIDGET_LABEL);
+	wire_plot.plot = gp_widget_by_uid(uids, "wire_plot", GP_WIDGET_PIXMAP);
+
+	gp_widget_on_event_set(wire_plot.axis, axis_callback, &wire_plot);
+
+	gp_widget_on_event_set(wire_plot.plot, plot_on_event, &wire_plot);
+	gp_widget_events_unmask(wire_plot.plot, GP_WIDGET_EVENT_RESIZE);
+}
@@ -0,0 +1,26 @@
+//SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+
+    Copyright (C) 2026 Cyril Hrubis <metan@ucw.cz>
+
+ */
+
+#ifndef WIRE_PLOT_H
+#define WIRE_PLOT_H
+
+#include <utils/gp_types.h>
+#include "libelec.h"
+
+void wire_plot_init(gp_htable *uids);
+
+/*
+ * Replots resistance and mass for the values from the wire resistance tab,
+ * the length is the cable length and the strands are longer by the lay
+ * factor.
+ */
+void wire_plot_update(struct elec_material *material,
+                      struct elec_val length, struct elec_val area,
+                      double lay_factor);
+
+#endif /* WIRE_PLOT_H */